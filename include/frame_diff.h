@@ -0,0 +1,36 @@
+#pragma once
+
+#include <stdint.h>
+
+#include "hal.h"
+
+// Ekran tamponu farki
+// SSD1306 sayfa duzenindeki (sayfa = 8 satir, her bayt bir sutun) tamponun en son gonderilen
+// kopyasi tutulur; frameDiffFlush() her sayfada yalnizca degisen sutun araliklarini sink'e
+// yazar. Aradaki esit bosluk FRAME_DIFF_MERGE_GAP'ten kisaysa iki aralik birlestirilir
+// (her aralik icin adres komutu da gider). Donanimdan bagimsizdir: hedefte sink I2C
+// (DiffSSD1306), host'ta kayit yapan sahte panel.
+
+#define FRAME_DIFF_MERGE_GAP  8     // Bu kadar sutundan kisa esit bosluk iki araligi birlestirir
+#define FRAME_DIFF_MAX_BUFFER 1024  // 128x64 / 8
+
+struct FrameDiff {
+  uint8_t  width;
+  uint8_t  pages;
+  bool     shadowValid;
+  uint8_t  shadow[FRAME_DIFF_MAX_BUFFER];  // en son gonderilen tampon
+  uint32_t flushes;
+  uint32_t sentBytes;     // gonderilen veri bayti (komutlar haric)
+  uint32_t skippedBytes;  // tam yenilemeye gore gonderilmeyen
+};
+
+void frameDiffBegin(FrameDiff &d, uint8_t width, uint8_t height);
+
+// Bir sonraki flush tum ekrani gondersin (ekran resetlendi / kontrast degisti vb.)
+inline void frameDiffInvalidate(FrameDiff &d) {
+  d.shadowValid = false;
+}
+
+// Degisen araliklari sink'e yaz (ilk cagrida veya invalidate sonrasi tamami).
+// Bu flush'ta gonderilen veri bayti sayisini dondurur.
+uint32_t frameDiffFlush(FrameDiff &d, const uint8_t* buffer, HalFrameSink &sink);
@@ -0,0 +1,74 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+// Donanim soyutlama katmani (HAL)
+// Firmware mantigi (zamanlayici, STM32 hatti, ekran farki, menu girisi) donanima dogrudan
+// degil bu arayuzler uzerinden erisir: saat, STM32 byte akisi, ekran sayfa yazimi ve
+// encoder/buton. Hedefte (ARDUINO) gercek donanim kullanilir (hal_arduino.cpp); host'ta
+// ([env:native]) sanal zamanli sahte uygulamalar (hal_host.h) takilir. Arayuzler bilerek
+// incedir: hedefte bir sanal cagri, host'ta testin/benchmark'in tam kontrolu.
+
+#ifdef ARDUINO
+#include <Arduino.h>
+#else
+#define IRAM_ATTR
+#endif
+
+// Saat ve uyku
+class HalClock {
+public:
+  virtual ~HalClock() {}
+  virtual unsigned long millis() = 0;
+  virtual unsigned long micros() = 0;
+  // Uyumadan once cagiran gorevi uyandirma hedefi olarak kaydet (setup()'ta)
+  virtual void begin() {}
+  // En fazla ms kadar uyu; wake() / halWakeFromISR() uykuyu erken bitirir
+  virtual void sleep(unsigned long ms) = 0;
+  virtual void wake() = 0;
+};
+
+// Cift yonlu byte akisi (STM32 UART'i)
+class HalByteStream {
+public:
+  virtual ~HalByteStream() {}
+  virtual int    available() = 0;
+  virtual size_t read(uint8_t* buf, size_t len) = 0;
+  virtual size_t write(const uint8_t* data, size_t len) = 0;
+};
+
+// Ekran: bir sayfanin (8 satir) [col0, col1] sutunlarini yaz
+class HalFrameSink {
+public:
+  virtual ~HalFrameSink() {}
+  virtual void writeSpan(uint8_t page, uint8_t col0, uint8_t col1, const uint8_t* data) = 0;
+};
+
+// Encoder ve buton
+class HalInput {
+public:
+  virtual ~HalInput() {}
+  // Son cagridan beri biriken encoder adimi (+ saat yonu)
+  virtual int  takeEncoderSteps() = 0;
+  virtual bool buttonDown() = 0;
+};
+
+// Etkin uygulamalar (hedefte Arduino, host'ta hal_host.h varsayilanlari)
+HalClock&      halClock();
+HalByteStream& halStm32Stream();
+HalInput&      halInput();
+
+// Uygulamayi degistir (host testleri / benchmark; nullptr = varsayilana don)
+void halSetClock(HalClock* clock);
+void halSetStm32Stream(HalByteStream* stream);
+void halSetInput(HalInput* input);
+
+// Kesmeden uyandirma (hedefte IRAM'de, sanal cagri yok)
+void IRAM_ATTR halWakeFromISR();
+
+#ifdef ARDUINO
+// Encoder (CLK/DT, CHANGE kesmesi) ve buton (INPUT_PULLUP, LOW = basili) pinlerini bagla.
+// Her kenar halWakeFromISR() ile loop()'u uyandirir.
+void halArduinoInputBegin(int clkPin, int dtPin, int swPin);
+#endif
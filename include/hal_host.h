@@ -0,0 +1,137 @@
+#pragma once
+
+#ifndef ARDUINO
+
+#include <deque>
+#include <stdint.h>
+
+#include "hal.h"
+
+// Host ([env:native]) HAL uygulamalari
+// Zaman sanaldir: yalnizca sleep() / advance() ile ilerler, boylece benchmark ve testler
+// gercek sureden bagimsiz ve tekrarlanabilir calisir. Saat her 1 ms'lik adimda tick kancasini
+// cagirir; STM32 simulatoru gibi "karsi taraf" bu kancada calisip hatta byte yazabilir ve
+// wake() ile uykuyu erken bitirebilir.
+
+class FakeClock : public HalClock {
+public:
+  typedef void (*TickHook)(unsigned long nowMs, void* ctx);
+
+  FakeClock() : nowUs(0), sleptUs(0), delayedUs(0), wakePending(false), tickHook(nullptr),
+                tickCtx(nullptr) {}
+
+  unsigned long millis() override { return (unsigned long)(nowUs / 1000); }
+  unsigned long micros() override { return (unsigned long)nowUs; }
+  // ms dolana veya wake() gelene kadar 1 ms adimlarla ilerle (bekleyen wake varsa hemen don)
+  void sleep(unsigned long ms) override;
+  void wake() override { wakePending = true; }
+
+  // Uyumadan ilerle (islem suresi modellemek icin); tick kancasi yine her ms'de cagrilir
+  void advanceUs(uint64_t us);
+  void advanceMs(unsigned long ms) { advanceUs((uint64_t)ms * 1000); }
+  // Arduino delay(): wake() ile bolunmez, sure delayedMicros()'a sayilir
+  void delay(unsigned long ms) {
+    delayedUs += (uint64_t)ms * 1000;
+    advanceMs(ms);
+  }
+
+  void setTickHook(TickHook hook, void* ctx) { tickHook = hook; tickCtx = ctx; }
+
+  uint64_t nowMicros() const { return nowUs; }
+  uint64_t sleptMicros() const { return sleptUs; }  // sleep() icinde gecen toplam sanal sure
+  uint64_t delayedMicros() const { return delayedUs; }  // delay() icinde gecen toplam sanal sure
+
+private:
+  uint64_t nowUs;
+  uint64_t sleptUs;
+  uint64_t delayedUs;
+  bool     wakePending;
+  TickHook tickHook;
+  void*    tickCtx;
+};
+
+// Tek yonlu byte kuyrugu
+struct HostPipe {
+  std::deque<uint8_t> bytes;
+  uint64_t            totalBytes = 0;  // simdiye kadar yazilan
+};
+
+// Iki pipe'in bir ucu: rx'ten okur, tx'e yazar
+class HostStreamEnd : public HalByteStream {
+public:
+  HostStreamEnd(HostPipe &rxPipe, HostPipe &txPipe) : rx(rxPipe), tx(txPipe) {}
+  int available() override { return (int)rx.bytes.size(); }
+  size_t read(uint8_t* buf, size_t len) override;
+  size_t write(const uint8_t* data, size_t len) override;
+
+private:
+  HostPipe &rx;
+  HostPipe &tx;
+};
+
+// Bellek ici cift yonlu hat: firmware ucu (ESP32) ve karsi uc (STM32 / simulator)
+struct HostStreamPair {
+  HostPipe      toPeer;
+  HostPipe      toFirmware;
+  HostStreamEnd firmware;
+  HostStreamEnd peer;
+  HostStreamPair() : firmware(toFirmware, toPeer), peer(toPeer, toFirmware) {}
+};
+
+// Sahte panel: yazilan araliklari kendi tamponuna uygular, istatistik tutar
+class HostFrameRecorder : public HalFrameSink {
+public:
+  explicit HostFrameRecorder(uint8_t width = 128) : width(width), spans(0), bytes(0) {
+    for (int i = 0; i < (int)sizeof(panel); i++) panel[i] = 0;
+  }
+  void writeSpan(uint8_t page, uint8_t col0, uint8_t col1, const uint8_t* data) override;
+
+  uint8_t  width;
+  uint8_t  panel[1024];
+  uint32_t spans;  // adres komutu sayisi
+  uint32_t bytes;  // veri bayti
+};
+
+// Betikli giris: testin cevirdigi encoder adimlari ve buton durumu
+class HostScriptedInput : public HalInput {
+public:
+  HostScriptedInput() : steps(0), down(false) {}
+  int takeEncoderSteps() override {
+    int s = steps;
+    steps = 0;
+    return s;
+  }
+  bool buttonDown() override { return down; }
+
+  void turn(int n) { steps += n; }
+  void setButton(bool pressed) { down = pressed; }
+
+private:
+  int  steps;
+  bool down;
+};
+
+#if defined(__unix__) || defined(__APPLE__)
+// Dosya tanimlayicisi uzerinden bloklamayan akis (pty, seri port)
+class HostFdStream : public HalByteStream {
+public:
+  explicit HostFdStream(int fd) : fd(fd) {}
+  int available() override;
+  size_t read(uint8_t* buf, size_t len) override;
+  size_t write(const uint8_t* data, size_t len) override;
+
+private:
+  int fd;
+};
+
+// Ham modda bir pty ac: ana ucun fd'sini dondurur (hata -1), karsi ucun yolu name'e yazilir.
+// Karsi uc bir seri terminal, socat koprusu veya USB-seri adaptor uzerinden ESP32 olabilir.
+int hostOpenPty(char* name, size_t nameLen);
+#endif
+
+// Varsayilan host uygulamalari (halSet* ile degistirilmediyse halClock() vb. bunlari dondurur)
+FakeClock&         hostClock();
+HostStreamPair&    hostStm32Link();  // firmware ucu halStm32Stream(), peer ucu simulatore
+HostScriptedInput& hostInput();
+
+#endif  // !ARDUINO
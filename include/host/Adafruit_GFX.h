@@ -0,0 +1,40 @@
+#pragma once
+
+// Host ([env:native]) Adafruit_GFX alt kumesi: piksel, cizgi, dikdortgen ve metin imleci
+// Metin gercek font yerine karakter koduna gore uretilen 5x7 desenle cizilir (6x8 hucre,
+// textSize olcekli, bosluk bos). Her karakter farkli desen verdigi icin ekran tamponu ve kismi
+// yenileme (frame_diff) gercekci degisir; piksel piksel dogruluk aranmaz.
+
+#include <Arduino.h>
+
+class Adafruit_GFX : public Print {
+public:
+  Adafruit_GFX(int16_t w, int16_t h);
+
+  virtual void drawPixel(int16_t x, int16_t y, uint16_t color) = 0;
+  void drawLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint16_t color);
+  void drawRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color);
+  void fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color);
+
+  void setCursor(int16_t x, int16_t y) { cursorX = x; cursorY = y; }
+  void setTextSize(uint8_t s) { textSize = s > 0 ? s : 1; }
+  void setTextColor(uint16_t c) { textColor = c; textBg = c; }
+  void setTextColor(uint16_t c, uint16_t bg) { textColor = c; textBg = bg; }
+  void getTextBounds(const char* s, int16_t x, int16_t y, int16_t* x1, int16_t* y1,
+                     uint16_t* w, uint16_t* h);
+
+  int16_t width() const { return WIDTH; }
+  int16_t height() const { return HEIGHT; }
+
+  using Print::write;
+  size_t write(uint8_t c) override;
+
+protected:
+  int16_t  WIDTH;
+  int16_t  HEIGHT;
+  int16_t  cursorX;
+  int16_t  cursorY;
+  uint8_t  textSize;
+  uint16_t textColor;
+  uint16_t textBg;
+};
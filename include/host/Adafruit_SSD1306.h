@@ -0,0 +1,32 @@
+#pragma once
+
+// Host ([env:native]) Adafruit_SSD1306 alt kumesi: 1 bpp sayfa duzenli tampon (gercek surucuyle
+// ayni yerlesim); display() tum tamponu I2C'ye yazar (Wire.h bayt sayar)
+
+#include <Adafruit_GFX.h>
+#include <Wire.h>
+
+#define SSD1306_BLACK        0
+#define SSD1306_WHITE        1
+#define SSD1306_INVERSE      2
+#define SSD1306_SWITCHCAPVCC 0x02
+#define SSD1306_COLUMNADDR   0x21
+#define SSD1306_PAGEADDR     0x22
+
+class Adafruit_SSD1306 : public Adafruit_GFX {
+public:
+  Adafruit_SSD1306(uint8_t w, uint8_t h, TwoWire* twi, int8_t rst);
+  ~Adafruit_SSD1306();
+
+  bool begin(uint8_t vcs = SSD1306_SWITCHCAPVCC, uint8_t addr = 0, bool reset = true,
+             bool periphBegin = true);
+  void display();
+  void clearDisplay();
+  void drawPixel(int16_t x, int16_t y, uint16_t color) override;
+  uint8_t* getBuffer() { return buffer; }
+
+private:
+  TwoWire* wire;
+  uint8_t  i2cAddress;
+  uint8_t* buffer;
+};
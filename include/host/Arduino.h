@@ -0,0 +1,96 @@
+#pragma once
+
+// Host ([env:native]) icin Arduino cekirdeginin firmware'in kullandigi alt kumesi
+// Yalnizca native ortamda (-I include/host) gorunur; hedefte gercek Arduino cekirdegi kullanilir.
+// Zaman HAL saatinden gelir: millis()/micros() sanal saat, delay() saati ilerletir ve
+// FakeClock::delayedMicros()'a sayilir. Serial stdout'a yazar (varsayilan kapali,
+// hostSerialEcho), Serial1 halStm32Stream()'e baglidir.
+
+#include <math.h>
+#include <stdarg.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "hal.h"
+
+#define HIGH 1
+#define LOW  0
+#define INPUT        0
+#define OUTPUT       1
+#define INPUT_PULLUP 2
+#define SERIAL_8N1   0x800001c
+
+inline unsigned long millis() { return halClock().millis(); }
+inline unsigned long micros() { return halClock().micros(); }
+void delay(unsigned long ms);
+inline void yield() {}
+inline void pinMode(int, int) {}
+inline int digitalRead(int) { return HIGH; }
+inline void digitalWrite(int, int) {}
+
+class Print {
+public:
+  virtual ~Print() {}
+  virtual size_t write(uint8_t c) = 0;
+  virtual size_t write(const uint8_t* data, size_t len) {
+    for (size_t i = 0; i < len; i++) write(data[i]);
+    return len;
+  }
+  size_t write(const char* s) { return write((const uint8_t*)s, strlen(s)); }
+
+  size_t print(const char* s) { return write(s); }
+  size_t print(char c) { return write((uint8_t)c); }
+  size_t print(int v, int base = 10) { return print((long)v, base); }
+  size_t print(unsigned int v, int base = 10) { return print((unsigned long)v, base); }
+  size_t print(long v, int base = 10);
+  size_t print(unsigned long v, int base = 10);
+  size_t print(double v, int digits = 2);
+
+  size_t println() { return write("\r\n"); }
+  template <typename T> size_t println(T v) { size_t n = print(v); return n + println(); }
+  template <typename T> size_t println(T v, int arg) { size_t n = print(v, arg); return n + println(); }
+
+  size_t printf(const char* format, ...) __attribute__((format(printf, 2, 3)));
+};
+
+class Stream : public Print {
+public:
+  virtual int available() { return 0; }
+  virtual int read() { return -1; }
+};
+
+// port 0: stdout (Serial), port 1: halStm32Stream() (Serial1)
+class HardwareSerial : public Stream {
+public:
+  explicit HardwareSerial(int port) : port(port), baud(0) {}
+
+  void begin(unsigned long baudRate, uint32_t = SERIAL_8N1, int8_t = -1, int8_t = -1) { baud = baudRate; }
+  void end() {}
+  void updateBaudRate(unsigned long baudRate) { baud = baudRate; }
+  unsigned long baudRate() const { return baud; }
+  bool setPins(int8_t, int8_t, int8_t = -1, int8_t = -1) { return true; }
+  void flush() {}
+
+  int available() override;
+  int read() override;
+  using Print::write;
+  size_t write(uint8_t c) override { return write(&c, 1); }
+  size_t write(const uint8_t* data, size_t len) override;
+
+private:
+  int           port;
+  unsigned long baud;
+};
+
+extern HardwareSerial Serial;
+extern HardwareSerial Serial1;
+
+// Serial ciktisini stdout'a ac / kapa (benchmark ciktisi karismasin diye varsayilan kapali)
+void hostSerialEcho(bool on);
+
+// Firmware giris noktalari (main.cpp)
+void setup();
+void loop();
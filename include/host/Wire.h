@@ -0,0 +1,25 @@
+#pragma once
+
+// Host ([env:native]) I2C: veri gitmez, yalnizca islem ve bayt sayilir
+
+#include <Arduino.h>
+
+class TwoWire : public Stream {
+public:
+  TwoWire() : clock(100000), transactions(0), bytes(0) {}
+
+  bool begin() { return true; }
+  void setClock(uint32_t hz) { clock = hz; }
+  void beginTransmission(uint8_t) { transactions++; }
+  uint8_t endTransmission(bool = true) { return 0; }
+
+  using Print::write;
+  size_t write(uint8_t) override { bytes++; return 1; }
+  size_t write(const uint8_t*, size_t len) override { bytes += len; return len; }
+
+  uint32_t clock;
+  uint32_t transactions;
+  uint64_t bytes;  // adres haric, kontrol baytlari dahil
+};
+
+extern TwoWire Wire;
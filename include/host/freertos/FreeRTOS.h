@@ -0,0 +1,21 @@
+#pragma once
+
+// Host ([env:native]) FreeRTOS alt kumesi: tek is parcacigi
+// Gorev olusturma yok; stm32_link host'ta haberlesme turunu dogrudan calistirir
+// (stm32LinkHostPoll). Kuyruklar sirali tampondur, bekleme suresi yok sayilir.
+
+#include <stdint.h>
+
+typedef int      BaseType_t;
+typedef unsigned UBaseType_t;
+typedef uint32_t TickType_t;
+
+#define pdTRUE  1
+#define pdFALSE 0
+#define pdPASS  pdTRUE
+#define portMAX_DELAY ((TickType_t)0xffffffffUL)
+#define pdMS_TO_TICKS(ms) ((TickType_t)(ms))
+
+struct HostQueue;
+typedef HostQueue* QueueHandle_t;
+typedef void*      TaskHandle_t;
@@ -0,0 +1,11 @@
+#pragma once
+
+#include "FreeRTOS.h"
+
+QueueHandle_t xQueueCreate(UBaseType_t length, UBaseType_t itemSize);
+// Dolu kuyrukta wait == 0 ise pdFALSE; bekleyen gonderimde (portMAX_DELAY) uzerine eklenir,
+// cunku tek is parcaciginda bosaltacak baska gorev yoktur
+BaseType_t xQueueSend(QueueHandle_t q, const void* item, TickType_t wait);
+BaseType_t xQueueReceive(QueueHandle_t q, void* item, TickType_t wait);
+BaseType_t xQueuePeek(QueueHandle_t q, void* item, TickType_t wait);
+UBaseType_t uxQueueMessagesWaiting(QueueHandle_t q);
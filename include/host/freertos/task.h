@@ -0,0 +1,8 @@
+#pragma once
+
+#include "FreeRTOS.h"
+
+// Tek gorev: handle sabittir, bildirim halWakeFromISR() ile loop()'un uykusunu bitirir
+TaskHandle_t xTaskGetCurrentTaskHandle();
+BaseType_t xTaskNotifyGive(TaskHandle_t task);
+void vTaskDelay(TickType_t ticks);
@@ -0,0 +1,43 @@
+#pragma once
+
+#include <Adafruit_SSD1306.h>
+#include <Wire.h>
+
+#include "frame_diff.h"
+
+// SSD1306 kismi yenileme
+// Adafruit_SSD1306::display() her cagrida 1 KB cerceve tamponunun tamamini I2C'den gonderir.
+// DiffSSD1306 son gonderilen tamponun bir kopyasini tutar; display() her sayfada (8 satir)
+// yalnizca degisen sutun araliklarini gonderir (PAGEADDR / COLUMNADDR + veri). Tek rakami
+// degisen bir ekranda (Z Ref, loadcell) birkac bayt gider. Cizim kodu degismez: ekranlar
+// yine clearDisplay() + ciz + display() yapar, fark frame_diff.h'de alinir; bu sinif yalnizca
+// araliklari I2C'ye yazan sink'tir.
+// display() Adafruit'te sanal degildir; nesne DiffSSD1306 olarak tanimlandigi icin
+// display.display() cagrilari bu surume gider.
+
+#define OLED_I2C_CLOCK       400000  // Aktarim sirasinda I2C hizi (Adafruit ile ayni)
+#define OLED_I2C_CLOCK_IDLE  100000  // Aktarim sonrasi
+#define OLED_I2C_CHUNK           32  // Bir I2C islemindeki en fazla bayt (kontrol bayti dahil)
+
+class DiffSSD1306 : public Adafruit_SSD1306, public HalFrameSink {
+public:
+  DiffSSD1306(uint8_t w, uint8_t h, TwoWire* twi, int8_t rst, uint8_t address);
+
+  // Degisen sayfa/sutun araliklarini gonder (ilk cagrida veya invalidate() sonrasi tamami)
+  void display();
+
+  // Bir sonraki display() tum ekrani gondersin (ekran resetlendi / kontrast degisti vb.)
+  void invalidate() { frameDiffInvalidate(diff); }
+
+  uint32_t flushCount() const { return diff.flushes; }
+  uint32_t bytesSent() const { return diff.sentBytes; }       // gonderilen veri bayti (komutlar haric)
+  uint32_t bytesSkipped() const { return diff.skippedBytes; } // tam yenilemeye gore gonderilmeyen
+
+  // Sayfa page'in [col0, col1] sutunlarini I2C'den yaz
+  void writeSpan(uint8_t page, uint8_t col0, uint8_t col1, const uint8_t* data) override;
+
+private:
+  TwoWire*  i2c;
+  uint8_t   i2cAddress;
+  FrameDiff diff;
+};
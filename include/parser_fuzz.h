@@ -0,0 +1,46 @@
+#pragma once
+
+#ifndef ARDUINO
+
+#include <stddef.h>
+#include <stdint.h>
+
+// STM32 cevap cozuculeri icin fuzz hedefi (host)
+// Girdinin ilk bayti hedefi secer, kalani o hedefe giden bayttir:
+//   $A ASCII  parseSTM32DataLine()      $A ikili  parseSTM32DataFrame()
+//   $X        parseSensorStatusLine()   $W        parseLoadcellLine()
+//   hat       stm32LinkFeed() -> satir birlestirici / ikili cerceve -> istek esleme -> cozuculer
+// Her calismada sonuc, bagimsiz yazilmis bir referans ayristiriciyla karsilastirilir: kabul /
+// ret ayni olmali, kabul edilen alanlar ayni degere, gelmeyen alanlar ve reddedilen satirda
+// tum hedefler onceki degerine esit kalmali. Ihlalde girdi yazdirilir ve abort() edilir.
+// Bellek hatalari icin sanitizer'la derlenir (README: Parser benchmark'i ve fuzz).
+//
+// Iki surucu:
+//   - libFuzzer (clang, -fsanitize=fuzzer -DHOST_LIBFUZZER): LLVMFuzzerTestOneInput bu hedefi
+//     cagirir, kapsama yonlendirmeli. native_main'in main()'i bu derlemede yoktur.
+//   - Dahili (native_main fuzz): tohum girdileri rastgele mutasyonla (bayt degistir / ekle / sil,
+//     tasma, ayirici ve sinir sayilari, tohum birlestirme) calistirir; kapsama geri beslemesi yok.
+
+enum ParserFuzzTarget {
+  PARSER_FUZZ_DATA_LINE = 0,
+  PARSER_FUZZ_DATA_FRAME,
+  PARSER_FUZZ_STATUS,
+  PARSER_FUZZ_LOADCELL,
+  PARSER_FUZZ_LINK,
+  PARSER_FUZZ_TARGETS
+};
+
+struct ParserFuzzStats {
+  uint32_t runs[PARSER_FUZZ_TARGETS];
+  uint32_t accepted[PARSER_FUZZ_TARGETS];  // hat hedefinde: cozulen satir sayisi
+};
+
+const char* parserFuzzTargetName(int target);
+
+// Tek girdiyi calistir (degismez ihlalinde abort)
+void parserFuzzOne(const uint8_t* data, size_t len, ParserFuzzStats* stats = nullptr);
+
+// Dahili surucu: iterations mutasyon, seed ile tekrarlanabilir
+void parserFuzzRun(uint32_t iterations, uint32_t seed, ParserFuzzStats &stats);
+
+#endif  // !ARDUINO
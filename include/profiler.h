@@ -0,0 +1,85 @@
+#pragma once
+
+#include <stdint.h>
+
+// Sicak yol profiler'i (debug)
+// Adlandirilmis bolgelerin sureleri cevrim sayaciyla olculur (hedefte ESP32 CCOUNT,
+// ESP.getCycleCount(); host'ta steady_clock ns). Bolge basina sayi, toplam, min, max ve
+// ceyrek oktav genislikli us histogrami tutulur; p99 histogramdan okunur (kova ust siniri,
+// en fazla ~%25 fazla). Amac gesture ekraninin yenileme hizini neyin sinirladigini gormek:
+// loop govdesinin, menu/hat/ekran adimlarinin ve I2C aktariminin paylari yan yana dokulur.
+//
+// Yalnizca -D PROFILER ile derlenir ([env:featheresp32_prof]); aksi halde PROFILE_ZONE bos
+// genisler, sicak yolda hicbir maliyet kalmaz. Tablo Serial debug konsolundan alinir:
+// "prof" dokum, "prof reset" sifirlama (main.cpp).
+// Bolgeler farkli gorevlerden (loop: cekirdek 1, PROFILE_PARSE_DATA: haberlesme gorevi,
+// cekirdek 0) kaydedilir; her bolgeyi tek gorev yazar, dokum/sifirlama kilitsizdir (debug
+// amacli, dokum sirasinda yarim kalan bir kayit tabloyu bozmaz).
+
+enum ProfileZone {
+  PROFILE_LOOP = 0,       // loop() govdesi (schedulerSleep() haric)
+  PROFILE_UPDATE_MENU,    // updateMenu()
+  PROFILE_POLL_LINK,      // pollSTM32Link(): cevap teslimi + telemetri karesi
+  PROFILE_READ_DATA,      // readSTM32Data(): $A istegi
+  PROFILE_TEST_JOB,       // testJobTick(): test adimlari, NTC/IR timeout, toplu kosu
+  PROFILE_DRAW_SCREEN,    // drawCurrentScreen() (display() dahil)
+  PROFILE_DISPLAY,        // DiffSSD1306::display(): fark + I2C aktarimi
+  PROFILE_PARSE_DATA,     // $A cozumu (haberlesme gorevi)
+  PROFILE_ZONES
+};
+
+#define PROFILER_BUCKETS  80  // 0-3 us tekil, sonra ceyrek oktav; son kova ~1 s ve ustu
+
+struct ProfileZoneStats {
+  uint32_t count;
+  uint64_t totalCycles;
+  uint32_t minCycles;
+  uint32_t maxCycles;
+  uint32_t buckets[PROFILER_BUCKETS];
+};
+
+class Print;
+
+#ifdef PROFILER
+
+#ifdef ARDUINO
+#include <Arduino.h>
+inline uint32_t profilerCycles() { return ESP.getCycleCount(); }
+#else
+uint32_t profilerCycles();
+#endif
+
+// Bir olcumu kaydet (cycles: profilerCycles() farki; 32 bit tasma farkla dogru kalir)
+void profilerRecord(ProfileZone zone, uint32_t cycles);
+
+class ProfileScope {
+public:
+  explicit ProfileScope(ProfileZone zone) : zone(zone), start(profilerCycles()) {}
+  ~ProfileScope() { profilerRecord(zone, profilerCycles() - start); }
+
+private:
+  ProfileZone zone;
+  uint32_t    start;
+};
+
+#define PROFILE_CONCAT2(a, b) a##b
+#define PROFILE_CONCAT(a, b)  PROFILE_CONCAT2(a, b)
+// Kapsam sonuna kadar olan sureyi zone'a yaz
+#define PROFILE_ZONE(zone) ProfileScope PROFILE_CONCAT(profileScope, __LINE__)(zone)
+
+#else
+
+#define PROFILE_ZONE(zone) do {} while (0)
+
+#endif  // PROFILER
+
+const char* profilerZoneName(int zone);
+
+// Bolge istatistiklerinin kopyasi (PROFILER kapaliyken false)
+bool profilerZoneStats(int zone, ProfileZoneStats &out);
+
+// Tum bolgeleri sifirla, olcum penceresini yeniden baslat
+void profilerReset();
+
+// Tabloyu yaz: bolge, sayi, hz, min / ort / p99 / max us, pencereye gore pay
+void profilerDump(Print &out);
@@ -0,0 +1,19 @@
+#pragma once
+
+#include "test_suite.h"
+
+// "Tumunu Test Et" (main.cpp): menu testlerinin tablosu ve toplu kosu
+// Menu disindan (host benchmark'i, native_main bench) testleri tek tek veya toplu
+// calistirmak icin. Testler loop()'taki test isiyle ilerler.
+
+extern TestSuite runAllSuite;
+
+// Test tablosu (ozet ekranindaki sira)
+const TestSuiteEntry* runAllEntries(int &count);
+
+// Kosudan once ortak test durumunu sifirla: fan gruplari, fren, projeksiyon sonucu ve
+// NTC/IR baglanti durumu ($X)
+void prepareRunAll();
+
+// Ozet ekraniyla toplu kosuyu baslat
+void startRunAll();
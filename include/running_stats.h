@@ -0,0 +1,29 @@
+#pragma once
+
+#include <stdint.h>
+
+// Akan olcumler icin ortalama / varyans (Welford)
+// Ornekler saklanmaz; her olcumde sayac, ortalama ve kare sapma toplami (m2) guncellenir.
+// Toplam / kare toplami yontemine gore sayisal olarak kararli (25.3 C civari degerlerde
+// kucuk varyans kaybolmaz).
+
+struct RunningStats {
+  uint16_t count;
+  float    mean;
+  float    m2;    // ortalamadan sapmalarin kareleri toplami
+  float    min;
+  float    max;
+};
+
+void runningStatsReset(RunningStats &s);
+void runningStatsAdd(RunningStats &s, float value);
+
+// Orneklem standart sapmasi (n - 1); iki olcumden azsa 0
+float runningStatsStdDev(const RunningStats &s);
+
+// Ortalamanin standart hatasi (stddev / sqrt(n)); iki olcumden azsa 0
+float runningStatsStdError(const RunningStats &s);
+
+inline float runningStatsRange(const RunningStats &s) {
+  return s.count > 0 ? s.max - s.min : 0.0f;
+}
@@ -0,0 +1,92 @@
+#pragma once
+
+#include <stdint.h>
+
+#include "running_stats.h"
+#include "telemetry.h"
+
+// Telemetri kanali ornekleyici (kararlilik testi)
+// Bir ornekleyici bir $A kanalina (TelemetryChannel) baglanir; baslatildiktan sonra her yeni
+// karede kanalin degeri eklenir: sayi, toplam, min, max, son deger, ortalama / varyans.
+// Limitler (deger araligi, ardil fark, min-max farki, olcum sayisi) ihlal edilince FAIL,
+// olcum sayisina ulasinca sonuc belirlenir. Ardisik modda ortalama/varyans yeterince
+// kesinlesince daha erken karar verilir. Plate/resin/PCB sicakligi, MCU yuku veya fan RPM'i
+// icin ayni kod: yeni bir kararlilik testi yalnizca yeni bir limit kaydidir.
+//
+// Ornekleyiciler sampleAccumulatorAttach() ile kaydedilir; loop() tarafi her yeni karede
+// sampleAccumulatorsFeed()'i bir kez cagirir. Test bitince onDone cagrilir.
+
+#define SAMPLE_ACCUMULATOR_MAX      8
+
+// Ardisik mod (erken karar) parametreleri
+#define SAMPLE_SEQ_MIN_SAMPLES      5    // Erken PASS icin en az olcum
+#define SAMPLE_SEQ_SPREAD_SIGMAS 4.0f    // Sabit sayida olcumde beklenen min-max farki (sigma cinsinden)
+#define SAMPLE_SEQ_RANGE_MARGIN  0.5f    // Erken PASS: gozlenen min-max farki <= limit * bu oran
+#define SAMPLE_SEQ_MEAN_SIGMAS   3.0f    // Ortalamanin guven araligi (standart hata cinsinden)
+
+enum SampleVerdict {
+  SAMPLE_IDLE = 0,
+  SAMPLE_RUNNING,
+  SAMPLE_PASS,
+  SAMPLE_FAIL
+};
+
+enum SampleFailReason {
+  SAMPLE_FAIL_NONE = 0,
+  SAMPLE_FAIL_VALUE,   // deger [valueMin, valueMax] disinda
+  SAMPLE_FAIL_STEP,    // iki ardil olcum farki > stepLimit
+  SAMPLE_FAIL_RANGE,   // min-max farki > rangeLimit
+  SAMPLE_FAIL_MEAN,    // ortalama [valueMin, valueMax] disinda
+  SAMPLE_FAIL_TIMEOUT  // sampleAccumulatorTimeout(): yeterli olcum gelmedi
+};
+
+struct SampleLimits {
+  float    valueMin;
+  float    valueMax;
+  float    stepLimit;   // <= 0: kontrol yok
+  float    rangeLimit;  // <= 0: kontrol yok
+  uint16_t count;       // sonuc icin olcum sayisi
+};
+
+struct SampleAccumulator;
+typedef void (*SampleDoneFunc)(SampleAccumulator &acc);
+
+struct SampleAccumulator {
+  const char*      name;        // Serial ozeti icin
+  TelemetryChannel channel;
+  SampleLimits     limits;
+  SampleDoneFunc   onDone;      // PASS/FAIL olunca (timeout dahil); nullptr olabilir
+  // Calisma durumu
+  SampleVerdict    verdict;
+  SampleFailReason failReason;
+  bool             sequential;  // ardisik (erken karar) mod
+  RunningStats     stats;       // sayi, ortalama, varyans, min, max
+  float            sum;
+  float            last;
+  unsigned long    startMs;
+  unsigned long    endMs;
+};
+
+#define SAMPLE_ACCUMULATOR(name, channel, limits, onDone) \
+  { name, channel, limits, onDone, SAMPLE_IDLE, SAMPLE_FAIL_NONE, false, {}, 0.0f, 0.0f, 0, 0 }
+
+// Ornekleyiciyi kare beslemesine kaydet (setup()'ta). Dolu ise false.
+bool sampleAccumulatorAttach(SampleAccumulator &acc);
+
+// Olcumleri sifirla ve baslat (ilk ornek bir sonraki karede)
+void sampleAccumulatorStart(SampleAccumulator &acc, bool sequential, unsigned long now);
+
+// Sonucsuz durdur (verdict = IDLE, onDone cagrilmaz)
+void sampleAccumulatorStop(SampleAccumulator &acc);
+
+// Sure doldu: olcum varsa ortalama deger araligindaysa PASS, yoksa FAIL (onDone cagrilir)
+void sampleAccumulatorTimeout(SampleAccumulator &acc, unsigned long now);
+
+// Calisan tum kayitli ornekleyicilere kareyi ekle
+void sampleAccumulatorsFeed(const TelemetrySnapshot &t);
+
+inline bool sampleAccumulatorRunning(const SampleAccumulator &acc) {
+  return acc.verdict == SAMPLE_RUNNING;
+}
+
+const char* sampleFailReasonLabel(SampleFailReason reason);
@@ -0,0 +1,39 @@
+#pragma once
+
+#include "hal.h"
+
+// loop() icin zaman tabanli isbirlikci zamanlayici
+// Her periyodik is (veri okuma, ekran yenileme, $X sorgusu, ...) bir periyot ve bir sonraki
+// calisma zamani (deadline) ile kaydedilir. Isler deadline'a gore kucuk bir min-heap'te tutulur;
+// loop() vadesi gelenleri calistirir ve bir sonraki deadline'a kadar uyur. Encoder/buton
+// kesmesi veya STM32 cevabi (task notification) uykuyu erken bitirir.
+// Sonraki deadline = onceki deadline + periyot: gecikme birikmez (NTC/IR 100 ms ornekleme).
+// Tek gorev (loop) kullanir; yalnizca schedulerWake/FromISR baska gorev/kesmeden cagrilabilir.
+// Zaman ve uyku halClock() uzerinden: host'ta sanal saatle calisir.
+
+#define SCHEDULER_MAX_JOBS      8
+#define SCHEDULER_MAX_SLEEP_MS  100  // Hic olay olmasa bile en gec bu surede bir uyan (ms)
+
+typedef void (*SchedulerJobFunc)(unsigned long now);
+
+// Uyandirma hedefi olarak cagiran gorevi kaydet (setup()'ta, loop ile ayni gorevde)
+void schedulerBegin();
+
+// Periyodik is ekle; ilk calisma firstDelayMs sonra. Is kimligini (dolu ise -1) dondurur.
+int schedulerAdd(SchedulerJobFunc fn, unsigned long periodMs, unsigned long firstDelayMs = 0);
+
+// Periyodu degistir (ayni ise bir sey yapmaz). Yeni deadline = son calisma + yeni periyot.
+void schedulerSetPeriod(int job, unsigned long periodMs);
+
+// Isi delayMs sonra calisacak sekilde yeniden zamanla (0 = hemen)
+void schedulerRunAfter(int job, unsigned long delayMs);
+
+// Vadesi gelen tum isleri deadline sirasiyla calistir
+void schedulerRunDue();
+
+// Bir sonraki deadline'a kadar (en fazla SCHEDULER_MAX_SLEEP_MS) veya uyandirilana kadar uyu
+void schedulerSleep();
+
+// Uykudaki loop()'u hemen uyandir (baska gorevden / kesmeden)
+void schedulerWake();
+void IRAM_ATTR schedulerWakeFromISR();
@@ -0,0 +1,38 @@
+#pragma once
+
+#include <stdint.h>
+
+// Kayan pencerede kararli durum tespiti
+// Son N olcum (deger + alinma zamani) halka tamponda tutulur. Pencere dolunca egim (en kucuk
+// kareler, birim/saniye) ve standart sapma hesaplanir; ikisi de esigin altindaysa olcum
+// oturmus sayilir. Sabit bir bekleme yerine "deger artik degismiyor" anini bulmak icin.
+
+#define STEADY_WINDOW_MAX 8
+
+struct SteadyWindow {
+  float         value[STEADY_WINDOW_MAX];
+  unsigned long ms[STEADY_WINDOW_MAX];
+  uint8_t       size;   // kullanilan pencere boyu (<= STEADY_WINDOW_MAX)
+  uint8_t       count;  // penceredeki olcum sayisi (<= size)
+  uint8_t       head;   // bir sonraki yazilacak yer
+};
+
+// Pencereyi bosalt; size 2..STEADY_WINDOW_MAX arasina kirpilir
+void steadyWindowReset(SteadyWindow &w, int size);
+
+// Olcum ekle (pencere doluysa en eskisi duser)
+void steadyWindowAdd(SteadyWindow &w, unsigned long ms, float value);
+
+float steadyWindowMean(const SteadyWindow &w);
+float steadyWindowMin(const SteadyWindow &w);
+float steadyWindowStdDev(const SteadyWindow &w);
+
+// Zamana gore egim (birim / saniye); iki olcumden azsa 0
+float steadyWindowSlope(const SteadyWindow &w);
+
+inline bool steadyWindowFull(const SteadyWindow &w) {
+  return w.count >= w.size;
+}
+
+// Pencere dolu, |egim| <= maxSlope ve standart sapma <= maxStdDev
+bool steadyWindowSettled(const SteadyWindow &w, float maxSlope, float maxStdDev);
@@ -0,0 +1,28 @@
+#pragma once
+
+// STM32 cevap cozuculeri (main.cpp): $A satiri / ikili cercevesi, $X ve $Wn
+// Hepsi satiri once tamamen ayristirir, yalnizca gecerliyse hedeflere yazar (stm32_fields.h);
+// bozuk satir hicbir degiskeni yarim guncellemez. Haberlesme katmanindan gelen satirlar
+// '\0' ile biter ve STM32_LINE_MAX'i asmaz; cozuculer daha uzun girdide de sinir disina cikmaz.
+// Host'ta parser benchmark'i ve fuzz hedefi (parser_fuzz.h) ayni fonksiyonlari calistirir.
+
+// $A satiri / ikili cercevesi (CRC dogrulanmis): alanlar telemetri karesine yazilir ve kare
+// yayinlanir (telemetry.h). En az 4 alan yoksa kare yok sayilir ve false doner.
+bool parseSTM32DataLine(const char* buffer);
+bool parseSTM32DataFrame(const char* frame);
+
+// $X: NTC/IR durumunu dondurur, diger durumlari asagidaki globallere yazar. Once hepsi OK'a
+// (NTC/IR 1 = baglanti yok) cekilir; buffer == nullptr (zaman asimi) veya gecersiz satirda
+// oyle kalir ve false doner. En az NTC ve IR alanlari gerekir.
+bool parseSensorStatusLine(const char* buffer, int &ntcStatus, int &irStatus);
+
+// $Wn: tek ondalikli gram degeri ("$-152.28"). Gecersizse false, value degismez.
+bool parseLoadcellLine(const char* line, float &value);
+
+// $X ile gelen hata/status degerleri (0: OK, 1: HATA)
+extern int intake1_fan_error;
+extern int intake2_fan_error;
+extern int exhaust_fan_error;
+extern int gesture_sensor_status;
+extern int projector_sensor_status;
+extern int force_sensor_status;
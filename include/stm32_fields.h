@@ -0,0 +1,127 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+// STM32 cevap satirlari icin ortak alan ayristirici ($A, $X, $Wn)
+// Her cevap bir sema ile tarif edilir: alan sirasi, isaret, ondalik hane, olcek ve hedef degisken.
+// Ayristirma iki adimdir: once tum satir ham tam sayilara cevrilir (hic yazma yok), satir
+// gecerliyse hedeflere yazilir. Bozuk satir hicbir degiskeni yarim guncellemez. Heap kullanilmaz.
+//
+// Satir formati: "$" + virgulle ayrilmis alanlar. Alan: [-]rakamlar[.rakamlar]
+// Gecersiz satir: bos alan, rakam/virgul/nokta/eksi disinda karakter, isaretsiz alanda eksi,
+// ondaliksiz alanda nokta, 9 haneyi asan sayi. Semadan fazla alan varsa fazlasi yok sayilir.
+
+struct Stm32Field {
+  bool     isSigned;   // '-' kabul edilir mi
+  uint8_t  decimals;   // metinde tutulan ondalik hane (0 = tam sayi; fazlasi kesilir)
+  float    divisor;    // float hedef: deger = ham / divisor (ornek $A sicakliklari icin 10)
+  float*   floatDest;  // hedef (ikisinden biri veya hicbiri; nullptr ise cagiran ham degeri okur)
+  int*     intDest;
+};
+
+// Tam sayi alan (status, gesture, TMC bitleri)
+constexpr Stm32Field stm32IntField(int* dest, bool isSigned = false) {
+  return Stm32Field{ isSigned, 0, 1.0f, nullptr, dest };
+}
+
+// Olcekli tam sayi alan: "286" / 10 -> 28.6
+constexpr Stm32Field stm32ScaledField(float* dest, float divisor, bool isSigned = true) {
+  return Stm32Field{ isSigned, 0, divisor, dest, nullptr };
+}
+
+// Ondalikli metin alan: "-152.28" -> -152.28 (decimals haneye kadar)
+constexpr Stm32Field stm32DecimalField(float* dest, uint8_t decimals) {
+  return Stm32Field{ true, decimals, decimals == 0 ? 1.0f : decimals == 1 ? 10.0f :
+                     decimals == 2 ? 100.0f : 1000.0f, dest, nullptr };
+}
+
+#define STM32_FIELD_MAX_DIGITS 9  // int32'ye tasmadan tutulabilecek toplam hane
+
+// Ham degeri alanin birimine cevir
+inline float stm32FieldValue(const Stm32Field &field, int32_t raw) {
+  return raw / field.divisor;
+}
+
+// Tek alani ayristir: line alanin ilk karakterini gosterir, bitince ',' veya '\0'i gosterir.
+// Basarisizsa false.
+inline bool stm32ParseField(const char* &line, const Stm32Field &field, int32_t &raw) {
+  const char* p = line;
+  bool negative = false;
+  if (*p == '-') {
+    if (!field.isSigned) return false;
+    negative = true;
+    p++;
+  }
+  int32_t value = 0;
+  int digits = 0;
+  while (*p >= '0' && *p <= '9') {
+    if (++digits > STM32_FIELD_MAX_DIGITS) return false;
+    value = value * 10 + (*p++ - '0');
+  }
+  if (digits == 0) return false;
+
+  int frac = 0;
+  if (*p == '.') {
+    if (field.decimals == 0) return false;
+    p++;
+    if (*p < '0' || *p > '9') return false;
+    while (*p >= '0' && *p <= '9') {
+      if (frac < field.decimals) {
+        if (++digits > STM32_FIELD_MAX_DIGITS) return false;
+        value = value * 10 + (*p - '0');
+        frac++;
+      }
+      p++;
+    }
+  }
+  for (; frac < field.decimals; frac++) {
+    if (++digits > STM32_FIELD_MAX_DIGITS) return false;
+    value *= 10;
+  }
+  if (*p != ',' && *p != '\0') return false;
+
+  raw = negative ? -value : value;
+  line = p;
+  return true;
+}
+
+// Satiri semaya gore raw'a ayristir (hedeflere yazmaz).
+// Ayristirilan alan sayisini, satir gecersizse -1 dondurur.
+template <size_t N>
+int stm32ParseFields(const char* line, const Stm32Field (&schema)[N], int32_t (&raw)[N]) {
+  if (line == nullptr || line[0] != '$') return -1;
+  const char* p = line + 1;
+  int count = 0;
+  while (true) {
+    if (count < (int)N) {
+      if (!stm32ParseField(p, schema[count], raw[count])) return -1;
+      count++;
+    } else {
+      // Semadan fazla alan (yeni STM32 yazilimi): icerik kontrol edilmeden atlanir
+      while (*p != ',' && *p != '\0') p++;
+    }
+    if (*p == '\0') break;
+    p++; // ','
+  }
+  return count;
+}
+
+// Ilk count alani semadaki hedeflere yaz
+template <size_t N>
+void stm32StoreFields(const Stm32Field (&schema)[N], const int32_t* raw, int count) {
+  for (int i = 0; i < count && i < (int)N; i++) {
+    const Stm32Field &field = schema[i];
+    if (field.floatDest != nullptr) *field.floatDest = stm32FieldValue(field, raw[i]);
+    if (field.intDest != nullptr)   *field.intDest   = (int)raw[i];
+  }
+}
+
+// Ayristir ve en az minFields alan varsa hedeflere yaz. Alan sayisini (yetersiz/gecersizse -1) dondurur.
+template <size_t N>
+int stm32ParseInto(const char* line, const Stm32Field (&schema)[N], int32_t (&raw)[N], int minFields) {
+  int count = stm32ParseFields(line, schema, raw);
+  if (count < minFields) return -1;
+  stm32StoreFields(schema, raw, count);
+  return count;
+}
@@ -0,0 +1,185 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+// STM32 UART haberlesme katmani
+// Serial1'den gelen byte'lar arka planda (HardwareSerial olay gorevi icinde) satirlara
+// birlestirilir; tamamlanan "$...\r\n" satirlari sabit boyutlu bir halka tampona yazilir.
+//
+// Gorev yapisi: Serial1'in sahibi ayri bir haberlesme gorevidir (STM32_COMMS_CORE).
+// Komut gonderimi, cevap eslestirme, zaman asimi ve $A verisinin parse edilmesi orada yapilir.
+// loop() (UI/test gorevi, diger cekirdek) komutlari bir kuyruga yazar ve cevaplari ikinci bir
+// kuyruktan stm32LinkService() ile alir; STM32 ne kadar gec cevap verirse versin UI bloke olmaz.
+// Her cevap ve $A karesi stm32LinkBegin()'i cagiran gorevi task notification ile uyandirir
+// (loop() bir sonraki isine kadar uyurken cevabi beklemeden islesin).
+
+#define STM32_LINE_MAX      96  // Satir tamponu ('\0' dahil); daha uzun satirlar komple atilir
+#define STM32_LINE_SLOTS    16  // Halka tamponda bekleyebilecek tam satir sayisi (2'nin kuvveti)
+#define STM32_CMD_MAX       32  // Giden komut metni ('\0' dahil, "\r\n" haric)
+#define STM32_QUEUE_SLOTS   12  // Giden kuyruk + cevabi beklenen istekler icin toplam slot
+#define STM32_MAX_IN_FLIGHT 4   // Cevabi beklenen, ayni anda yolda olabilecek istek sayisi
+
+#define STM32_COMMS_CORE      0     // Haberlesme gorevinin cekirdegi (loop() 1'de calisir)
+#define STM32_COMMS_PRIORITY  5     // loop()'tan (1) yuksek
+#define STM32_COMMS_STACK     4096  // $A parse + Serial log icin yeterli
+#define STM32_COMMS_IDLE_MS   1     // Olay yokken zaman asimi kontrolu araligi
+
+// --- Ikili $A cercevesi ($AB1 ile acilir) ---
+// [0] 0xA5 senkron  [1] uzunluk (payload byte)  [2..] payload  [son 2] CRC16 (LSB once)
+// Payload (little endian, 16 veya 17 byte): int16 x4 (MCU load, PCB, plate, resin; x10),
+// uint16 x3 (intake1, intake2, exhaust RPM; x10), uint8 gesture, uint8 TMC bitleri
+// (bit0 Z_R, bit1 Y_R, bit2 Y_L, bit3 CVR1_R, bit4 CVR1_L, bit5 CVR2_R, bit6 CVR2_L),
+// [opsiyonel] uint8 motor mesgul bitleri (STM32_MOTOR_BUSY_*).
+// CRC16/CCITT-FALSE (0x1021, baslangic 0xFFFF) uzunluk + payload uzerinden hesaplanir.
+// Senkron byte yazdirilamayan karakter oldugu icin ASCII satirlarla karismaz. Alim tarafi
+// ASCII'yi her zaman, cerceveyi yalnizca $AB1 onayi hattan gectikten sonra kabul eder; $A
+// disinda uzunluk tasiyan senkron gurultu sayilir, CRC'si tutmayan cerceve atilir.
+#define STM32_BIN_SYNC         0xA5
+#define STM32_BIN_DATA_LEN     17   // $A cercevesi payload uzunlugu
+#define STM32_BIN_DATA_MIN_LEN 16   // Motor mesgul byte'i olmayan (eski) cerceve
+#define STM32_DATA_FIELDS      16   // $A alan sayisi (ASCII ve ikili; eski yazilim 15)
+#define STM32_BIN_FRAME_LEN    (2 + STM32_BIN_DATA_LEN + 2)  // Senkron + uzunluk + payload + CRC
+
+// $A 16. alan: hareketi suren motorlar (1 = hareket komutu henuz bitmedi). Hareket komutunu
+// alinca set, hedefe varinca veya stop ile temizlenir. 15 alan gonderen eski yazilimda yok.
+#define STM32_MOTOR_BUSY_Z     (1 << 0)
+#define STM32_MOTOR_BUSY_Y     (1 << 1)
+#define STM32_MOTOR_BUSY_CVR1  (1 << 2)
+#define STM32_MOTOR_BUSY_CVR2  (1 << 3)
+
+// --- Istek/cevap islem katmani ---
+// Tum giden komutlar tek bir kuyruktan, eklenme sirasinda gonderilir. Cevap bekleyen
+// istekler STM32_MAX_IN_FLIGHT adede kadar ard arda yola cikar (ornek: $W1..$W4), pencere
+// doluysa kuyrukta bekler. Gelen satir, sekline (alan sayisi / ondalik nokta) uyan yoldaki
+// istekler arasinda en once gonderilene eslenir; STM32 komutlari sirayla cevapladigi icin
+// cevaplar da sirayla tuketilir. Hicbir istege uymayan satirlar atilir; baska bir islemin
+// cevabi ise hicbir zaman atilmaz.
+enum Stm32Request {
+  STM32_REQ_DATA = 0,   // $A  -> 4..16 alanli telemetri
+  STM32_REQ_STATUS,     // $X  -> 2..8 alanli tamsayi status
+  STM32_REQ_LOADCELL,   // $Wn -> tek ondalikli deger (gram)
+  STM32_REQ_ACK,        // $AB1 gibi ayar komutlari -> komutun aynisi geri gelir
+  STM32_REQ_COUNT
+};
+
+// Cevap geldiginde (line != nullptr) veya zaman asiminda / kayipta (line == nullptr) cagrilir.
+// Istek handler'lari istegi yapan gorevde, stm32LinkService() icinden cagrilir.
+// STM32_REQ_DATA cevaplari ve akis satirlari ikili cerceve de olabilir (stm32LinkIsDataFrame).
+typedef void (*Stm32ReplyHandler)(const char* line, void* ctx);
+
+// Tum $A verisi (istek cevabi veya $AS akisi) icin handler. Haberlesme gorevinde cagrilir;
+// yalnizca kendi verisine yazmali (ornek: telemetri karesini yayinlamak). line != nullptr.
+// stm32LinkBegin()'den once ayarlanir.
+void stm32LinkSetDataHandler(Stm32ReplyHandler onFrame, void* ctx = nullptr);
+
+// Kuyruklari ve haberlesme gorevini olustur, Serial1 alim callback'ini bagla
+// (Serial1.begin sonrasi bir kez cagrilir)
+void stm32LinkBegin();
+
+// Gelen byte'lari satir birlestiriciye ver (UART olay gorevinden cagrilir)
+void stm32LinkFeed(const uint8_t* data, size_t len);
+
+// Cevapsiz komutu kuyruga ekle ("\r\n" eklenir). Onunde bekleyen yoksa hemen gonderilir.
+bool stm32LinkSend(const char* cmd);
+
+// Cevap bekleyen istegi kuyruga ekle ve beklemeden don. Cevap/zaman asimi
+// stm32LinkService() icinden onReply(line, ctx) ile bildirilir (onReply nullptr olabilir;
+// $A icin veri zaten veri handler'ina gider). timeoutMs gonderimden sayilir.
+bool stm32LinkRequest(Stm32Request type, const char* cmd, unsigned long timeoutMs,
+                      Stm32ReplyHandler onReply, void* ctx = nullptr);
+
+// Istegi gonder ve cevabi reply'a al (en fazla timeoutMs). Beklerken diger islemlerin
+// cevaplari kendi handler'larina gitmeye devam eder.
+bool stm32LinkTransact(Stm32Request type, const char* cmd, char* reply, size_t replyLen,
+                       unsigned long timeoutMs);
+
+// Bloklayan bekleme: done(ctx) true olana kadar cevaplari isle, arada 1 ms bekle
+// (ornek: $W1..$W4 cevaplarinin hepsi). Gecen sure stm32LinkBlockedMs()'e eklenir.
+void stm32LinkWaitUntil(bool (*done)(void* ctx), void* ctx);
+
+// Bu turden cevabi (veya zaman asimi) henuz stm32LinkService() ile alinmamis istek var mi
+bool stm32LinkIsPending(Stm32Request type);
+
+// Gonderilmis ve cevabi beklenen istek sayisi
+int stm32LinkInFlight();
+
+// Haberlesme gorevinden gelen cevaplari al ve istek handler'larini cagir (loop'tan)
+void stm32LinkService();
+
+// --- Telemetri akisi ($AS) ---
+// "$AS<ms>" ile STM32 $A cevabiyla ayni 16 alanli satiri istek beklemeden <ms> aralikla
+// gonderir, "$AS0" akisi durdurur. Hicbir $A istegine ait olmayan tam $A satirlari da
+// veri handler'ina verilir. Akis gelmiyorsa (eski STM32 yazilimi, STM32 reseti) stm32LinkStreaming()
+// false doner ve cagiran $A polling'e devam eder; abonelik STM32_STREAM_RETRY_MS'de bir yenilenir.
+#define STM32_STREAM_RETRY_MS  5000  // Akis yokken $AS aboneligini tekrar deneme araligi (ms)
+#define STM32_STREAM_GRACE_MS  100   // Akis periyodunun 3 katina eklenen tolerans; asilirsa akis kopmus sayilir
+
+// Istenen akis periyodunu bildir (0 = akis kapali). Her loop'ta cagrilabilir; komut sadece
+// periyot degistiginde veya akis gelmiyorsa STM32_STREAM_RETRY_MS'de bir gonderilir.
+void stm32LinkSubscribe(unsigned long periodMs);
+
+// Akis aktif mi: abone olundu ve son satir beklenen surede geldi
+bool stm32LinkStreaming();
+
+// STM32'den ikili $A cercevesi iste ($AB1). STM32 onaylarsa true doner; onaylamazsa
+// (eski yazilim) ASCII devam eder. Cagri cevap gelene veya timeoutMs dolana kadar bekler.
+bool stm32LinkNegotiateBinary(unsigned long timeoutMs);
+
+// STM32 ikili cerceveyi onayladi mi
+bool stm32LinkBinaryFrames();
+
+// --- Baud pazarligi ($U) ---
+// "$U<baud>" STM32'ye yeni hizi sorar. Destekliyorsa komutun aynisini mevcut hizda geri
+// gonderir ve yeni hiza gecer; ESP32 de gecer ve STM32_BAUD_VERIFY_ROUNDS tur $A/$X ile hatti
+// dogrular. Dogrulama tutmazsa iki taraf da eski hiza doner (STM32 yeni hizda
+// STM32_BAUD_REVERT_MS icinde gecerli komut alamazsa kendiliginden doner) ve siradaki hiz denenir.
+#define STM32_BAUD_VERIFY_ROUNDS 3
+#define STM32_BAUD_REVERT_MS     300
+
+// rates sirayla denenir (en hizlisi once). Kullanilan baud'u dondurur (hicbiri olmazsa currentBaud).
+// Yalnizca setup()'ta, baska istek yokken cagrilir.
+unsigned long stm32LinkNegotiateBaud(unsigned long currentBaud, const unsigned long* rates,
+                                     int rateCount, unsigned long timeoutMs);
+
+// STM32_REQ_DATA handler'ina gelen satir ikili cerceve mi (degilse ASCII "$..." satiri)
+inline bool stm32LinkIsDataFrame(const char* line) {
+  return (uint8_t)line[0] == STM32_BIN_SYNC;
+}
+
+// Ikili cerceveyi (CRC alimda dogrulanmis) ASCII $A ile ayni sirada values'a ac.
+// Acilan alan sayisini dondurur.
+int stm32LinkDecodeDataFrame(const char* frame, int32_t* values, int maxValues);
+
+// STM32_DATA_FIELDS alani (ASCII $A sirasi) ikili cerceveye yaz (STM32 tarafi / modeller).
+// frame en az STM32_BIN_FRAME_LEN byte olmali; cerceve uzunlugunu dondurur.
+size_t stm32LinkEncodeDataFrame(const int32_t* values, uint8_t* frame);
+
+// CRC16/CCITT-FALSE (cerceve dogrulama / uretme)
+uint16_t stm32LinkCrc16(const uint8_t* data, size_t len);
+
+// CRC hatasi veya gecersiz uzunluk nedeniyle atilan ikili cerceve sayisi (debug)
+uint32_t stm32LinkCrcErrors();
+
+// Tampon dolu oldugu veya satir cok uzun oldugu icin atilan satir sayisi (debug)
+uint32_t stm32LinkDroppedLines();
+
+// Hicbir bekleyen istege uymadigi icin atilan satir sayisi (debug)
+uint32_t stm32LinkUnmatchedLines();
+
+// --- Zamanlama sayaclari (debug, host benchmark'i) ---
+// Cevabi gelen istek sayisi (gidis-donus) ve zaman asimina ugrayan / kaybolan istek sayisi
+uint32_t stm32LinkRoundTrips();
+uint32_t stm32LinkTimeouts();
+// Cevabi gelen isteklerin gonderimden cevaba toplam suresi (ms)
+uint32_t stm32LinkReplyWaitMs();
+// loop()'un bloklayan beklemelerde (stm32LinkTransact, stm32LinkWaitUntil, dolu kuyruk)
+// gecirdigi toplam sure (ms)
+uint32_t stm32LinkBlockedMs();
+
+#ifndef ARDUINO
+// Host ([env:native]): haberlesme gorevinin bir turunu calistir (gelen byte'lari al, cevaplari
+// esle, kuyrugu gonder). Sanal saatin tick kancasindan her ms cagrilir; stm32LinkBegin()
+// oncesinde bir sey yapmaz.
+void stm32LinkHostPoll();
+#endif
@@ -0,0 +1,164 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "hal.h"
+#include "stm32_link.h"
+
+// STM32 davranis modeli (donanimdan bagimsiz)
+// SERI_HABERLESME.md'deki komutlari ($A/$AS/$AB, $X, $U, $F1-3, $LA, $B, $P/$PC, $I, $S*, $WT/$Wn)
+// byte olarak alir; cevaplari gercek STM32 gibi sirayla, komut gecikmesi + secili baud'daki hat
+// suresi sonunda uretir. Fiziksel taraf:
+//   - sicakliklar yavas dalga, MCU yuku, sirayla gesture
+//   - fan RPM'i duty'ye birinci dereceden yanit verir (STM32_MODEL_FAN_TAU_MS); duran fan $X hatasi
+//   - step motorlar konum tutar, hareket suresi adim / hiz + rampa; hat sonundaki TMC stop
+//     switch'ine gelen motor durur ve stop biti $A'da 1 olur
+//   - loadcell: $WT sonrasi degerler sifira ustel oturur, olcum gurultusu var
+// Hat hatalari (gecikme, jitter, byte kaybi ve tek bit bozulma) iki yone de uygulanir. Rastgelelik
+// tohumludur: ayni tohum ve ayni komut akisi ayni sonucu verir.
+// Kullananlar: hedefte STM32_SIM (stm32_sim.cpp), host'ta native_main'in sim / sim-pty komutlari.
+
+#define STM32_MODEL_LATENCY_MS      5     // Komut -> cevap gecikmesi (STM32 ana dongusu)
+#define STM32_MODEL_REPLY_SLOTS     8     // Hatta cikmayi bekleyen cevap / akis satiri
+#define STM32_MODEL_BAUD            115200
+#define STM32_MODEL_MOTOR_RAMP_MS   60    // Hareket suresine eklenen hizlanma / yavaslama
+#define STM32_MODEL_FAN_MAX_RPM     4000.0f
+#define STM32_MODEL_FAN_TAU_MS      700.0f  // Fan RPM zaman sabiti (%63 yanit)
+#define STM32_MODEL_FAN_STALL_RPM   300.0f  // Duty varken bunun altinda kalan fan $X'te hatali
+#define STM32_MODEL_FAN_ERR_MS      1500    // Duty degisiminden sonra hata icin bekleme
+#define STM32_MODEL_LOADCELL_TAU_MS 400.0f  // $WT sonrasi ofsetin sonmesi
+#define STM32_MODEL_LOADCELL_NOISE_G 0.3f   // Tek okumada +- gurultu
+
+#define STM32_MODEL_FANS   3  // Intake1, Intake2, Exhaust ($F1..$F3)
+#define STM32_MODEL_AXES   4  // Z, Y, CVR1, CVR2 (STM32_MOTOR_BUSY_* sirasi)
+#define STM32_MODEL_CELLS  4  // $W1..$W4
+
+// $X alanlari (bit = alan sirasi); statusFaults ile zorlanir
+#define STM32_MODEL_FAULT_NTC       (1 << 0)
+#define STM32_MODEL_FAULT_IR        (1 << 1)
+#define STM32_MODEL_FAULT_EXHAUST   (1 << 2)
+#define STM32_MODEL_FAULT_INTAKE1   (1 << 3)
+#define STM32_MODEL_FAULT_INTAKE2   (1 << 4)
+#define STM32_MODEL_FAULT_GESTURE   (1 << 5)
+#define STM32_MODEL_FAULT_PROJECTOR (1 << 6)
+#define STM32_MODEL_FAULT_FORCE     (1 << 7)
+#define STM32_MODEL_STATUS_FIELDS   8
+
+// Hat hatalari (varsayilan: gecikme STM32_MODEL_LATENCY_MS, hata yok)
+struct Stm32ModelLink {
+  unsigned long latencyMs;   // komut -> cevap
+  unsigned long jitterMs;    // cevaba 0..jitterMs rastgele eklenir
+  uint32_t      lossPpm;     // byte basina kayip olasiligi (milyonda)
+  uint32_t      corruptPpm;  // byte basina tek bit bozulma olasiligi (milyonda)
+};
+
+struct Stm32ModelStats {
+  uint32_t commands;         // tam komut satiri
+  uint32_t unknownCommands;  // taninmayan / bozuk komut
+  uint32_t replies;          // istek cevabi ve onaylar
+  uint32_t streamLines;      // $AS satiri
+  uint32_t droppedReplies;   // cevap kuyrugu doluydu
+  uint32_t limitHits;        // stop switch'inde duran hareket
+  uint64_t bytesIn;          // ESP32 -> STM32 (kayip dahil)
+  uint64_t bytesOut;         // STM32 -> ESP32 (kayip dahil)
+  uint32_t bytesLost;
+  uint32_t bytesCorrupted;
+};
+
+struct Stm32ModelAxis {
+  bool          enabled;
+  bool          busy;
+  long          pos;          // mikrostep
+  long          minPos;       // sol / geri stop switch'i (0 yonu)
+  long          maxPos;       // sag / ileri stop switch'i (1 yonu)
+  long          startPos;
+  long          steps;        // isaretli hedef mesafe
+  long          speed;        // mikrostep/s
+  unsigned long startMs;
+  unsigned long durationMs;
+};
+
+struct Stm32ModelReply {
+  uint64_t dueUs;   // son byte'in hattan cikacagi an
+  uint8_t  len;
+  uint8_t  data[STM32_LINE_MAX + 2];  // ASCII satir + "\r\n" veya ikili cerceve
+};
+
+struct Stm32Model {
+  Stm32ModelLink  link;
+  Stm32ModelStats stats;
+  uint32_t        rng;
+  unsigned long   baud;
+  bool            binaryFrames;     // $AB1
+  unsigned long   streamPeriodMs;   // $AS (0 = kapali)
+  unsigned long   lastStreamMs;
+  unsigned long   lastStepMs;
+  uint64_t        txFreeUs;         // hat bu ana kadar mesgul
+
+  // Alim satiri
+  char     rxLine[STM32_LINE_MAX];
+  int      rxLen;
+  bool     rxOverflow;
+
+  // Cevap kuyrugu (halka, hatta cikis sirasiyla)
+  Stm32ModelReply replies[STM32_MODEL_REPLY_SLOTS];
+  int             replyHead;
+  int             replyCount;
+
+  // Sensorler
+  float    ntcC;             // NTC ortalamasi (C); dalga bunun uzerine eklenir
+  float    irC;
+  int      gesture;          // -1 = sirayla UP/DOWN/LEFT/RIGHT, 0..4 = sabit
+  uint8_t  statusFaults;     // STM32_MODEL_FAULT_* (zorlanan $X hatalari)
+
+  // Fanlar
+  int           fanDuty[STM32_MODEL_FANS];    // 0..1999
+  float         fanMaxRpm[STM32_MODEL_FANS];  // %100 duty'de oturdugu RPM (0 = olu fan)
+  float         fanRpm[STM32_MODEL_FANS];
+  unsigned long fanDutyMs[STM32_MODEL_FANS];
+
+  // Motorlar
+  Stm32ModelAxis axes[STM32_MODEL_AXES];
+
+  // Loadcell
+  float         cellLoad[STM32_MODEL_CELLS];    // uzerindeki gercek yuk (g)
+  float         cellOffset[STM32_MODEL_CELLS];  // tare edilmemis ofset (g)
+  float         tareZero[STM32_MODEL_CELLS];    // $WT anindaki ham okuma (yeni sifir)
+  unsigned long tareMs;
+  bool          tared;
+
+  // Cevapsiz komutlarin son durumu (senaryolar ve debug icin)
+  int      rgbH, rgbS, rgbV;
+  bool     brake;
+  bool     projectorOn;
+  int      projectorCurrent;
+  uint32_t configCount;  // $I
+};
+
+// Varsayilan durum: 25 C, fanlar durgun, motorlar hat ortasinda, loadcell tare edilmemis
+void stm32ModelBegin(Stm32Model &m, uint32_t seed = 1);
+
+// Ekseni [minPos, maxPos] hattina ve pos konumuna yerlestir
+void stm32ModelSetTravel(Stm32Model &m, int axis, long minPos, long maxPos, long pos);
+
+// ESP32'den gelen byte'lari isle (hat hatalari uygulanir); tamamlanan satirlar komuttur
+void stm32ModelReceive(Stm32Model &m, const uint8_t* data, size_t len, unsigned long nowMs);
+
+// Tek komut satirini dogrudan isle ("\r\n" haric; hat hatasi yok)
+void stm32ModelCommand(Stm32Model &m, const char* cmd, unsigned long nowMs);
+
+// Fiziksel durumu ilerlet, zamani gelen cevaplari ve akis satirlarini out'a yaz
+void stm32ModelPoll(Stm32Model &m, unsigned long nowMs, HalByteStream &out);
+
+// link'te bekleyen byte'lari al ve cevaplari ayni akisa yaz (her ms cagrilir)
+void stm32ModelService(Stm32Model &m, HalByteStream &link, unsigned long nowMs);
+
+// Anlik $A alanlari (protokol sirasi, ham x10 degerler)
+void stm32ModelSample(Stm32Model &m, unsigned long nowMs, int32_t (&values)[STM32_DATA_FIELDS]);
+
+// Anlik $X hata bitleri (STM32_MODEL_FAULT_*)
+uint8_t stm32ModelStatus(const Stm32Model &m, unsigned long nowMs);
+
+// Loadcell n'in (0..3) anlik okumasi (g)
+float stm32ModelLoadcell(Stm32Model &m, int cell, unsigned long nowMs);
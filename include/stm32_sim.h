@@ -0,0 +1,13 @@
+#pragma once
+
+// Donanimsiz test icin STM32 yerine gecen model (yalnizca -D STM32_SIM ile derlenir).
+// stm32_link giden komutlari Serial1 yerine stm32SimReceive()'e verir; cevaplar ve $AS akis
+// satirlari stm32SimPoll() icinde stm32LinkFeed() ile alim motoruna, gercek UART'tan
+// geliyormus gibi beslenir. Boylece OLED/encoder ile tum menu akisi STM32 olmadan denenebilir.
+// Davranis (gecikme, fan/motor/loadcell fizigi) stm32_model.h'dadir; host simulatoru ile aynidir.
+
+// Bir komut satirini isle ("\r\n" haric)
+void stm32SimReceive(const char* cmd);
+
+// Zamani gelen cevaplari ve akis satirlarini alim motoruna ver (stm32LinkService'ten)
+void stm32SimPoll();
@@ -0,0 +1,59 @@
+#pragma once
+
+#include <stdint.h>
+
+// STM32 $A telemetrisinin tek parca goruntusu
+// Alim tarafi (stm32_link cevap handler'i) alanlari kendi calisma kopyasina yazar ve tamamlanan
+// kareyi telemetryPublish() ile yayinlar. Okuyucular telemetryRead() ile her zaman tek bir
+// $A karesine ait tutarli bir kopya alir (ornegin 7 TMC stop biti hicbir zaman iki kareden
+// karisik gelmez). Yayin cift tamponludur: yazici kilit beklemez, okuyucu nadiren tekrar dener.
+// Tek yazici / cok okuyucu; yazici ve okuyucular farkli cekirdeklerde olabilir.
+
+struct TelemetrySnapshot {
+  uint32_t seq;          // yayin sirasi (1'den baslar, her yayinda +1; 0 = henuz veri yok)
+  uint32_t timestampMs;  // karenin alindigi an (millis)
+  uint8_t  fieldCount;   // karede gelen alan sayisi (eski STM32 yazilimi < 16 gonderir)
+  int      gesture;      // GESTURE_NONE..GESTURE_RIGHT (ham deger, dogrulanmamis)
+  // Okuyucu araya giren kareleri kacirsa bile gesture kaybolmasin: NONE olmayan son gesture
+  // ve o ana kadar gorulen NONE olmayan gesture karesi sayisi
+  int      lastGesture;
+  uint32_t gestureEvents;
+  float    mcuLoad;      // %  (/10 yapilmis)
+  float    pcbTemp;      // C
+  float    plateTemp;    // C (NTC)
+  float    resinTemp;    // C (IR)
+  float    intake1Rpm;
+  float    intake2Rpm;
+  float    exhaustRpm;
+  // TMC stop bitleri (1 = BASILI): Z_R, Y_R, Y_L, CVR1_R, CVR1_L, CVR2_R, CVR2_L
+  int      zStopR, yStopR, yStopL, cvr1StopR, cvr1StopL, cvr2StopR, cvr2StopL;
+  int      motorBusy;    // hareketi suren motorlar (STM32_MOTOR_BUSY_*; fieldCount >= 16 ise gecerli)
+};
+
+// Tamamlanan kareyi yayinla (seq burada atanir). Yalnizca alim tarafi cagirir.
+void telemetryPublish(const TelemetrySnapshot &frame);
+
+// Son yayinlanan karenin tutarli kopyasini al. Henuz yayin yoksa false.
+bool telemetryRead(TelemetrySnapshot &out);
+
+// lastSeq'den yeni bir kare varsa kopyala, lastSeq'i guncelle ve true dondur
+bool telemetryReadIfNew(TelemetrySnapshot &out, uint32_t &lastSeq);
+
+// Son yayinin sira numarasi (0 = henuz yok)
+uint32_t telemetrySequence();
+
+// Sayisal $A kanallari ($A alan sirasiyla). Ornekleyiciler (sample_accumulator.h) bir kanala
+// baglanir; yeni bir kanal icin yalnizca buraya ve telemetryChannelValue()'ya eklenir.
+enum TelemetryChannel {
+  TELEMETRY_MCU_LOAD = 0,
+  TELEMETRY_PCB_TEMP,
+  TELEMETRY_PLATE_TEMP,   // NTC
+  TELEMETRY_RESIN_TEMP,   // IR
+  TELEMETRY_INTAKE1_RPM,
+  TELEMETRY_INTAKE2_RPM,
+  TELEMETRY_EXHAUST_RPM,
+  TELEMETRY_CHANNEL_COUNT
+};
+
+// Kanal bu karede geldiyse degerini value'ya yaz ve true dondur (eski yazilim daha az alan gonderir)
+bool telemetryChannelValue(const TelemetrySnapshot &t, TelemetryChannel channel, float &value);
@@ -0,0 +1,119 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+// Bildirimsel test sekanslari
+// Bir test sabit (constexpr) bir adim tablosudur: komut gonder, bekle, telemetride bir kosulu
+// bekle, N deger ornekle, esik kontrol et, onceki adimlari tekrarla. Tablo TestRunner ile
+// bloklamadan yurutulur: testRunnerTick() her cagrida anlik adimlari (gonder, eylem, kontrol)
+// hemen isler, bekleme adimlarinda sure/kosul saglanana kadar doner. Ayni anda birden fazla
+// runner (farkli testler) calisabilir. Zamanlama ve iptal tek yerde: bu yorumlayici.
+
+enum TestStepKind {
+  TEST_STEP_SEND = 0,   // cmd'yi STM32'ye gonder (cevapsiz)
+  TEST_STEP_ACTION,     // action(arg) cagir; false donerse test FAIL (etiket: label)
+  TEST_STEP_PHASE,      // runner.phase = arg (ekranda faz gostermek icin)
+  TEST_STEP_WAIT,       // ms bekle
+  TEST_STEP_WAIT_UNTIL, // probe(arg) != 0 olana kadar bekle; ms icinde olmazsa FAIL
+  TEST_STEP_SAMPLE,     // probe(arg)'i count kez, ms aralikla ornekle (min/max/ortalama)
+  TEST_STEP_ASSERT,     // son ornekleme: lo <= min ve max <= hi olmali; degilse FAIL
+  TEST_STEP_REPEAT      // arg adim geri don, toplam count kez daha (ic ice tekrar yok)
+};
+
+typedef bool  (*TestAction)(int arg);
+typedef float (*TestProbe)(int arg);
+
+struct TestStep {
+  TestStepKind kind;
+  const char*  label;   // SEND: komut; diger adimlar: FAIL etiketi (nullptr olabilir)
+  TestAction   action;
+  TestProbe    probe;
+  int          arg;
+  uint16_t     count;
+  uint32_t     ms;
+  float        lo;
+  float        hi;
+};
+
+constexpr TestStep testSend(const char* cmd) {
+  return TestStep{ TEST_STEP_SEND, cmd, nullptr, nullptr, 0, 0, 0, 0.0f, 0.0f };
+}
+
+constexpr TestStep testAction(TestAction action, int arg = 0, const char* failLabel = nullptr) {
+  return TestStep{ TEST_STEP_ACTION, failLabel, action, nullptr, arg, 0, 0, 0.0f, 0.0f };
+}
+
+constexpr TestStep testPhase(int phase) {
+  return TestStep{ TEST_STEP_PHASE, nullptr, nullptr, nullptr, phase, 0, 0, 0.0f, 0.0f };
+}
+
+constexpr TestStep testWait(uint32_t ms) {
+  return TestStep{ TEST_STEP_WAIT, nullptr, nullptr, nullptr, 0, 0, ms, 0.0f, 0.0f };
+}
+
+constexpr TestStep testWaitUntil(TestProbe probe, int arg, uint32_t timeoutMs, const char* failLabel) {
+  return TestStep{ TEST_STEP_WAIT_UNTIL, failLabel, nullptr, probe, arg, 0, timeoutMs, 0.0f, 0.0f };
+}
+
+constexpr TestStep testSample(TestProbe probe, int arg, uint16_t count, uint32_t intervalMs) {
+  return TestStep{ TEST_STEP_SAMPLE, nullptr, nullptr, probe, arg, count, intervalMs, 0.0f, 0.0f };
+}
+
+constexpr TestStep testAssert(float lo, float hi, const char* failLabel) {
+  return TestStep{ TEST_STEP_ASSERT, failLabel, nullptr, nullptr, 0, 0, 0, lo, hi };
+}
+
+constexpr TestStep testRepeat(int stepsBack, uint16_t times) {
+  return TestStep{ TEST_STEP_REPEAT, nullptr, nullptr, nullptr, stepsBack, times, 0, 0.0f, 0.0f };
+}
+
+enum TestRunState {
+  TEST_RUN_IDLE = 0,
+  TEST_RUN_BUSY,
+  TEST_RUN_PASS,
+  TEST_RUN_FAIL,
+  TEST_RUN_ABORTED
+};
+
+struct TestRunner {
+  const TestStep* steps;
+  int             stepCount;
+  int             index;          // yurutulen adim
+  TestRunState    state;
+  int             phase;          // son TEST_STEP_PHASE degeri
+  const char*     failLabel;      // FAIL olan adimin etiketi
+  unsigned long   stepStartMs;
+  int             repeatStep;     // tekrar sayaci hangi REPEAT adimina ait (-1 = yok)
+  uint16_t        repeatLeft;
+  // Son ornekleme (bir sonraki SAMPLE adimi baslayana kadar okunabilir)
+  int             sampleStep;     // ornekleme suren SAMPLE adimi (-1 = yok)
+  uint16_t        sampleCount;
+  unsigned long   lastSampleMs;
+  float           sampleMin;
+  float           sampleMax;
+  float           sampleSum;
+};
+
+// Tabloyu bastan baslat (ilk anlik adimlar bir sonraki tick'te calisir)
+void testRunnerStart(TestRunner &r, const TestStep* steps, int stepCount);
+
+template <size_t N>
+void testRunnerStart(TestRunner &r, const TestStep (&steps)[N]) {
+  testRunnerStart(r, steps, (int)N);
+}
+
+// Adimlari ilerlet. Test bu cagrida bittiyse (PASS/FAIL) true doner.
+bool testRunnerTick(TestRunner &r, unsigned long now);
+
+// Calisan testi durdur (state = TEST_RUN_ABORTED); temizlik cagirana aittir
+void testRunnerAbort(TestRunner &r);
+
+inline bool testRunnerBusy(const TestRunner &r) {
+  return r.state == TEST_RUN_BUSY;
+}
+
+// Son orneklemenin ortalamasi (ornek yoksa 0)
+inline float testRunnerSampleMean(const TestRunner &r) {
+  return r.sampleCount > 0 ? r.sampleSum / r.sampleCount : 0.0f;
+}
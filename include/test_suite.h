@@ -0,0 +1,67 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+// Toplu test kosusu ("Tumunu Test Et")
+// Her test bir giristir: baslat / calisiyor mu / gecti mi / iptal fonksiyonlari ve testin
+// kullandigi ortak donanimin (eksen, sensor konfigu, ortak durum kaydi...) bit maskesi.
+// testSuiteTick() bekleyen testleri tablo sirasiyla, kaynaklari bos oldugunda baslatir; ayri
+// donanima dokunan testler ayni anda, ortak kaynagi kullananlar sirayla calisir. Kaynagi
+// mesgul oldugu icin bekleyen bir testin kaynaklari, tabloda ondan sonra gelenlere de
+// kapalidir (sira atlanmaz). Testlerin kendisi kendi update fonksiyonlariyla ilerler.
+
+#define TEST_SUITE_MAX_ENTRIES 16
+
+struct TestSuiteEntry {
+  const char* name;       // ozet ekranindaki kisa ad
+  uint32_t    resources;  // kilitledigi kaynaklar (0: kilitsiz)
+  void (*start)();
+  bool (*busy)();
+  bool (*passed)();       // test bittikten sonra sonuc
+  void (*abort)();
+};
+
+enum TestSuiteResult {
+  TEST_SUITE_PENDING = 0,
+  TEST_SUITE_RUNNING,
+  TEST_SUITE_PASS,
+  TEST_SUITE_FAIL,
+  TEST_SUITE_ABORTED
+};
+
+struct TestSuite {
+  const TestSuiteEntry* entries;
+  int                   entryCount;
+  TestSuiteResult       results[TEST_SUITE_MAX_ENTRIES];
+  unsigned long         durationMs[TEST_SUITE_MAX_ENTRIES];  // calisirken: baslangic zamani
+  uint32_t              lockedResources;
+  bool                  running;
+  unsigned long         startMs;
+  unsigned long         endMs;
+};
+
+// Tum girisleri bekleyen olarak isaretle (ilk testler bir sonraki tick'te baslar)
+void testSuiteStart(TestSuite &s, const TestSuiteEntry* entries, int entryCount, unsigned long now);
+
+template <size_t N>
+void testSuiteStart(TestSuite &s, const TestSuiteEntry (&entries)[N], unsigned long now) {
+  testSuiteStart(s, entries, (int)N, now);
+}
+
+// Biten testleri topla, kaynagi bos olanlari baslat. Kosu bu cagrida bittiyse true doner.
+bool testSuiteTick(TestSuite &s, unsigned long now);
+
+// Calisan testleri iptal et, bekleyenleri atla
+void testSuiteAbort(TestSuite &s, unsigned long now);
+
+int testSuiteCount(const TestSuite &s, TestSuiteResult result);
+
+inline bool testSuiteBusy(const TestSuite &s) {
+  return s.running;
+}
+
+// Gecen sure: kosu suruyorsa simdiye kadar, bittiyse toplam
+inline unsigned long testSuiteElapsedMs(const TestSuite &s, unsigned long now) {
+  return (s.running ? now : s.endMs) - s.startMs;
+}
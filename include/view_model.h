@@ -0,0 +1,26 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+// Ekran gorunum modelleri (view model)
+// Her ekran cizdigi degerleri kucuk bir struct'ta toplar: secili satir, test durumu, ekranda
+// gorunen sayilar (ekrandaki hassasiyetle: 0.1 C, tam RPM, saniye...). drawCurrentScreen() bu
+// struct'in ozetini (FNV-1a) son cizilen ozetle karsilastirir; degismediyse ekran cizilmez.
+// Struct once viewModelClear() ile sifirlanir, boylece dolgu baytlari ozeti bozmaz.
+
+#define VIEW_HASH_SEED 2166136261u
+
+// FNV-1a: onceki ozete data'yi ekle
+uint32_t viewHashBytes(uint32_t hash, const void* data, size_t len);
+
+template <typename T>
+inline void viewModelClear(T &model) {
+  memset(&model, 0, sizeof(model));
+}
+
+template <typename T>
+inline uint32_t viewModelHash(const T &model) {
+  return viewHashBytes(VIEW_HASH_SEED, &model, sizeof(model));
+}
@@ -0,0 +1,234 @@
+#ifndef ARDUINO
+
+// Host ([env:native]) Arduino / FreeRTOS / GFX alt kumesinin uygulamasi (include/host/)
+
+#include <deque>
+#include <vector>
+
+#include <Arduino.h>
+#include <Adafruit_SSD1306.h>
+#include <Wire.h>
+
+#include "freertos/queue.h"
+#include "freertos/task.h"
+#include "hal_host.h"
+
+// --- Zaman ---
+void delay(unsigned long ms) {
+  hostClock().delay(ms);
+}
+
+// --- Print / Serial ---
+size_t Print::print(long v, int base) {
+  char buf[40];
+  if (base == 16) snprintf(buf, sizeof(buf), "%lX", (unsigned long)v);
+  else snprintf(buf, sizeof(buf), "%ld", v);
+  return write(buf);
+}
+
+size_t Print::print(unsigned long v, int base) {
+  char buf[40];
+  if (base == 16) snprintf(buf, sizeof(buf), "%lX", v);
+  else snprintf(buf, sizeof(buf), "%lu", v);
+  return write(buf);
+}
+
+size_t Print::print(double v, int digits) {
+  char buf[48];
+  snprintf(buf, sizeof(buf), "%.*f", digits, v);
+  return write(buf);
+}
+
+size_t Print::printf(const char* format, ...) {
+  char buf[256];
+  va_list args;
+  va_start(args, format);
+  int n = vsnprintf(buf, sizeof(buf), format, args);
+  va_end(args);
+  if (n <= 0) return 0;
+  return write((const uint8_t*)buf, (size_t)n < sizeof(buf) ? (size_t)n : sizeof(buf) - 1);
+}
+
+static bool serialEcho = false;
+
+void hostSerialEcho(bool on) {
+  serialEcho = on;
+}
+
+int HardwareSerial::available() {
+  return port == 1 ? halStm32Stream().available() : 0;
+}
+
+int HardwareSerial::read() {
+  uint8_t c;
+  if (port != 1 || halStm32Stream().read(&c, 1) != 1) return -1;
+  return c;
+}
+
+size_t HardwareSerial::write(const uint8_t* data, size_t len) {
+  if (port == 1) return halStm32Stream().write(data, len);
+  if (serialEcho) fwrite(data, 1, len, stdout);
+  return len;
+}
+
+HardwareSerial Serial(0);
+HardwareSerial Serial1(1);
+TwoWire Wire;
+
+// --- GFX ---
+Adafruit_GFX::Adafruit_GFX(int16_t w, int16_t h)
+  : WIDTH(w), HEIGHT(h), cursorX(0), cursorY(0), textSize(1), textColor(1), textBg(1) {}
+
+void Adafruit_GFX::drawLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint16_t color) {
+  // Bresenham
+  int dx = abs(x1 - x0), sx = x0 < x1 ? 1 : -1;
+  int dy = -abs(y1 - y0), sy = y0 < y1 ? 1 : -1;
+  int err = dx + dy;
+  while (true) {
+    drawPixel(x0, y0, color);
+    if (x0 == x1 && y0 == y1) break;
+    int e2 = 2 * err;
+    if (e2 >= dy) { err += dy; x0 += sx; }
+    if (e2 <= dx) { err += dx; y0 += sy; }
+  }
+}
+
+void Adafruit_GFX::drawRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) {
+  if (w <= 0 || h <= 0) return;
+  drawLine(x, y, x + w - 1, y, color);
+  drawLine(x, y + h - 1, x + w - 1, y + h - 1, color);
+  drawLine(x, y, x, y + h - 1, color);
+  drawLine(x + w - 1, y, x + w - 1, y + h - 1, color);
+}
+
+void Adafruit_GFX::fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) {
+  for (int16_t j = 0; j < h; j++) {
+    for (int16_t i = 0; i < w; i++) drawPixel(x + i, y + j, color);
+  }
+}
+
+// Karakter koduna gore 5 sutunluk 7 bitlik desen (bosluk bos)
+static uint8_t glyphColumn(uint8_t c, int col) {
+  if (c == ' ') return 0;
+  uint32_t h = (uint32_t)c * 2654435761u;
+  return (uint8_t)(((h >> (col * 5)) | 0x41) & 0x7F);
+}
+
+size_t Adafruit_GFX::write(uint8_t c) {
+  if (c == '\n') {
+    cursorX = 0;
+    cursorY += 8 * textSize;
+    return 1;
+  }
+  if (c == '\r') return 1;
+  for (int col = 0; col < 6; col++) {
+    uint8_t bits = col < 5 ? glyphColumn(c, col) : 0;
+    for (int row = 0; row < 8; row++) {
+      bool on = (bits >> row) & 1;
+      if (!on && textBg == textColor) continue;  // seffaf arka plan
+      fillRect(cursorX + col * textSize, cursorY + row * textSize, textSize, textSize,
+               on ? textColor : textBg);
+    }
+  }
+  cursorX += 6 * textSize;
+  return 1;
+}
+
+void Adafruit_GFX::getTextBounds(const char* s, int16_t x, int16_t y, int16_t* x1, int16_t* y1,
+                                 uint16_t* w, uint16_t* h) {
+  *x1 = x;
+  *y1 = y;
+  *w = (uint16_t)(strlen(s) * 6 * textSize);
+  *h = (uint16_t)(8 * textSize);
+}
+
+// --- SSD1306 ---
+Adafruit_SSD1306::Adafruit_SSD1306(uint8_t w, uint8_t h, TwoWire* twi, int8_t)
+  : Adafruit_GFX(w, h), wire(twi), i2cAddress(0), buffer(nullptr) {}
+
+Adafruit_SSD1306::~Adafruit_SSD1306() {
+  free(buffer);
+}
+
+bool Adafruit_SSD1306::begin(uint8_t, uint8_t addr, bool, bool periphBegin) {
+  if (buffer == nullptr) buffer = (uint8_t*)malloc(WIDTH * ((HEIGHT + 7) / 8));
+  if (buffer == nullptr) return false;
+  i2cAddress = addr;
+  if (periphBegin) wire->begin();
+  clearDisplay();
+  return true;
+}
+
+void Adafruit_SSD1306::clearDisplay() {
+  if (buffer) memset(buffer, 0, WIDTH * ((HEIGHT + 7) / 8));
+}
+
+void Adafruit_SSD1306::drawPixel(int16_t x, int16_t y, uint16_t color) {
+  if (buffer == nullptr || x < 0 || y < 0 || x >= WIDTH || y >= HEIGHT) return;
+  uint8_t &b = buffer[x + (y / 8) * WIDTH];
+  uint8_t bit = (uint8_t)(1 << (y & 7));
+  if (color == SSD1306_WHITE) b |= bit;
+  else if (color == SSD1306_INVERSE) b ^= bit;
+  else b &= (uint8_t)~bit;
+}
+
+void Adafruit_SSD1306::display() {
+  if (buffer == nullptr) return;
+  wire->beginTransmission(i2cAddress);
+  wire->write(buffer, WIDTH * ((HEIGHT + 7) / 8));
+  wire->endTransmission();
+}
+
+// --- FreeRTOS ---
+struct HostQueue {
+  UBaseType_t                       length;
+  UBaseType_t                       itemSize;
+  std::deque<std::vector<uint8_t> > items;
+};
+
+QueueHandle_t xQueueCreate(UBaseType_t length, UBaseType_t itemSize) {
+  HostQueue* q = new HostQueue();
+  q->length = length;
+  q->itemSize = itemSize;
+  return q;
+}
+
+BaseType_t xQueueSend(QueueHandle_t q, const void* item, TickType_t wait) {
+  if (q->items.size() >= q->length && wait == 0) return pdFALSE;
+  const uint8_t* p = (const uint8_t*)item;
+  q->items.push_back(std::vector<uint8_t>(p, p + q->itemSize));
+  return pdTRUE;
+}
+
+BaseType_t xQueueReceive(QueueHandle_t q, void* item, TickType_t) {
+  if (q->items.empty()) return pdFALSE;
+  memcpy(item, q->items.front().data(), q->itemSize);
+  q->items.pop_front();
+  return pdTRUE;
+}
+
+BaseType_t xQueuePeek(QueueHandle_t q, void* item, TickType_t) {
+  if (q->items.empty()) return pdFALSE;
+  memcpy(item, q->items.front().data(), q->itemSize);
+  return pdTRUE;
+}
+
+UBaseType_t uxQueueMessagesWaiting(QueueHandle_t q) {
+  return (UBaseType_t)q->items.size();
+}
+
+TaskHandle_t xTaskGetCurrentTaskHandle() {
+  static int task;
+  return &task;
+}
+
+BaseType_t xTaskNotifyGive(TaskHandle_t) {
+  halWakeFromISR();
+  return pdPASS;
+}
+
+void vTaskDelay(TickType_t ticks) {
+  delay(ticks);
+}
+
+#endif  // !ARDUINO
@@ -0,0 +1,45 @@
+#include <string.h>
+
+#include "frame_diff.h"
+
+void frameDiffBegin(FrameDiff &d, uint8_t width, uint8_t height) {
+  d.width = width;
+  d.pages = height / 8;
+  if (d.width * d.pages > FRAME_DIFF_MAX_BUFFER) d.pages = FRAME_DIFF_MAX_BUFFER / d.width;
+  d.shadowValid = false;
+  d.flushes = 0;
+  d.sentBytes = 0;
+  d.skippedBytes = 0;
+}
+
+uint32_t frameDiffFlush(FrameDiff &d, const uint8_t* buffer, HalFrameSink &sink) {
+  uint32_t sentBefore = d.sentBytes;
+  for (uint8_t page = 0; page < d.pages; page++) {
+    const uint8_t* row = buffer + page * d.width;
+    uint8_t*       old = d.shadow + page * d.width;
+    int col = 0;
+    while (col < d.width) {
+      // Sonraki farkli sutun
+      if (d.shadowValid) {
+        while (col < d.width && row[col] == old[col]) col++;
+        if (col >= d.width) break;
+      }
+      // Araligi, aradaki esit bosluk FRAME_DIFF_MERGE_GAP'ten kisa oldugu surece uzat
+      int start = col;
+      int last = col;
+      for (int c = col + 1; c < d.width && c - last <= FRAME_DIFF_MERGE_GAP; c++) {
+        if (!d.shadowValid || row[c] != old[c]) last = c;
+      }
+      sink.writeSpan(page, (uint8_t)start, (uint8_t)last, row + start);
+      memcpy(old + start, row + start, last - start + 1);
+      d.sentBytes += last - start + 1;
+      col = last + 1;
+    }
+  }
+
+  d.shadowValid = true;
+  d.flushes++;
+  uint32_t sent = d.sentBytes - sentBefore;
+  d.skippedBytes += (uint32_t)d.width * d.pages - sent;
+  return sent;
+}
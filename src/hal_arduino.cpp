@@ -0,0 +1,96 @@
+#ifdef ARDUINO
+
+#include <Arduino.h>
+#include <atomic>
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+
+#include "hal.h"
+
+// --- Saat: millis/micros, uyku = task notification beklemesi ---
+static TaskHandle_t wakeTask = nullptr;
+
+class ArduinoClock : public HalClock {
+public:
+  unsigned long millis() override { return ::millis(); }
+  unsigned long micros() override { return ::micros(); }
+  void begin() override { wakeTask = xTaskGetCurrentTaskHandle(); }
+  void sleep(unsigned long ms) override { ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(ms)); }
+  void wake() override {
+    if (wakeTask != nullptr) xTaskNotifyGive(wakeTask);
+  }
+};
+
+void IRAM_ATTR halWakeFromISR() {
+  if (wakeTask == nullptr) return;
+  BaseType_t woken = pdFALSE;
+  vTaskNotifyGiveFromISR(wakeTask, &woken);
+  if (woken) portYIELD_FROM_ISR();
+}
+
+// --- STM32 UART: Serial1 ---
+class Serial1Stream : public HalByteStream {
+public:
+  int available() override { return Serial1.available(); }
+  size_t read(uint8_t* buf, size_t len) override { return Serial1.read(buf, len); }
+  size_t write(const uint8_t* data, size_t len) override { return Serial1.write(data, len); }
+};
+
+// --- Encoder / buton ---
+static int              encoderClkPin = -1;
+static int              encoderDtPin = -1;
+static int              buttonPin = -1;
+static int              lastCLK = 0;
+static std::atomic<int> encoderSteps(0);
+
+static void IRAM_ATTR encoderISR() {
+  int CLK = digitalRead(encoderClkPin);
+  int DT = digitalRead(encoderDtPin);
+
+  if (CLK != lastCLK) {
+    encoderSteps.fetch_add(DT != CLK ? 1 : -1, std::memory_order_relaxed);
+    lastCLK = CLK;
+  }
+  halWakeFromISR();
+}
+
+// Buton kesmesi: yalnizca loop()'u uyandirir, durum buttonDown() ile okunur
+static void IRAM_ATTR buttonISR() {
+  halWakeFromISR();
+}
+
+class ArduinoInput : public HalInput {
+public:
+  int takeEncoderSteps() override { return encoderSteps.exchange(0, std::memory_order_relaxed); }
+  bool buttonDown() override { return buttonPin >= 0 && digitalRead(buttonPin) == LOW; }
+};
+
+void halArduinoInputBegin(int clkPin, int dtPin, int swPin) {
+  encoderClkPin = clkPin;
+  encoderDtPin = dtPin;
+  buttonPin = swPin;
+  pinMode(clkPin, INPUT_PULLUP);
+  pinMode(dtPin, INPUT_PULLUP);
+  pinMode(swPin, INPUT_PULLUP);
+  lastCLK = digitalRead(clkPin);
+  attachInterrupt(digitalPinToInterrupt(clkPin), encoderISR, CHANGE);
+  attachInterrupt(digitalPinToInterrupt(swPin), buttonISR, CHANGE);
+}
+
+// --- Etkin uygulamalar ---
+static ArduinoClock   arduinoClock;
+static Serial1Stream  serial1Stream;
+static ArduinoInput   arduinoInput;
+static HalClock*      activeClock = &arduinoClock;
+static HalByteStream* activeStream = &serial1Stream;
+static HalInput*      activeInput = &arduinoInput;
+
+HalClock& halClock() { return *activeClock; }
+HalByteStream& halStm32Stream() { return *activeStream; }
+HalInput& halInput() { return *activeInput; }
+
+void halSetClock(HalClock* clock) { activeClock = clock ? clock : &arduinoClock; }
+void halSetStm32Stream(HalByteStream* stream) { activeStream = stream ? stream : &serial1Stream; }
+void halSetInput(HalInput* input) { activeInput = input ? input : &arduinoInput; }
+
+#endif  // ARDUINO
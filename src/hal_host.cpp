@@ -0,0 +1,126 @@
+#ifndef ARDUINO
+
+#include <string.h>
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/ioctl.h>
+#include <termios.h>
+#include <unistd.h>
+#endif
+
+#include "hal_host.h"
+
+void FakeClock::sleep(unsigned long ms) {
+  for (unsigned long i = 0; i < ms && !wakePending; i++) {
+    nowUs += 1000;
+    sleptUs += 1000;
+    if (tickHook != nullptr) tickHook(millis(), tickCtx);
+  }
+  wakePending = false;
+}
+
+void FakeClock::advanceUs(uint64_t us) {
+  // Ms sinirlarinda kancayi cagir (kismi ms'ler birikir)
+  uint64_t end = nowUs + us;
+  while (nowUs / 1000 < end / 1000) {
+    nowUs = (nowUs / 1000 + 1) * 1000;
+    if (tickHook != nullptr) tickHook(millis(), tickCtx);
+  }
+  nowUs = end;
+}
+
+size_t HostStreamEnd::read(uint8_t* buf, size_t len) {
+  size_t n = 0;
+  while (n < len && !rx.bytes.empty()) {
+    buf[n++] = rx.bytes.front();
+    rx.bytes.pop_front();
+  }
+  return n;
+}
+
+size_t HostStreamEnd::write(const uint8_t* data, size_t len) {
+  tx.bytes.insert(tx.bytes.end(), data, data + len);
+  tx.totalBytes += len;
+  return len;
+}
+
+void HostFrameRecorder::writeSpan(uint8_t page, uint8_t col0, uint8_t col1, const uint8_t* data) {
+  int offset = page * width + col0;
+  int count = col1 - col0 + 1;
+  if (offset < 0 || offset + count > (int)sizeof(panel)) return;
+  memcpy(panel + offset, data, count);
+  spans++;
+  bytes += count;
+}
+
+#if defined(__unix__) || defined(__APPLE__)
+int HostFdStream::available() {
+  int n = 0;
+  if (ioctl(fd, FIONREAD, &n) < 0) return 0;
+  return n;
+}
+
+size_t HostFdStream::read(uint8_t* buf, size_t len) {
+  ssize_t n = ::read(fd, buf, len);
+  return n > 0 ? (size_t)n : 0;
+}
+
+size_t HostFdStream::write(const uint8_t* data, size_t len) {
+  ssize_t n = ::write(fd, data, len);
+  return n > 0 ? (size_t)n : 0;
+}
+
+int hostOpenPty(char* name, size_t nameLen) {
+  int fd = posix_openpt(O_RDWR | O_NOCTTY);
+  if (fd < 0) return -1;
+  if (grantpt(fd) != 0 || unlockpt(fd) != 0 || ptsname(fd) == nullptr) {
+    close(fd);
+    return -1;
+  }
+  snprintf(name, nameLen, "%s", ptsname(fd));
+  // Ham mod: satir duzenleme, echo ve CR/LF donusumu yok (protokol byte'lari aynen gecer)
+  struct termios tio;
+  if (tcgetattr(fd, &tio) == 0) {
+    cfmakeraw(&tio);
+    tcsetattr(fd, TCSANOW, &tio);
+  }
+  fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK);
+  return fd;
+}
+#endif
+
+// --- Etkin uygulamalar ---
+FakeClock& hostClock() {
+  static FakeClock clock;
+  return clock;
+}
+
+HostStreamPair& hostStm32Link() {
+  static HostStreamPair link;
+  return link;
+}
+
+HostScriptedInput& hostInput() {
+  static HostScriptedInput input;
+  return input;
+}
+
+static HalClock*      activeClock = nullptr;
+static HalByteStream* activeStream = nullptr;
+static HalInput*      activeInput = nullptr;
+
+HalClock& halClock() { return activeClock ? *activeClock : hostClock(); }
+HalByteStream& halStm32Stream() { return activeStream ? *activeStream : hostStm32Link().firmware; }
+HalInput& halInput() { return activeInput ? *activeInput : hostInput(); }
+
+void halSetClock(HalClock* clock) { activeClock = clock; }
+void halSetStm32Stream(HalByteStream* stream) { activeStream = stream; }
+void halSetInput(HalInput* input) { activeInput = input; }
+
+void halWakeFromISR() {
+  halClock().wake();
+}
+
+#endif  // !ARDUINO
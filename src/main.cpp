@@ -1,35 +1,62 @@
 #include <Arduino.h>
+#include <stdarg.h>
+#include <float.h>
 #include <Wire.h>
 #include <Adafruit_SSD1306.h>
 #include <Adafruit_GFX.h>
 
+#include "scheduler.h"
+#include "stm32_fields.h"
+#include "stm32_link.h"
+#include "telemetry.h"
+#include "test_sequence.h"
+#include "test_suite.h"
+#include "steady_state.h"
+#include "sample_accumulator.h"
+#include "oled_display.h"
+#include "run_all.h"
+#include "stm32_decode.h"
+#include "view_model.h"
+#include "hal.h"
+#include "profiler.h"
+
 // Adafruit HUZZAH32 ESP32 Feather - D16 (RX), D17 (TX)
 // STM32 TX -> Feather D16 (RX, GPIO 16)  |  STM32 RX -> Feather D17 (TX, GPIO 17)  |  GND ortak
 // Docklight ile ayni: 115200, 8N1.
 #define UART_RX 16
 #define UART_TX 17
-#define UART_BAUD 115200
+#define UART_BAUD 115200          // Acilis hizi (STM32 resetten sonra her zaman bu hizda)
+#define UART_BAUD_NEGOTIATE_MS 100 // $U onayi / dogrulama cevaplari icin bekleme
+// Acilista sirayla denenen yuksek hizlar ($U); hicbiri dogrulanamazsa UART_BAUD ile devam
+static const unsigned long uartFastBauds[] = { 921600, 460800 };
 
 // --- ESP32 tarafi gecikme suresi (hesaplanan) ---
-// Sorgu araligi: READ_INTERVAL_MS (her bu kadar ms'de bir $A gonderilir)
-// readSTM32Data icinde: READ_DELAY_MS (komut sonrasi bekleme) + cevap gelene kadar (max READ_TIMEOUT_MS)
-// Loop her tur: LOOP_DELAY_MS
+// Akis modu ($AS): STM32 $A satirini istek beklemeden readInterval aralikla kendisi gonderir;
+// satir arka planda birlestirilir (stm32_link) ve loop() her turda pollSTM32Link() ile isler.
+// STM32 akisi desteklemiyorsa polling: readSTM32Data her readInterval'da $A gonderir.
+// loop() sabit gecikme yerine bir sonraki is zamanina kadar uyur (scheduler); STM32 cevabi
+// veya encoder/buton kesmesi uykuyu hemen bitirir.
 //
 // Toplam ESP32 gecikmesi (ortalama):
-//   ~ (READ_INTERVAL_MS/2) + READ_DELAY_MS + (cevap byte suresi ~3-5ms)  =>  yaklasik 25+10+4 = ~40ms
-// En kotu (bir onceki okumadan hemen sonra veri uretildiyse):  ~ READ_INTERVAL_MS + READ_DELAY_MS + 50 = ~110ms
-#define READ_INTERVAL_MS   50   // Kac ms'de bir sensör verisi istenir (saniyede 20 istek)
-#define GESTURE_READ_MS    20   // Gesture ekranindayken daha sik oku (saniyede ~50 istek)
-#define READ_DELAY_MS      12   // $A gonderdikten sonra STM32 cevabi icin bekleme (ms)
+//   Akis:    ~ (READ_INTERVAL_MS/2) + (satir byte suresi ~5ms)  =>  ~30ms
+//            (gesture ekraninda 10 + 5 = ~15ms, istek yonu bant genisligi harcanmaz)
+//   Polling: ~ (READ_INTERVAL_MS/2) + (istek + cevap ~5-6ms)  =>  yaklasik 25+6 = ~31ms
+// En kotu (bir onceki okumadan hemen sonra veri uretildiyse):  ~ READ_INTERVAL_MS + 10 = ~60ms
+#define READ_INTERVAL_MS   50   // Kac ms'de bir sensör verisi istenir / akis periyodu (saniyede 20)
+#define GESTURE_READ_MS    20   // Gesture ekranindayken daha sik oku (saniyede ~50)
+#define GESTURE_READ_BIN_MS 10  // Ikili cercevede (20 byte, ~1.7ms) gesture icin saniyede ~100
+#define BINARY_NEGOTIATE_MS 100 // $AB1 onayi icin bekleme; gelmezse ASCII $A ile devam
 #define READ_TIMEOUT_MS    150  // Cevap gelmezse en fazla bu kadar ms bekle (timeout)
-#define LOOP_DELAY_MS      5    // Her loop sonu bekleme (ms)
 #define BUTTON_DEBOUNCE_MS 450  // Buton basimlari arasi min sure (ms)
+#define BUTTON_SETTLE_MS   25   // Basim, buton bu kadar kesintisiz basili kalinca kabul edilir (donanim debounce)
 // Z ekseni icin 1 tur mikrostep sayisi (STM32 Z mapping farkli oldugu icin ayrica kalibre edilir)
 #define Z_MOTOR_TURN_STEPS 2000
 #define SENSOR_STATUS_REFRESH_MS 100   // NTC/IR baglanti durumunu periyodik yenileme (ms)
-#define GESTURE_LOOP_DELAY_MS 2 // Gesture ekranindayken daha hizli dongu
+#define TEST_TICK_MS       10   // Fan test adimlari ve NTC/IR timeout kontrol araligi (ms)
 #define SCREEN_UPDATE_MS   50   // OLED yenileme araligi (ms)
 #define GESTURE_SCREEN_MS  30   // Gesture ekraninda daha sik yenile
+#define CONSOLE_POLL_MS    50   // Serial debug konsolu satir yoklama araligi (ms)
+#define CONSOLE_LINE_MAX   32   // Konsol komut satiri (fazlasi kesilir)
 // NTC test ozel parametreleri
 #define NTC_SAMPLE_COUNT        20   // NTC testi icin alinacak olcum sayisi
 #define NTC_SAMPLE_INTERVAL_MS  100  // NTC testi sirasinda olcumler arasi bekleme (ms)
@@ -42,23 +69,55 @@
 #define IR_TEST_TIMEOUT_MS       5000  // IR testi max sure (ms), asilirsa FAIL
 #define IR_STABILITY_DELTA_C       4.0f // IR testi icin max sapma (IR gurultulu olabilir, NTC'den gevsek)
 #define IR_STEP_DELTA_C            1.0f // Iki ardil olcum arasi max fark (C)
+// NTC/IR ardisik (erken karar) modu: sabit sayi yerine ortalama/varyans yeterince kesinlesince
+// biter (esikler: sample_accumulator.h SAMPLE_SEQ_*)
+#define TEMP_TEST_DEFAULT_MODE   TEMP_TEST_FIXED // Acilista secili mod (ekrandan degistirilir)
 #define INTAKE_FAN_SPINUP_MS     5000  // Intake fan komutu sonrasi hata kontrolu icin bekleme
 #define EXHAUST_FAN_SPINUP_MS    5000  // Exhaust fan komutu sonrasi hata kontrolu icin bekleme
 #define FAN_TEST_STEP_MS          400  // Fan testinde hiz kademeleri arasi bekleme
-#define FAN_TEST_SETTLE_MS       1500  // %100'de RPM olcumu oncesi bekleme
+#define FAN_TEST_SETTLE_MAX_MS   3000  // %100'de RPM oturmasi icin ust sinir (oturursa erken karar)
 #define FAN_TEST_MIN_RPM       2500.0f // Test gecmek icin minimum RPM
+#define FAN_SETTLE_WINDOW           6  // Oturma penceresi ($A karesi; 6 x READ_INTERVAL_MS)
+#define FAN_SETTLE_MAX_SLOPE    50.0f  // RPM/s: pencere egimi bunun altindaysa RPM oturmus
+#define FAN_SETTLE_MAX_STDDEV   60.0f  // RPM: pencere standart sapmasi icin ust sinir
 #define LOADCELL_UPDATE_MS         500  // Loadcell sonuc ekraninda yenileme araligi (ms)
 #define LOADCELL_TARE_WAIT_MS    7000  // $WT gonderildikten sonra makul degerler icin max bekleme suresi (ms)
 #define LOADCELL_POST_TARE_READY_G 15.0f // Sonuc ekranina gecmeden once kabul edilen max mutlak deger
 #define LOADCELL_POST_TARE_RETRY_DELAY_MS 300 // TARE sonrasi tekrar okumalar arasi bekleme
 #define LOADCELL_VALIDATE_ROUNDS     5   // Sonuc ekrani oncesi ek dogrulama turu
-
-// OLED Ekran - 128x64, I2C
+#define LOADCELL_CONFIG_MS         500  // $I sonrasi $X oncesi bekleme
+#define LOADCELL_RETRY_MS          300  // Ilk deneme basarisizsa ikinci deneme oncesi bekleme
+#define BRAKE_TEST_CYCLES            5   // Motor freni testi ac/kapa sayisi
+#define BRAKE_TEST_PHASE_MS       1000  // Fren acik / kapali kalma suresi
+#define RGB_TEST_COLOR_MS         1000  // RGB testinde her rengin suresi
+#define RGB_TEST_RAINBOW_MS       5000  // Rainbow gecisi toplam suresi
+#define RGB_TEST_RAINBOW_STEP_MS    80  // Rainbow gecisinde hue guncelleme araligi
+#define MOTOR_TEST_STOP_MS         100  // Motor testi basinda stop sonrasi bekleme
+#define MOTOR_TEST_ENABLE_MS       150  // Enable sonrasi ilk hareket oncesi bekleme
+#define MOTOR_TEST_MARGIN_MS       300  // Z/Y tahmini hareket suresine eklenen pay
+#define CVR_MOTOR_TEST_MARGIN_MS   500  // CVR 1-2 (uzun hareket) tahmini sureye eklenen pay
+#define MOTOR_BUSY_LATENCY_MS       40  // Hareket komutunun $A mesgul bitine yansimasi icin pay
+#define MOTOR_MOVE_TIMEOUT_MS     1000  // Mesgul biti temizlenmezse: 2 x tahmini sure + bu kadar
+#define PROJECTOR_TEST_OFF_MS      500  // Projeksiyon testi: $PF sonrasi $I oncesi bekleme
+#define PROJECTOR_TEST_CONFIG_MS    40  // $I sonrasi $X oncesi bekleme
+#define GESTURE_INIT_SETTLE_MS      40  // Gesture $I sonrasi STM32 hazir olana kadar ($A / $X oncesi)
+#define TEST_STATUS_REPLY_MS (READ_TIMEOUT_MS + 100)  // Test adimlarinda $X cevabi (veya link zaman asimi) icin ust sinir
+
+// "Tumunu Test Et" kaynaklari: ayni kaynagi kullanan testler sirayla, digerleri ayni anda calisir
+#define TEST_RES_Z_AXIS        (1 << 0)  // Z motoru, motor freni ve loadcell (TARE sirasinda Z sabit)
+#define TEST_RES_Y_AXIS        (1 << 1)
+#define TEST_RES_CVR_AXIS      (1 << 2)
+#define TEST_RES_INTAKE_FAN    (1 << 3)
+#define TEST_RES_EXHAUST_FAN   (1 << 4)
+#define TEST_RES_RGB_LED       (1 << 5)
+#define TEST_RES_SENSOR_CONFIG (1 << 6)  // $I: gesture / projektor / force sensor konfigu
+
+// OLED Ekran - 128x64, I2C. display() yalnizca degisen sayfa/sutunlari gonderir (oled_display.h)
 #define SCREEN_WIDTH 128
 #define SCREEN_HEIGHT 64
 #define OLED_RESET -1
 #define SCREEN_ADDRESS 0x3C
-Adafruit_SSD1306 display(SCREEN_WIDTH, SCREEN_HEIGHT, &Wire, OLED_RESET);
+DiffSSD1306 display(SCREEN_WIDTH, SCREEN_HEIGHT, &Wire, OLED_RESET, SCREEN_ADDRESS);
 
 // Encoder Pinleri - Rotary Encoder KY-040 veya benzeri
 // Yeni bağlantı (I2C hatlarından UZAK):
@@ -105,10 +164,60 @@ int cvr1_tmc_status_stop_l = 0;
 int cvr2_tmc_status_stop_r = 0;
 int cvr2_tmc_status_stop_l = 0;
 
-// Encoder degiskenleri
-volatile int encoderPos = 0;
+// Motor hareket durumu ($A 16. alan). motorBusyReported: STM32 bu alani gonderiyor mu
+// (eski yazilim gondermez, motor testi tahmini sureye doner). motorBusyFrameMs: alanin
+// geldigi karenin alinma zamani.
+int  motor_busy_mask = 0;
+bool motorBusyReported = false;
+unsigned long motorBusyFrameMs = 0;
+
+// Alim tarafinin calisma karesi: $A alanlari buraya yazilir, kare tamamlaninca yayinlanir.
+// Yukaridaki global degiskenler yalnizca loop() tarafinda, yayinlanan kareden guncellenir.
+static TelemetrySnapshot telemetryFrame;
+static uint32_t          lastTelemetrySeq = 0;  // loop()'un en son aldigi kare
+static unsigned long     lastTelemetryMs = 0;   // o karenin alinma zamani
+static uint32_t          lastGestureEvents = 0; // loop()'un en son aldigi gesture olayi
+
+// $A alan semasi (SERI_HABERLESME.md 2.2): 7 deger /10, gesture, 7 TMC stop biti, motor mesgul
+static const Stm32Field dataSchema[STM32_DATA_FIELDS] = {
+  stm32ScaledField(&telemetryFrame.mcuLoad, 10.0f),
+  stm32ScaledField(&telemetryFrame.pcbTemp, 10.0f),
+  stm32ScaledField(&telemetryFrame.plateTemp, 10.0f),
+  stm32ScaledField(&telemetryFrame.resinTemp, 10.0f),
+  stm32ScaledField(&telemetryFrame.intake1Rpm, 10.0f, false),
+  stm32ScaledField(&telemetryFrame.intake2Rpm, 10.0f, false),
+  stm32ScaledField(&telemetryFrame.exhaustRpm, 10.0f, false),
+  stm32IntField(&telemetryFrame.gesture),
+  stm32IntField(&telemetryFrame.zStopR),
+  stm32IntField(&telemetryFrame.yStopR),
+  stm32IntField(&telemetryFrame.yStopL),
+  stm32IntField(&telemetryFrame.cvr1StopR),
+  stm32IntField(&telemetryFrame.cvr1StopL),
+  stm32IntField(&telemetryFrame.cvr2StopR),
+  stm32IntField(&telemetryFrame.cvr2StopL),
+  stm32IntField(&telemetryFrame.motorBusy),
+};
+
+// $X alan semasi (SERI_HABERLESME.md 2.5): NTC/IR durumu cagirana doner, digerleri global
+static const Stm32Field statusSchema[8] = {
+  stm32IntField(nullptr),                   // ntc_sensor_status
+  stm32IntField(nullptr),                   // ir_sensor_status
+  stm32IntField(&exhaust_fan_error),
+  stm32IntField(&intake1_fan_error),
+  stm32IntField(&intake2_fan_error),
+  stm32IntField(&gesture_sensor_status),
+  stm32IntField(&projector_sensor_status),
+  stm32IntField(&force_sensor_status),
+};
+
+// $Wn alan semasi: tek ondalikli deger (gram), hedef istek basina (LoadcellReply)
+static const Stm32Field loadcellSchema[1] = {
+  stm32DecimalField(nullptr, 3),
+};
+
+// Encoder degiskenleri: kesme adimlari (halInput) updateMenu() basinda encoderPos'a eklenir
+int encoderPos = 0;
 int lastEncoderPos = 0;
-int lastCLK = 0;
 
 // Menu sistemi
 enum MenuState {
@@ -128,7 +237,8 @@ enum MenuState {
   MENU_Y_MOTOR,
   MENU_CVR_MOTOR,
   MENU_LOADCELL,
-  MENU_PROJEKSIYON
+  MENU_PROJEKSIYON,
+  MENU_RUN_ALL
 };
 
 MenuState currentMenu = MENU_MAIN;
@@ -155,36 +265,83 @@ const char* menuItems[] = {
   "Y Motor",
   "CVR 1-2 Motor",
   "Loadcell",
-  "Projection"
+  "Projection",
+  "Tumunu Test Et"
 };
-const int menuItemCount = 16;
+const int menuItemCount = 17;
 bool screenNeedsUpdate = true;
 
-// Intake Fan ayarlama degiskenleri
-int fanSpeedPercent = 0; // 0-100 arasi, %10'luk adimlarla (0, 10, 20, ..., 100)
-bool fanSpeedSent = false; // Komut gonderildi mi?
-unsigned long lastIntakeFanCommandMs = 0; // Son intake fan komut zamani
-int intakeFanSelection = 0; // 0: Test Et, 1: Cikis
-bool intakeFanTestRunning = false;
-bool intakeFanHasResult = false;
-bool intakeFanStatusSuccess = false;
-FanTestPhase intakeFanTestPhase = FAN_TEST_IDLE;
-unsigned long intakeFanPhaseStartMs = 0;
-unsigned long intakeFanLastStepMs = 0;
-char intakeFanFailLabel[24] = "";
-
-// Exhaust Fan ayarlama degiskenleri
-int exhaustFanSpeedPercent = 0; // 0-100 arasi, %10'luk adimlarla (0, 10, 20, ..., 100)
-bool exhaustFanSpeedSent = false; // Komut gonderildi mi?
-unsigned long lastExhaustFanCommandMs = 0; // Son exhaust fan komut zamani
-int exhaustFanSelection = 0; // 0: Test Et, 1: Cikis
-bool exhaustFanTestRunning = false;
-bool exhaustFanHasResult = false;
-bool exhaustFanStatusSuccess = false;
-FanTestPhase exhaustFanTestPhase = FAN_TEST_IDLE;
-unsigned long exhaustFanPhaseStartMs = 0;
-unsigned long exhaustFanLastStepMs = 0;
-char exhaustFanFailLabel[24] = "";
+// Fan gruplari: her grup STM32 fan kanallarinin listesi (intake: F1 + F2, exhaust: F3).
+// Tek fan test motoru her grup icin kendi durumuyla (fanGroupStates) calisir; gruplar
+// ayni anda test edilebilir. Yeni bir fan yeni bir kanal / grup satiridir.
+enum FanGroupId {
+  FAN_GROUP_INTAKE = 0,
+  FAN_GROUP_EXHAUST,
+  FAN_GROUP_COUNT
+};
+
+struct FanChannel {
+  int         number;  // STM32 $F<n> numarasi
+  const char* label;   // FAIL ekraninda gosterilen ad
+  float*      rpm;     // $A RPM alani
+  int*        error;   // $X hata biti
+};
+
+struct FanGroup {
+  const char*       title;         // ekran basligi: "<title> FAN" / "<title> TEST"
+  MenuState         menu;
+  const FanChannel* channels;
+  int               channelCount;
+};
+
+static const FanChannel intakeFanChannels[] = {
+  { 1, "F1", &intake1_fan_raw, &intake1_fan_error },
+  { 2, "F2", &intake2_fan_raw, &intake2_fan_error }
+};
+
+static const FanChannel exhaustFanChannels[] = {
+  { 3, "EXHAUST", &exhaust_fan_raw, &exhaust_fan_error }
+};
+
+#define FAN_GROUP(title, menu, channels) \
+  { title, menu, channels, sizeof(channels) / sizeof(channels[0]) }
+
+static const FanGroup fanGroups[FAN_GROUP_COUNT] = {
+  FAN_GROUP("INTAKE",  MENU_INTAKE_FAN,  intakeFanChannels),   // FAN_GROUP_INTAKE
+  FAN_GROUP("EXHAUST", MENU_EXHAUST_FAN, exhaustFanChannels)   // FAN_GROUP_EXHAUST
+};
+
+#define FAN_GROUP_MAX_CHANNELS 2
+#define FAN_CURVE_POINTS      11  // RPM / duty egrisi: %0, %10, ..., %100
+
+static_assert(sizeof(intakeFanChannels) / sizeof(intakeFanChannels[0]) <= FAN_GROUP_MAX_CHANNELS,
+              "FAN_GROUP_MAX_CHANNELS");
+static_assert(sizeof(exhaustFanChannels) / sizeof(exhaustFanChannels[0]) <= FAN_GROUP_MAX_CHANNELS,
+              "FAN_GROUP_MAX_CHANNELS");
+
+struct FanGroupState {
+  int  speedPercent;           // 0-100 arasi, %10'luk adimlarla (0, 10, 20, ..., 100)
+  bool speedSent;              // Komut gonderildi mi?
+  unsigned long lastCommandMs; // Son fan komut zamani
+  int  selection;              // 0: Test Et, 1: Cikis
+  TestRunner test;             // Adimlar fanTestTables[g]; runner.phase = FanTestPhase
+  bool hasResult;
+  bool statusSuccess;
+  char failLabel[24];
+  bool statusDone;             // test $X cevabi (veya zaman asimi) geldi
+  bool statusOk;
+  int  statusErrorMask;        // cevaptaki kanal hata bitleri (bit n: channels[n])
+  // Olcum fazi: kanal basina oturma penceresi (ortalamasi adim tablosunda esikle karsilastirilir)
+  SteadyWindow  settle[FAN_GROUP_MAX_CHANNELS];
+  uint32_t      settleSeq;     // pencereye alinan son $A karesi
+  unsigned long settleStartMs;
+  unsigned long settleMs;      // %100'e ulasildiktan karara kadar gecen sure
+  bool          settleCapped;  // karar FAN_TEST_SETTLE_MAX_MS ust sinirinda verildi
+  // RPM / duty egrisi: curve[duty / 10][kanal]; curveMask bit i: %10*i noktasi olculdu
+  float         curve[FAN_CURVE_POINTS][FAN_GROUP_MAX_CHANNELS];
+  uint16_t      curveMask;
+};
+FanGroupState fanGroupStates[FAN_GROUP_COUNT] = {};
 
 // RGB LED ayarlama degiskenleri
 int rgbHue = 0;        // Hue: 0-360 arasi
@@ -196,9 +353,28 @@ bool rgbMode = false; // false: parametre secimi, true: deger ayarlama
 bool rgbCommandSent = false; // Komut gonderildi mi?
 int  rgbMenuSelection = 0;   // RGB menusu: 0 = LED Test, 1 = Cikis
 
+// RGB LED testi: KIRMIZI/YESIL/MAVI x2, ardindan rainbow (adimlar rgbLedTestSteps)
+TestRunner rgbLedTest = {};
+int  rgbTestRainbowStep = 0;
+const char* rgbTestLabel = "";
+
 // Motor freni (Brake Motor) ayarlama degiskenleri
 bool brakeMotorActive = false; // false: pasif ($B0), true: aktif ($B1)
 int  brakeMotorSelection = 0;  // 0: Test icin tikla, 1: Cikis
+TestRunner brakeMotorTest = {}; // Test sirasinda faz = brakeMotorActive (AKTIF / PASIF)
+int  brakeTestCycle = 0;       // 1..BRAKE_TEST_CYCLES
+
+// Z / Y / CVR 1-2 motor testleri (eksen basina bir runner, eksenler ayni anda calisabilir)
+enum MotorTestAxis {
+  MOTOR_AXIS_Z = 0,
+  MOTOR_AXIS_Y,
+  MOTOR_AXIS_CVR,
+  MOTOR_AXIS_COUNT
+};
+
+TestRunner motorTests[MOTOR_AXIS_COUNT] = {};
+int motorTestMoveIndex[MOTOR_AXIS_COUNT] = {0};  // son gonderilen hareket
+unsigned long motorTestMoveSentMs[MOTOR_AXIS_COUNT] = {0};
 
 // Z Motor ayarlama degiskenleri (mikrostep tabanli)
 bool zMotorEnabled = false;        // $SZE / $SZD
@@ -233,45 +409,63 @@ bool projectorHasResult     = false; // test yapildi mi
 bool projectorStatusSuccess = false; // true: SUCCESS, false: FAIL
 int  projectorSelection     = 0;     // 0: LED, 1: Akim, 2: Test, 3: Cikis
 bool projectorEditMode      = false; // true: Akim ayarlama modu
+TestRunner projectorTest = {};       // $PF -> $I -> $X (adimlar projectorTestSteps)
+bool projectorStatusDone    = false; // test $X cevabi (veya zaman asimi) geldi
+bool projectorStatusOk      = false; // cevap alindi ve projector_sensor_status == 0
+
+// NTC/IR test modu: SABIT = her zaman NTC/IR_SAMPLE_COUNT olcum; ARDISIK = ortalama ve
+// varyans (Welford) limitlerin yeterince icindeyse erken PASS, fark limiti asinca erken FAIL,
+// karar cikmazsa yine en fazla SAMPLE_COUNT olcum
+enum TempTestMode {
+  TEMP_TEST_FIXED = 0,
+  TEMP_TEST_SEQUENTIAL
+};
+TempTestMode tempTestMode = TEMP_TEST_DEFAULT_MODE;
 
 // NTC test menusu durum degiskenleri
-bool  ntcTestRunning   = false;  // true iken 100 olcum toplanir
-int   ntcSampleCount   = 0;      // kac olcum alindi
-float ntcSampleSum     = 0.0f;   // olcumlerin toplami
+// Olcumler ntcSampler'da (plate temp kanali); test suruyor = sampleAccumulatorRunning(ntcSampler)
 float ntcAverageTemp   = 0.0f;   // hesaplanan ortalama sicaklik
-float ntcMinTemp       = 0.0f;   // olcumler icindeki minimum sicaklik
-float ntcMaxTemp       = 0.0f;   // olcumler icindeki maksimum sicaklik
-float ntcLastTemp      = 0.0f;   // bir onceki olcum
-bool  ntcHasLastTemp   = false;  // onceki olcum var mi
 bool  ntcHasResult     = false;  // test tamamlandi mi
 bool  ntcStatusSuccess = false;  // true: SUCCESS, false: FAIL
-unsigned long ntcTestStartTime = 0; // testi baslatma zamani (ms)
-int   ntcSelection     = 0;      // 0: Test, 1: Cikis
+int   ntcSelection     = 0;      // 0: Test, 1: Cikis, 2: Mod
 int   ntcSensorStatus  = -1;     // $X komutundan gelen ham NTC status degeri
 bool  ntcSensorStatusValid = false; // $X cevabi alindiysa true
 bool  ntcSensorDisconnected = false; // status=1 iken true, ekranda "FAIL"
+bool  ntcStartOnStatus = false;  // Test istendi, durum bilinmiyor: $X cevabi gelince baslar
 
 // IR Temp menusu durum degiskenleri
 bool  irHasResult      = false;   // son test yapildi mi
-int   irSelection      = 0;       // 0: Test, 1: Cikis
+int   irSelection      = 0;       // 0: Test, 1: Cikis, 2: Mod
 bool  irStatusSuccess  = false;  // true: SUCCESS, false: FAIL
-bool  irTestRunning    = false;  // true iken 20 olcum toplanir
-int   irSampleCount    = 0;      // kac olcum alindi
-float irSampleSum      = 0.0f;   // olcumlerin toplami
+// Olcumler irSampler'da (resin temp kanali)
 float irAverageTemp    = 0.0f;   // hesaplanan ortalama sicaklik
-float irMinTemp        = 0.0f;   // min sicaklik
-float irMaxTemp        = 0.0f;   // max sicaklik
-float irLastTempStep   = 0.0f;   // bir onceki olcum (ardil fark kontrolu icin)
-bool  irHasLastTemp    = false;   // onceki olcum var mi
-unsigned long irTestStartTime = 0;      // testi baslatma zamani (ms)
 int   irSensorStatus   = -1;     // $X komutundan gelen ham IR status degeri
 bool  irSensorStatusValid = false; // $X cevabi alindiysa true
 bool  irSensorDisconnected = false; // status=1 iken true, ekranda "FAIL"
+bool  irStartOnStatus  = false;  // Test istendi, durum bilinmiyor: $X cevabi gelince baslar
+
+// NTC / IR kararlilik testleri: $A kanal ornekleyicileri (sample_accumulator.h).
+// Deger 0-100 C, ardil fark ve min-max farki limitli; SAMPLE_COUNT olcumde sonuc.
+static void onNTCSamplesDone(SampleAccumulator &acc);
+static void onIRSamplesDone(SampleAccumulator &acc);
+
+static const SampleLimits ntcSampleLimits = {
+  0.0f, 100.0f, NTC_STEP_DELTA_C, NTC_STABILITY_DELTA_C, NTC_SAMPLE_COUNT
+};
+static const SampleLimits irSampleLimits = {
+  0.0f, 100.0f, IR_STEP_DELTA_C, IR_STABILITY_DELTA_C, IR_SAMPLE_COUNT
+};
+
+SampleAccumulator ntcSampler = SAMPLE_ACCUMULATOR("NTC", TELEMETRY_PLATE_TEMP, ntcSampleLimits, onNTCSamplesDone);
+SampleAccumulator irSampler  = SAMPLE_ACCUMULATOR("IR", TELEMETRY_RESIN_TEMP, irSampleLimits, onIRSamplesDone);
 
 // Gesture menusu durum degiskenleri
 bool  gestureHasResult     = false;  // test yapildi mi
 bool  gestureStatusSuccess = false;  // true: SUCCESS, false: FAIL
 int   gestureSelection     = 0;      // 0: Test, 1: Cikis
+TestRunner gestureTest = {};         // $I -> $X (adimlar gestureTestSteps)
+bool  gestureStatusDone    = false;  // test $X cevabi (veya zaman asimi) geldi
+bool  gestureStatusOk      = false;  // cevap alindi ve gesture_sensor_status == 0
 
 // Z / Y / CVR motor test menuleri icin secim degiskenleri
 int   zMotorTestSelection   = 0;      // 0: Test, 1: Cikis
@@ -280,20 +474,62 @@ int   cvrMotorTestSelection = 0;      // 0: Test, 1: Cikis
 
 // Loadcell menusu icin secim / ekran durumu
 int   loadcellSelection     = 0;      // 0: Test Et, 1: Cikis (sadece menu modunda)
-int   loadcellScreenMode    = 0;      // 0: menu, 1: Test sonucu (4 deger), 2: HATA ekrani
+int   loadcellScreenMode    = 0;      // 0: menu, 1: Test sonucu (4 deger), 2: HATA ekrani, 3: TARE (test suruyor)
 int   loadcellErrorType     = 0;      // 0: genel hata, 1: amplifier kart hatasi
 int   loadcellFaultMask     = 0;      // Bit0:L1 Bit1:L2 Bit2:L3 Bit3:L4
 float loadcell1_g = 0.0f, loadcell2_g = 0.0f, loadcell3_g = 0.0f, loadcell4_g = 0.0f;  // gram
 
+// Loadcell testi fazlari (startLoadcellTest / updateLoadcellTest)
+enum LoadcellTestPhase {
+  LOADCELL_TEST_IDLE = 0,
+  LOADCELL_TEST_CONFIG,    // $I gonderildi, LOADCELL_CONFIG_MS bekleniyor
+  LOADCELL_TEST_STATUS,    // $X cevabi bekleniyor
+  LOADCELL_TEST_TARE,      // $WT sonrasi degerler makul seviyeye inene kadar okuma
+  LOADCELL_TEST_VALIDATE,  // LOADCELL_VALIDATE_ROUNDS tur ek dogrulama
+  LOADCELL_TEST_RETRY,     // ilk deneme basarisiz: LOADCELL_RETRY_MS sonra bastan
+  LOADCELL_TEST_SETTLE,    // sonuc ekranindan donus: $I sonrasi LOADCELL_CONFIG_MS (test devralir)
+  LOADCELL_REFRESH_STATUS, // sonuc ekrani yenilemesi: $X cevabi bekleniyor
+  LOADCELL_REFRESH_READ    // sonuc ekrani yenilemesi: $W1..$W4 cevaplari bekleniyor
+};
+LoadcellTestPhase loadcellTestPhase = LOADCELL_TEST_IDLE;
+int   loadcellTestAttempt = 0;
+unsigned long loadcellPhaseStartMs = 0;  // faz basi / son okuma zamani
+unsigned long loadcellTareStartMs = 0;
+bool  loadcellReadPending = false;       // $W1..$W4 cevaplari bekleniyor
+bool  loadcellStatusDone = false;        // $X cevabi (veya zaman asimi) geldi
+bool  loadcellStatusOk = false;
+bool  loadcellHasValidRead = false;
+int   loadcellObservedFaultMask = 0;
+int   loadcellValidateRound = 0;
+float loadcellTestValues[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
+int   loadcellForceStatus = 0;           // test $X cevabindaki force_sensor_status
+
+// "Tumunu Test Et": testler runAllTests tablosundan kaynak kilitleriyle ayni anda kosar
+TestSuite runAllSuite = {};
+int  runAllScroll = 0;                   // ozet ekraninda ilk gorunen test
+
 
-static unsigned long lastRead = 0;
 static unsigned long lastButtonPress = 0;
-static unsigned long lastSensorStatusCheck = 0;
-static unsigned long lastLoadcellUpdate = 0;
+
+// loop() zamanlayici isleri (setup()'ta kaydedilir)
+static int readJob = -1;          // $A polling (akis yokken)
+static int screenJob = -1;        // periyodik ekran yenileme
+static int sensorStatusJob = -1;  // $X sorgusu
+static int loadcellJob = -1;      // loadcell sonuc ekrani yenileme
+static int testJob = -1;          // test adimlari, NTC/IR timeout
+static int consoleJob = -1;       // Serial debug konsolu (prof)
+
+// pollSTM32Link() sirasinda en az bir cevap islendi mi
+static bool stm32ReplyHandled = false;
 
 // Forward declaration
 void readSTM32Data();
-void IRAM_ATTR encoderISR();
+bool pollSTM32Link();
+static bool applySTM32Data(const int32_t* values, int valueIndex, const char* source);
+static void applyTelemetry(const TelemetrySnapshot &t);
+static void onSTM32DataReply(const char* line, void* ctx);
+static void onSensorStatusReply(const char* line, void* ctx);
+static void registerLoopJobs();
 void drawMenu();
 void drawIRTempScreen();
 void drawNTCScreen();
@@ -311,14 +547,27 @@ void drawYMotorScreen();
 void drawCVRMotorScreen();
 void drawLoadcellScreen();
 void drawProjeksiyonScreen();
+void drawRunAllScreen();
+void drawCurrentScreen();
+static void drawTestScreen(MenuState menu);
 void sendBrakeMotorCommand(bool active);
 void sendProjeksiyonOn();
 void sendProjeksiyonOff();
 void sendProjeksiyonCurrent();
-void runRGBLedTest();
-void runZMotorTest();
-void runYMotorTest();
-void runLoadcellTest();
+void startBrakeMotorTest();
+void startRGBLedTest();
+void startZMotorTest();
+void startYMotorTest();
+void startCVRMotorTest();
+void startLoadcellTest();
+void startProjectorTest();
+void startGestureTest();
+void updateGestureTest();
+void updateBrakeMotorTest();
+void updateRGBLedTest();
+void updateMotorTest();
+void updateLoadcellTest();
+void updateProjectorTest();
 void sendZMotorEnable(bool enable);
 void sendZMotorStop();
 void sendZMotorMove();
@@ -328,20 +577,14 @@ void sendYMotorMove();
 void sendCVRMotorEnable(int motor, bool enable);
 void sendCVRMotorStop(int motor);
 void sendCVRMotorMove(int motor);
-void sendIntakeFanCommand();
-void sendExhaustFanCommand();
-void startIntakeFanTest();
-void startExhaustFanTest();
-void updateIntakeFanTest();
-void updateExhaustFanTest();
+void updateFanTests();
 void sendRGBLedCommand();
 void sendGestureInit();
 void updateMenu();
 
 // Sensor durum sorgu fonksiyonlari ($X komutu)
-bool getSensorStatus(int &ntcStatus, int &irStatus);
-bool isNTCSensorOk();
-bool isIRSensorOk();
+static bool drawMotorTestProgress(MotorTestAxis axis);
+static void requestSensorStatus();
 
 // Helper fonksiyonlar - UI iyilestirmeleri
 void drawHeader(const char* title);
@@ -376,292 +619,255 @@ void setup() {
   delay(50);
   Serial1.flush();
   while (Serial1.available()) Serial1.read();
+  schedulerBegin(); // STM32 cevaplari ve kesmeler loop()'u bu gorevde uyandirir
+  // $A kanal ornekleyicileri (her yeni karede applyTelemetry() besler)
+  sampleAccumulatorAttach(ntcSampler);
+  sampleAccumulatorAttach(irSampler);
+  // $A cevaplari ve $AS akis satirlari haberlesme gorevinde (cekirdek 0) parse edilip yayinlanir
+  stm32LinkSetDataHandler(onSTM32DataReply);
+  stm32LinkBegin(); // Bundan sonra Serial1 haberlesme gorevine aittir; loop() UART'ta hic beklemez
+  unsigned long linkBaud = stm32LinkNegotiateBaud(UART_BAUD, uartFastBauds,
+                                                  sizeof(uartFastBauds) / sizeof(uartFastBauds[0]),
+                                                  UART_BAUD_NEGOTIATE_MS);
+  Serial.printf("STM32: %lu baud\n", linkBaud);
+  if (stm32LinkNegotiateBinary(BINARY_NEGOTIATE_MS)) {
+    Serial.println("STM32: ikili $A cercevesi aktif");
+  } else {
+    Serial.println("STM32: ASCII $A (ikili cerceve desteklenmiyor)");
+  }
   
-  // Encoder pinlerini ayarla
-  pinMode(ENCODER_CLK, INPUT_PULLUP);
-  pinMode(ENCODER_DT, INPUT_PULLUP);
-  pinMode(ENCODER_SW, INPUT_PULLUP);
-  lastCLK = digitalRead(ENCODER_CLK);
-  attachInterrupt(digitalPinToInterrupt(ENCODER_CLK), encoderISR, CHANGE);
+#ifdef ARDUINO
+  // Encoder pinlerini ayarla (kesmeler hal_arduino.cpp'de, loop()'u uyandirir)
+  halArduinoInputBegin(ENCODER_CLK, ENCODER_DT, ENCODER_SW);
+#endif
   
-  // Ilk veriyi al
+  // Ilk veriyi iste (cevap loop() icinde islenir)
   delay(200);
   readSTM32Data();
-  lastRead = millis();
+  registerLoopJobs();
 
   // Kurulum tamamlandiktan sonra ana menuyu hazirla ve goster
   currentMenu = MENU_MAIN;
   menuSelection = 0;
-  drawMenu();
-  display.display();
+  drawCurrentScreen();
 }
 
-// STM32'den veri oku ve parse et
+// STM32'den veri iste: $A gonderilir, cevap beklenmez.
+// Cevap haberlesme gorevinde onSTM32DataReply()'a verilir, kare pollSTM32Link() icinde alinir.
 void readSTM32Data() {
-  // Once buffer'daki eski/karisik veriyi temizle (getSensorStatus veya onceki okumadan kalma)
-  while (Serial1.available()) {
-    Serial1.read();
+  PROFILE_ZONE(PROFILE_READ_DATA);
+  // Onceki istegin cevabi hala yoldaysa ust uste istek yigma
+  if (stm32LinkIsPending(STM32_REQ_DATA)) return;
+  stm32LinkRequest(STM32_REQ_DATA, "$A", READ_TIMEOUT_MS, nullptr);
+}
+
+// $A cevabi / akis satiri: parse edilip telemetri karesi olarak yayinlanir.
+// Haberlesme gorevinde calisir: yalnizca telemetryFrame'e ve Serial'e dokunur.
+static void onSTM32DataReply(const char* line, void* ctx) {
+  if (line == nullptr) return;
+  PROFILE_ZONE(PROFILE_PARSE_DATA);
+  if (stm32LinkIsDataFrame(line)) {
+    parseSTM32DataFrame(line);
+  } else {
+    parseSTM32DataLine(line);
   }
+}
 
-  // $A\r\n gonder
-  Serial1.print("$A\r\n");
-  Serial1.flush();
-  delay(READ_DELAY_MS);
-  
-  // Bir satir oku (\r\n gelene kadar, timeout: READ_TIMEOUT_MS)
-  char buffer[96];
-  int index = 0;
-  unsigned long startTime = millis();
-  bool lineComplete = false;
-  
-  while (millis() - startTime < READ_TIMEOUT_MS && index < (int)sizeof(buffer) - 1) {
-    if (Serial1.available()) {
-      char c = Serial1.read();
-      if (c == '\r' || c == '\n') {
-        buffer[index] = '\0';
-        lineComplete = true;
-        break;
-      }
-      if (c >= 32 && c < 127) {
-        buffer[index++] = c;
-      }
-    }
-    // delay yok: veri gelir gelmez okumak icin
-  }
-  
-  if (!lineComplete || index == 0) {
-    return; // Timeout veya satir tamamlanmadi
+// Haberlesme gorevinden gelen cevaplari isle ve yeni telemetri karesi varsa al.
+// En az bir cevap islendiyse true doner.
+bool pollSTM32Link() {
+  PROFILE_ZONE(PROFILE_POLL_LINK);
+  stm32ReplyHandled = false;
+  stm32LinkService();
+  TelemetrySnapshot frame;
+  if (telemetryReadIfNew(frame, lastTelemetrySeq)) {
+    applyTelemetry(frame);
+    stm32ReplyHandled = true;
   }
-  
-  // Parse: $ ile baslamali, yoksa kabul etme
-  if (buffer[0] != '$') {
-    return; // $ ile baslamiyorsa kabul etme
+  return stm32ReplyHandled;
+}
+
+// Tek bir $A cevap (veya $AS akis) satirini parse et ve telemetri karesi olarak yayinla
+bool parseSTM32DataLine(const char* buffer) {
+  // 16 alan bekleniyor (7 sensor + gesture + 7 TMC status + motor mesgul); eski yazilim icin en az 4
+  int32_t values[STM32_DATA_FIELDS];
+  int valueIndex = stm32ParseFields(buffer, dataSchema, values);
+  return applySTM32Data(values, valueIndex, buffer);
+}
+
+// Ikili $A cercevesi (CRC alimda dogrulandi): alanlar dogrudan values'a acilir, metin parse yok
+bool parseSTM32DataFrame(const char* frame) {
+  int32_t values[STM32_DATA_FIELDS];
+  int valueIndex = stm32LinkDecodeDataFrame(frame, values, STM32_DATA_FIELDS);
+  return applySTM32Data(values, valueIndex, "$<bin>");
+}
+
+// Log satirinin n. baytindan itibaren bicimli ekle ve yeni uzunlugu dondur. Tampon dolarsa satir
+// kesilir; donen uzunluk size - 1'i gecmez (snprintf'in donusu gibi sonraki eklemeyi tasirmaz).
+static int appendLog(char* line, size_t size, int n, const char* format, ...)
+  __attribute__((format(printf, 4, 5)));
+
+static int appendLog(char* line, size_t size, int n, const char* format, ...) {
+  if ((size_t)n >= size - 1) return (int)size - 1;
+  va_list args;
+  va_start(args, format);
+  int written = vsnprintf(line + n, size - n, format, args);
+  va_end(args);
+  if (written < 0) return n;
+  return (size_t)(n + written) >= size ? (int)size - 1 : n + written;
+}
+
+// Parse edilmis $A alanlarini calisma karesine yaz ve yayinla (ASCII ve ikili ortak).
+// Burada sadece veri toplanir; test/ekran isleri yayinlanan kareyi alan applyTelemetry()'de.
+static bool applySTM32Data(const int32_t* values, int valueIndex, const char* source) {
+  // En az 4 sayi yoksa kare yok sayilir (eski yazilim 4..15 alan gonderebilir)
+  if (valueIndex < 4) return false;
+
+  // Gelen alanlar semadaki kare alanlarina yazilir (sicakliklar ve fan RPM /10,
+  // gesture ve TMC status direkt); gelmeyen alanlar onceki karedeki degerini korur
+  stm32StoreFields(dataSchema, values, valueIndex);
+  if (valueIndex >= 8 && telemetryFrame.gesture > GESTURE_NONE && telemetryFrame.gesture <= GESTURE_RIGHT) {
+    telemetryFrame.lastGesture = telemetryFrame.gesture;
+    telemetryFrame.gestureEvents++;
   }
-  
-  // Sayilari parse et (15 sayi bekleniyor: 7 sensor + gesture + 7 TMC status)
-  int values[15] = {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0};
-  int valueIndex = 0;
-  int numValue = 0;
-  bool inNumber = false;
-  
-  for (int i = 1; i <= index; i++) {
-    char c = (i < index) ? buffer[i] : '\0';
-    if (c >= '0' && c <= '9') {
-      numValue = numValue * 10 + (c - '0');
-      inNumber = true;
-    } else if (c == ',' || c == '\0' || c == '\r' || c == '\n') {
-      if (inNumber && valueIndex < 15) {
-        values[valueIndex++] = numValue;
-        numValue = 0;
-        inNumber = false;
-      }
-      if (c == '\0' || c == '\r' || c == '\n') break;
-    }
+  telemetryFrame.fieldCount  = (uint8_t)valueIndex;
+  telemetryFrame.timestampMs = millis();
+  telemetryPublish(telemetryFrame);
+
+  // Tek satirda hizli yazdir (cok sayida Serial.print yerine tek println)
+  const TelemetrySnapshot &t = telemetryFrame;
+  char line[128];
+  int n = appendLog(line, sizeof(line), 0, "%s | %.1f %.1f %.1f %.1f",
+                    source, t.mcuLoad, t.pcbTemp, t.plateTemp, t.resinTemp);
+  if (valueIndex >= 5) n = appendLog(line, sizeof(line), n, " %.1f", t.intake1Rpm);
+  if (valueIndex >= 6) n = appendLog(line, sizeof(line), n, " %.1f", t.intake2Rpm);
+  if (valueIndex >= 7) n = appendLog(line, sizeof(line), n, " %.1f", t.exhaustRpm);
+  if (valueIndex >= 8)
+    n = appendLog(line, sizeof(line), n, " g%d", t.gesture);
+  if (valueIndex >= 9)
+    n = appendLog(line, sizeof(line), n, " z%d", t.zStopR);
+  if (valueIndex >= 10)
+    n = appendLog(line, sizeof(line), n, " y%d,%d", t.yStopR, t.yStopL);
+  if (valueIndex >= 12)
+    n = appendLog(line, sizeof(line), n, " c1%d,%d", t.cvr1StopR, t.cvr1StopL);
+  if (valueIndex >= 14)
+    n = appendLog(line, sizeof(line), n, " c2%d,%d", t.cvr2StopR, t.cvr2StopL);
+  if (valueIndex >= 16)
+    n = appendLog(line, sizeof(line), n, " m%d", t.motorBusy);
+  Serial.println(line);
+  return true;
+}
+
+static const char* getTempTestModeLabel() {
+  return tempTestMode == TEMP_TEST_SEQUENTIAL ? "ardisik" : "sabit";
+}
+
+static void printSampleResult(const SampleAccumulator &acc) {
+  const RunningStats &s = acc.stats;
+  Serial.printf("%s testi (%s): %s%s%s, %u olcum, %lu ms, ort %.2f, fark %.2f, sigma %.3f\n",
+                acc.name, acc.sequential ? "ardisik" : "sabit",
+                acc.verdict == SAMPLE_PASS ? "SUCCESS" : "FAIL",
+                acc.failReason != SAMPLE_FAIL_NONE ? " " : "", sampleFailReasonLabel(acc.failReason),
+                (unsigned)s.count, acc.endMs - acc.startMs, s.mean, runningStatsRange(s),
+                runningStatsStdDev(s));
+}
+
+// Ornekleyici bitti (PASS / FAIL / zaman asimi): sonucu ekrana al
+static void onNTCSamplesDone(SampleAccumulator &acc) {
+  ntcAverageTemp   = acc.stats.count > 0 ? acc.stats.mean : 0.0f;
+  ntcStatusSuccess = (acc.verdict == SAMPLE_PASS);
+  ntcHasResult     = true;
+  printSampleResult(acc);
+  drawTestScreen(MENU_NTC);
+}
+
+static void onIRSamplesDone(SampleAccumulator &acc) {
+  irAverageTemp   = acc.stats.count > 0 ? acc.stats.mean : 0.0f;
+  irStatusSuccess = (acc.verdict == SAMPLE_PASS);
+  irHasResult     = true;
+  printSampleResult(acc);
+  drawTestScreen(MENU_IR_TEMP);
+}
+
+// Yayinlanan $A karesini ekran/test degiskenlerine al ve kareye bagli isleri yap.
+// Tum alanlar ayni kareden gelir (TMC bitleri, sicakliklar birbiriyle tutarli).
+static void applyTelemetry(const TelemetrySnapshot &t) {
+  int valueIndex = t.fieldCount;
+  lastTelemetryMs = t.timestampMs;
+  mcu_load_raw   = t.mcuLoad;
+  pcb_temp_raw   = t.pcbTemp;
+  plate_temp_raw = t.plateTemp;
+  resin_temp_raw = t.resinTemp;
+  if (valueIndex >= 5) intake1_fan_raw = t.intake1Rpm;
+  if (valueIndex >= 6) intake2_fan_raw = t.intake2Rpm;
+  if (valueIndex >= 7) exhaust_fan_raw = t.exhaustRpm;
+  if (valueIndex >= 8) gesture_type    = t.gesture;
+  if (valueIndex >= 9) {
+    z_tmc_status_stop_r    = t.zStopR;
+    y_tmc_status_stop_r    = t.yStopR;
+    y_tmc_status_stop_l    = t.yStopL;
+    cvr1_tmc_status_stop_r = t.cvr1StopR;
+    cvr1_tmc_status_stop_l = t.cvr1StopL;
+    cvr2_tmc_status_stop_r = t.cvr2StopR;
+    cvr2_tmc_status_stop_l = t.cvr2StopL;
   }
-  
-  // Son sayiyi ekle (eğer varsa)
-  if (inNumber && valueIndex < 15) {
-    values[valueIndex++] = numValue;
+  if (valueIndex >= 16) {
+    motor_busy_mask   = t.motorBusy;
+    motorBusyReported = true;
+    motorBusyFrameMs  = t.timestampMs;
   }
-  
-  // En az 4 sayi varsa tum sensörleri guncelle
-  if (valueIndex >= 4) {
-    mcu_load_raw   = values[0] / 10.0;
-    pcb_temp_raw   = values[1] / 10.0;
-    plate_temp_raw = values[2] / 10.0;
-    resin_temp_raw = values[3] / 10.0;
-
-    // NTC/IR baglanti durumu: $A verisinden aninda tespit (50ms'de bir - ekran guncellemesi icin)
-    if (currentMenu == MENU_NTC && !ntcTestRunning) {
-      if (plate_temp_raw < -20.0f || plate_temp_raw > 150.0f || plate_temp_raw == 255.0f) {
-        ntcSensorStatus = 1;
-        ntcSensorStatusValid = true;
-      } else if (plate_temp_raw >= 0.1f && plate_temp_raw <= 99.9f) {
-        ntcSensorStatus = 0;
-        ntcSensorStatusValid = true;
-      }
-      screenNeedsUpdate = true;
+
+  // Ekran guncellemesi gerekli
+  screenNeedsUpdate = true;
+
+  // NTC/IR baglanti durumu: $A verisinden aninda tespit (50ms'de bir - ekran guncellemesi icin)
+  if (currentMenu == MENU_NTC && !sampleAccumulatorRunning(ntcSampler)) {
+    if (plate_temp_raw < -20.0f || plate_temp_raw > 150.0f || plate_temp_raw == 255.0f) {
+      ntcSensorStatus = 1;
+      ntcSensorStatusValid = true;
+    } else if (plate_temp_raw >= 0.1f && plate_temp_raw <= 99.9f) {
+      ntcSensorStatus = 0;
+      ntcSensorStatusValid = true;
     }
-    if (currentMenu == MENU_IR_TEMP && !irTestRunning) {
-      // Sadece BAGLI guncelle; YOK $A'dan set etme (IR gurultulu olabilir, yanlis FAIL onleme)
-      if (resin_temp_raw >= 0.0f && resin_temp_raw <= 99.9f) {
-        irSensorStatus = 0;
-        irSensorStatusValid = true;
-      }
-      screenNeedsUpdate = true;
+    screenNeedsUpdate = true;
+  }
+  if (currentMenu == MENU_IR_TEMP && !sampleAccumulatorRunning(irSampler)) {
+    // Sadece BAGLI guncelle; YOK $A'dan set etme (IR gurultulu olabilir, yanlis FAIL onleme)
+    if (resin_temp_raw >= 0.0f && resin_temp_raw <= 99.9f) {
+      irSensorStatus = 0;
+      irSensorStatusValid = true;
     }
+    screenNeedsUpdate = true;
+  }
 
-    // NTC menusu icin 20 olcumluk test toplama (yalnizca plate_temp_raw kullanilir)
-    if (currentMenu == MENU_NTC && ntcTestRunning) {
-      // Aralik disi deger gorursek direkt FAIL
-      if (plate_temp_raw < 0.0f || plate_temp_raw > 100.0f) {
-        ntcTestRunning   = false;
-        ntcHasResult     = true;
-        ntcStatusSuccess = false;
-      } else {
-        // Iki ardil olcum arasindaki farki kontrol et
-        if (ntcHasLastTemp) {
-          float stepDiff = plate_temp_raw - ntcLastTemp;
-          if (stepDiff < 0.0f) stepDiff = -stepDiff;
-          if (stepDiff > NTC_STEP_DELTA_C) {
-            // Bir onceki olcumden 0.7 C'den fazla sapma: hemen FAIL
-            ntcTestRunning   = false;
-            ntcHasResult     = true;
-            ntcStatusSuccess = false;
-            drawNTCScreen();
-            return;
-          }
-        }
-
-        ntcLastTemp    = plate_temp_raw;
-        ntcHasLastTemp = true;
-
-        // Istatistikleri guncelle (min, max, ortalama icin)
-        ntcSampleSum   += plate_temp_raw;
-        ntcSampleCount += 1;
-        if (ntcSampleCount == 1) {
-          ntcMinTemp = plate_temp_raw;
-          ntcMaxTemp = plate_temp_raw;
-        } else {
-          if (plate_temp_raw < ntcMinTemp) ntcMinTemp = plate_temp_raw;
-          if (plate_temp_raw > ntcMaxTemp) ntcMaxTemp = plate_temp_raw;
-        }
-        if (ntcSampleCount >= NTC_SAMPLE_COUNT) {
-          ntcAverageTemp   = ntcSampleSum / ntcSampleCount;
-          float delta      = ntcMaxTemp - ntcMinTemp;
-          ntcStatusSuccess = (ntcAverageTemp >= 0.0f && ntcAverageTemp <= 100.0f &&
-                              delta <= NTC_STABILITY_DELTA_C);
-          ntcHasResult     = true;
-          ntcTestRunning   = false;
-        }
-      }
-      // Test surecinde/bitince ekrani guncelle
-      drawNTCScreen();
-    }
+  // Kanal ornekleyicileri (NTC / IR testi): menuden bagimsiz, "Tumunu Test Et" sirasinda da
+  // ayni kareden ornek alinir. Sonuc onNTCSamplesDone / onIRSamplesDone ile gelir.
+  sampleAccumulatorsFeed(t);
 
-    // IR Temp menusu icin 20 olcumluk test toplama (resin_temp_raw - NTC ile ayni mantik)
-    if (currentMenu == MENU_IR_TEMP && irTestRunning) {
-      if (resin_temp_raw < 0.0f || resin_temp_raw > 100.0f) {
-        irTestRunning   = false;
-        irHasResult     = true;
-        irStatusSuccess = false;
-      } else {
-        if (irHasLastTemp) {
-          float stepDiff = resin_temp_raw - irLastTempStep;
-          if (stepDiff < 0.0f) stepDiff = -stepDiff;
-          if (stepDiff > IR_STEP_DELTA_C) {
-            irTestRunning   = false;
-            irHasResult     = true;
-            irStatusSuccess = false;
-            drawIRTempScreen();
-            return;
-          }
-        }
-        irLastTempStep = resin_temp_raw;
-        irHasLastTemp  = true;
-        irSampleSum   += resin_temp_raw;
-        irSampleCount += 1;
-        if (irSampleCount == 1) {
-          irMinTemp = resin_temp_raw;
-          irMaxTemp = resin_temp_raw;
-        } else {
-          if (resin_temp_raw < irMinTemp) irMinTemp = resin_temp_raw;
-          if (resin_temp_raw > irMaxTemp) irMaxTemp = resin_temp_raw;
-        }
-        if (irSampleCount >= IR_SAMPLE_COUNT) {
-          irAverageTemp   = irSampleSum / irSampleCount;
-          float delta     = irMaxTemp - irMinTemp;
-          irStatusSuccess = (irAverageTemp >= 0.0f && irAverageTemp <= 100.0f &&
-                             delta <= IR_STABILITY_DELTA_C);
-          irHasResult     = true;
-          irTestRunning   = false;
-        }
-      }
-      drawIRTempScreen();
+  if (valueIndex >= 8) {
+    if (gesture_type < GESTURE_NONE || gesture_type > GESTURE_RIGHT) {
+      gesture_type = GESTURE_NONE;
     }
-
-    if (valueIndex >= 5) intake1_fan_raw = values[4] / 10.0;
-    if (valueIndex >= 6) intake2_fan_raw = values[5] / 10.0;
-    if (valueIndex >= 7) exhaust_fan_raw = values[6] / 10.0;
-    
-    if (valueIndex >= 8) {
-      gesture_type = values[7];
-      if (gesture_type < GESTURE_NONE || gesture_type > GESTURE_RIGHT) {
-        gesture_type = GESTURE_NONE;
-      }
-      // NONE disindaki son valid degeri ekranda tut
-      if (gesture_type != GESTURE_NONE) {
-        last_gesture_type = gesture_type;
-      }
-      // Ekranin ne zaman cizilecegini loop() belirlesin
-      if (currentMenu == MENU_GESTURE) {
-        screenNeedsUpdate = true;
-      }
+    // NONE disindaki son valid degeri ekranda tut (kacirilan karelerdeki gesture dahil)
+    if (t.gestureEvents != lastGestureEvents) {
+      lastGestureEvents = t.gestureEvents;
+      last_gesture_type = t.lastGesture;
     }
-    
-    // TMC Status degerleri (9-15 arasi: gesture sonrasi 7 TMC status)
-    // values[8] = z_tmc_status_stop_r (9. deger)
-    // values[9] = y_tmc_status_stop_r (10. deger)
-    // values[10] = y_tmc_status_stop_l (11. deger)
-    // values[11] = cvr1_tmc_status_stop_r (12. deger)
-    // values[12] = cvr1_tmc_status_stop_l (13. deger)
-    // values[13] = cvr2_tmc_status_stop_r (14. deger)
-    // values[14] = cvr2_tmc_status_stop_l (15. deger)
-    if (valueIndex >= 9) {
-      z_tmc_status_stop_r = values[8];
-      if (valueIndex >= 10) y_tmc_status_stop_r = values[9];
-      if (valueIndex >= 11) y_tmc_status_stop_l = values[10];
-      if (valueIndex >= 12) cvr1_tmc_status_stop_r = values[11];
-      if (valueIndex >= 13) cvr1_tmc_status_stop_l = values[12];
-      if (valueIndex >= 14) cvr2_tmc_status_stop_r = values[13];
-      if (valueIndex >= 15) cvr2_tmc_status_stop_l = values[14];
-      
-      // Ekran guncellemesi gerekli
+    // Ekranin ne zaman cizilecegini loop() belirlesin
+    if (currentMenu == MENU_GESTURE) {
       screenNeedsUpdate = true;
-      
-      // TMC Ref ekranlarindaysak hemen ciz (gecikmesiz)
-      if (currentMenu == MENU_Z_REF) drawZRefScreen();
-      else if (currentMenu == MENU_Y_REF) drawYRefScreen();
-      else if (currentMenu == MENU_CVR1_REF) drawCVR1RefScreen();
-      else if (currentMenu == MENU_CVR2_REF) drawCVR2RefScreen();
     }
-    
-    // Tek satirda hizli yazdir (cok sayida Serial.print yerine tek println)
-    char line[128];
-    int n = snprintf(line, sizeof(line), "%s | %.1f %.1f %.1f %.1f",
-                     buffer, mcu_load_raw, pcb_temp_raw, plate_temp_raw, resin_temp_raw);
-    if (valueIndex >= 5) n += snprintf(line + n, sizeof(line) - n, " %.1f", intake1_fan_raw);
-    if (valueIndex >= 6) n += snprintf(line + n, sizeof(line) - n, " %.1f", intake2_fan_raw);
-    if (valueIndex >= 7) n += snprintf(line + n, sizeof(line) - n, " %.1f", exhaust_fan_raw);
-    if (valueIndex >= 8)
-      n += snprintf(line + n, sizeof(line) - n, " g%d", gesture_type);
-    if (valueIndex >= 9)
-      n += snprintf(line + n, sizeof(line) - n, " z%d", z_tmc_status_stop_r);
-    if (valueIndex >= 10)
-      n += snprintf(line + n, sizeof(line) - n, " y%d,%d", y_tmc_status_stop_r, y_tmc_status_stop_l);
-    if (valueIndex >= 12)
-      n += snprintf(line + n, sizeof(line) - n, " c1%d,%d", cvr1_tmc_status_stop_r, cvr1_tmc_status_stop_l);
-    if (valueIndex >= 14)
-      n += snprintf(line + n, sizeof(line) - n, " c2%d,%d", cvr2_tmc_status_stop_r, cvr2_tmc_status_stop_l);
-    Serial.println(line);
-    
-    // Ekran guncellemesi gerekli
-    screenNeedsUpdate = true;
   }
+  // TMC stop bitleri (9-15) Ref / motor ekranlarinin gorunum modelinde; ekran loop()'ta cizilir
 }
 
-// Encoder interrupt handler
-void IRAM_ATTR encoderISR() {
-  int CLK = digitalRead(ENCODER_CLK);
-  int DT = digitalRead(ENCODER_DT);
-  
-  if (CLK != lastCLK) {
-    if (DT != CLK) {
-      encoderPos++;
-    } else {
-      encoderPos--;
-    }
-    lastCLK = CLK;
+// Test adimlarinin ekran guncellemesi: testin kendi menusu aciksa hemen ciz, degilse
+// (ornek: "Tumunu Test Et" ozet ekrani) acik ekran bir sonraki yenilemede cizilir
+static void drawTestScreen(MenuState menu) {
+  if (currentMenu == menu) {
+    drawCurrentScreen();
+  } else {
+    screenNeedsUpdate = true;
   }
 }
 
@@ -773,7 +979,7 @@ void drawIRTempScreen() {
   display.setTextSize(1);
   display.setCursor(0, 16);
   display.print("Durum: ");
-  if (irTestRunning) {
+  if (sampleAccumulatorRunning(irSampler)) {
     display.print("TESTING");
   } else if (irSensorDisconnected) {
     display.print("FAIL");
@@ -795,7 +1001,7 @@ void drawIRTempScreen() {
     display.print("--.- C");
   }
 
-  if (irTestRunning) {
+  if (sampleAccumulatorRunning(irSampler)) {
     drawCenteredText(38, "Olcum yapiliyor...", 1);
   } else {
     int y1 = 38;
@@ -807,6 +1013,11 @@ void drawIRTempScreen() {
     display.setCursor(0, y2);
     display.print(irSelection == 1 ? ">" : " ");
     display.print(" Cikis");
+
+    display.setCursor(0, 56);
+    display.print(irSelection == 2 ? ">" : " ");
+    display.print(" Mod: ");
+    display.print(getTempTestModeLabel());
   }
 
   display.display();
@@ -820,7 +1031,7 @@ void drawNTCScreen() {
   display.setTextSize(1);
   display.setCursor(0, 16);
   display.print("Durum: ");
-  if (ntcTestRunning) {
+  if (sampleAccumulatorRunning(ntcSampler)) {
     display.print("TESTING");
   } else if (ntcSensorDisconnected) {
     display.print("FAIL");
@@ -842,7 +1053,7 @@ void drawNTCScreen() {
     display.print("--.- C");
   }
 
-  if (ntcTestRunning) {
+  if (sampleAccumulatorRunning(ntcSampler)) {
     drawCenteredText(38, "Olcum yapiliyor...", 1);
   } else {
     display.setTextSize(1);
@@ -855,6 +1066,11 @@ void drawNTCScreen() {
     display.setCursor(0, y2);
     display.print(ntcSelection == 1 ? ">" : " ");
     display.print(" Cikis");
+
+    display.setCursor(0, 56);
+    display.print(ntcSelection == 2 ? ">" : " ");
+    display.print(" Mod: ");
+    display.print(getTempTestModeLabel());
   }
 
   display.display();
@@ -873,7 +1089,9 @@ void drawGestureScreen() {
   display.setTextSize(1);
   display.setCursor(0, 16);
   display.print("Durum: ");
-  if (gestureHasResult) {
+  if (testRunnerBusy(gestureTest)) {
+    display.print("TESTING");
+  } else if (gestureHasResult) {
     display.print(gestureStatusSuccess ? "SUCCESS" : "FAIL");
   } else {
     display.print("BEKLEME");
@@ -984,6 +1202,14 @@ void drawLoadcellScreen() {
     display.setCursor(0, y2);
     display.print(loadcellSelection == 1 ? ">" : " ");
     display.print(" Cikis");
+  } else if (loadcellScreenMode == 3) {
+    // Test suruyor: TARE ve dogrulama okumalari
+    drawHeader("Loadcell");
+    display.setTextSize(2);
+    drawCenteredText(32, "TARE...", 2);
+    display.setTextSize(1);
+    display.setCursor(0, 56);
+    display.print("Buton: Iptal");
   } else if (loadcellScreenMode == 1) {
     // Test sonucu: 4 loadcell degeri (gram)
     drawHeader("Loadcell Test");
@@ -1053,6 +1279,19 @@ void drawBrakeMotorScreen() {
   display.clearDisplay();
   drawHeader("Motor Freni");
 
+  if (testRunnerBusy(brakeMotorTest)) {
+    // Test ilerlemesi: 1/5, 2/5 ...
+    char buf[8];
+    snprintf(buf, sizeof(buf), "%d/%d", brakeTestCycle, BRAKE_TEST_CYCLES);
+    drawCenteredText(28, buf, 2);
+    display.setTextSize(1);
+    display.setCursor(0, 56);
+    display.print(brakeMotorActive ? "AKTIF" : "PASIF");
+    display.print("  Buton: Iptal");
+    display.display();
+    return;
+  }
+
   // Durum satiri
   display.setTextSize(1);
   display.setCursor(0, 16);
@@ -1074,45 +1313,51 @@ void drawBrakeMotorScreen() {
 }
 
 void sendBrakeMotorCommand(bool active) {
-  Serial1.print("$B");
-  Serial1.print(active ? "1" : "0");
-  Serial1.print("\r\n");
-  Serial1.flush();
+  stm32LinkSend(active ? "$B1" : "$B0");
   
   // Debug
   Serial.print("Brake Motor: ");
   Serial.println(active ? "$B1" : "$B0");
 }
 
-// Motor freni testi: 5 kez ac/kapa, ekranda ilerleme 1/5, 2/5 ... goster
-void runBrakeMotorTest() {
-  for (int i = 1; i <= 5; ++i) {
-    // Ekranda ilerlemeyi goster
-    display.clearDisplay();
-    drawHeader("Motor Freni");
-    display.setTextSize(2);
-    char buf[8];
-    snprintf(buf, sizeof(buf), "%d/5", i);
-    drawCenteredText(28, buf, 2);
-    display.display();
+// Motor freni testi: 5 kez ac/kapa, ekranda ilerleme 1/5, 2/5 ... goster.
+// Adimlar updateBrakeMotorTest() ile ilerler; buton testi keser.
+static bool setBrakeTestState(int active) {
+  if (active) brakeTestCycle++;
+  brakeMotorActive = (active != 0);
+  sendBrakeMotorCommand(brakeMotorActive);
+  drawTestScreen(MENU_BRAKE_MOTOR);
+  return true;
+}
 
-    // Motor frenini AC
-    brakeMotorActive = true;
-    sendBrakeMotorCommand(true);
-    delay(1000);
+static constexpr TestStep brakeMotorTestSteps[] = {
+  testAction(setBrakeTestState, 1), testWait(BRAKE_TEST_PHASE_MS),  // AKTIF
+  testAction(setBrakeTestState, 0), testWait(BRAKE_TEST_PHASE_MS),  // PASIF
+  testRepeat(4, BRAKE_TEST_CYCLES - 1)
+};
 
-    // Motor frenini KAPAT
-    brakeMotorActive = false;
-    sendBrakeMotorCommand(false);
-    delay(1000);
-  }
+void startBrakeMotorTest() {
+  brakeTestCycle = 0;
+  testRunnerStart(brakeMotorTest, brakeMotorTestSteps);
+  testRunnerTick(brakeMotorTest, millis());
+}
 
-  // Test bittikten sonra normal ekrana don
-  drawBrakeMotorScreen();
+void updateBrakeMotorTest() {
+  // Son PASIF fazi bitince test biter (fren zaten kapali)
+  if (testRunnerTick(brakeMotorTest, millis())) drawTestScreen(MENU_BRAKE_MOTOR);
+}
+
+static void abortBrakeMotorTest() {
+  testRunnerAbort(brakeMotorTest);
+  brakeMotorActive = false;
+  sendBrakeMotorCommand(false);
+  drawTestScreen(MENU_BRAKE_MOTOR);
 }
 
 // Z Motor test ekrani: Test / Cikis
 void drawZMotorScreen() {
+  if (drawMotorTestProgress(MOTOR_AXIS_Z)) return;
+
   display.clearDisplay();
   drawHeader("Z Motor Test");
 
@@ -1135,30 +1380,22 @@ void drawZMotorScreen() {
 
 void sendZMotorEnable(bool enable) {
   // Z motoru icin S on ekli protokol: $SZE / $SZD
-  Serial1.print(enable ? "$SZE" : "$SZD");
-  Serial1.print("\r\n");
-  Serial1.flush();
+  stm32LinkSend(enable ? "$SZE" : "$SZD");
   Serial.print("Z Motor Enable: ");
   Serial.println(enable ? "$SZE\\r\\n" : "$SZD\\r\\n");
 }
 
 void sendZMotorStop() {
   // Z motor durdurma: $SZP
-  Serial1.print("$SZP\r\n");
-  Serial1.flush();
+  stm32LinkSend("$SZP");
   Serial.println("Z Motor Stop: $SZP");
 }
 
 void sendZMotorMove() {
   // Format: $SZ<yon>,<mesafe>,<hiz>\r\n  (mesafe: mikrostep, hiz: mikrostep/s)
-  Serial1.print("$SZ");
-  Serial1.print(zMotorDir);
-  Serial1.print(",");
-  Serial1.print(zMotorDistanceSteps);
-  Serial1.print(",");
-  Serial1.print(zMotorSpeedStepsPerS);
-  Serial1.print("\r\n");
-  Serial1.flush();
+  char cmd[STM32_CMD_MAX];
+  snprintf(cmd, sizeof(cmd), "$SZ%d,%ld,%ld", zMotorDir, zMotorDistanceSteps, zMotorSpeedStepsPerS);
+  stm32LinkSend(cmd);
 
   Serial.print("Z Motor Move: $SZ");
   Serial.print(zMotorDir);
@@ -1171,6 +1408,8 @@ void sendZMotorMove() {
 
 // Y Motor test ekrani: Test / Cikis
 void drawYMotorScreen() {
+  if (drawMotorTestProgress(MOTOR_AXIS_Y)) return;
+
   display.clearDisplay();
   drawHeader("Y Motor Test");
 
@@ -1192,29 +1431,21 @@ void drawYMotorScreen() {
 }
 
 void sendYMotorEnable(bool enable) {
-  Serial1.print(enable ? "$SYE" : "$SYD");
-  Serial1.print("\r\n");
-  Serial1.flush();
+  stm32LinkSend(enable ? "$SYE" : "$SYD");
   Serial.print("Y Motor Enable: ");
   Serial.println(enable ? "$SYE\\r\\n" : "$SYD\\r\\n");
 }
 
 void sendYMotorStop() {
-  Serial1.print("$SYP\r\n");
-  Serial1.flush();
+  stm32LinkSend("$SYP");
   Serial.println("Y Motor Stop: $SYP");
 }
 
 void sendYMotorMove() {
   // Format: $SY<yon>,<mesafe>,<hiz>\r\n  (mesafe: mikrostep, hiz: mikrostep/s)
-  Serial1.print("$SY");
-  Serial1.print(yMotorDir);
-  Serial1.print(",");
-  Serial1.print(yMotorDistanceSteps);
-  Serial1.print(",");
-  Serial1.print(yMotorSpeedStepsPerS);
-  Serial1.print("\r\n");
-  Serial1.flush();
+  char cmd[STM32_CMD_MAX];
+  snprintf(cmd, sizeof(cmd), "$SY%d,%ld,%ld", yMotorDir, yMotorDistanceSteps, yMotorSpeedStepsPerS);
+  stm32LinkSend(cmd);
 
   Serial.print("Y Motor Move: $SY");
   Serial.print(yMotorDir);
@@ -1227,6 +1458,8 @@ void sendYMotorMove() {
 
 // CVR 1-2 Motor test ekrani: Test / Cikis
 void drawCVRMotorScreen() {
+  if (drawMotorTestProgress(MOTOR_AXIS_CVR)) return;
+
   display.clearDisplay();
   drawHeader("CVR 1-2 Motor Test");
 
@@ -1248,11 +1481,9 @@ void drawCVRMotorScreen() {
 }
 
 void sendCVRMotorEnable(int motor, bool enable) {
-  Serial1.print("$S");
-  Serial1.print(motor);
-  Serial1.print(enable ? "E" : "D");
-  Serial1.print("\r\n");
-  Serial1.flush();
+  char cmd[STM32_CMD_MAX];
+  snprintf(cmd, sizeof(cmd), "$S%d%c", motor, enable ? 'E' : 'D');
+  stm32LinkSend(cmd);
   Serial.print("CVR");
   Serial.print(motor);
   Serial.print(" Enable: $S");
@@ -1261,10 +1492,9 @@ void sendCVRMotorEnable(int motor, bool enable) {
 }
 
 void sendCVRMotorStop(int motor) {
-  Serial1.print("$S");
-  Serial1.print(motor);
-  Serial1.print("P\r\n");
-  Serial1.flush();
+  char cmd[STM32_CMD_MAX];
+  snprintf(cmd, sizeof(cmd), "$S%dP", motor);
+  stm32LinkSend(cmd);
   Serial.print("CVR");
   Serial.print(motor);
   Serial.println(" Stop");
@@ -1272,15 +1502,10 @@ void sendCVRMotorStop(int motor) {
 
 void sendCVRMotorMove(int motor) {
   // Format: $S<MotorNo><yon>,<mesafe>,<hiz>\r\n
-  Serial1.print("$S");
-  Serial1.print(motor);
-  Serial1.print(cvrMotorDir[motor]);
-  Serial1.print(",");
-  Serial1.print(cvrMotorDistanceSteps[motor]);
-  Serial1.print(",");
-  Serial1.print(cvrMotorSpeedStepsPerS[motor]);
-  Serial1.print("\r\n");
-  Serial1.flush();
+  char cmd[STM32_CMD_MAX];
+  snprintf(cmd, sizeof(cmd), "$S%d%d,%ld,%ld", motor, cvrMotorDir[motor],
+           cvrMotorDistanceSteps[motor], cvrMotorSpeedStepsPerS[motor]);
+  stm32LinkSend(cmd);
 
   Serial.print("CVR");
   Serial.print(motor);
@@ -1296,22 +1521,19 @@ void sendCVRMotorMove(int motor) {
 
 // --- Projeksiyon (LED) ---
 void sendProjeksiyonOn() {
-  Serial1.print("$P1\r\n");
-  Serial1.flush();
+  stm32LinkSend("$P1");
   Serial.println("Projeksiyon: $P1\\r\\n (LED ON)");
 }
 
 void sendProjeksiyonOff() {
-  Serial1.print("$P0\r\n");
-  Serial1.flush();
+  stm32LinkSend("$P0");
   Serial.println("Projeksiyon: $P0\\r\\n (LED OFF)");
 }
 
 void sendProjeksiyonCurrent() {
-  Serial1.print("$PC");
-  Serial1.print(projeksiyonAkim);
-  Serial1.print("\r\n");
-  Serial1.flush();
+  char cmd[STM32_CMD_MAX];
+  snprintf(cmd, sizeof(cmd), "$PC%d", projeksiyonAkim);
+  stm32LinkSend(cmd);
   Serial.print("Projeksiyon Akim: $PC");
   Serial.print(projeksiyonAkim);
   Serial.println("\\r\\n");
@@ -1325,7 +1547,9 @@ void drawProjeksiyonScreen() {
   display.setTextSize(1);
   display.setCursor(0, 16);
   display.print("Durum: ");
-  if (projectorHasResult) {
+  if (testRunnerBusy(projectorTest)) {
+    display.print("TESTING");
+  } else if (projectorHasResult) {
     display.print(projectorStatusSuccess ? "SUCCESS" : "FAIL");
   } else {
     display.print("BEKLEME");
@@ -1360,6 +1584,113 @@ void drawProjeksiyonScreen() {
   display.display();
 }
 
+// Projeksiyon testi: $PF -> PROJECTOR_TEST_OFF_MS -> $I (projektoru de ayarlar) ->
+// PROJECTOR_TEST_CONFIG_MS -> $X, projector_sensor_status == 0 ise SUCCESS. Bekletmez;
+// adimlar updateProjectorTest() ile ilerler.
+static bool projectorTestOff(int) {
+  stm32LinkSend("$PF");
+  Serial.println("Projeksiyon TEST: $PF\\r\\n (OFF)");
+  return true;
+}
+
+static bool projectorTestConfig(int) {
+  sendGestureInit();
+  return true;
+}
+
+static void onProjectorStatusReply(const char* line, void* ctx) {
+  int ntcDummy = 0, irDummy = 0;
+  // Sonuc cevap aninda alinir (baska testin $X cevabi global durumu sonradan ezebilir)
+  projectorStatusOk = parseSensorStatusLine(line, ntcDummy, irDummy) && projector_sensor_status == 0;
+  projectorStatusDone = true;
+}
+
+static bool requestProjectorStatus(int) {
+  projectorStatusDone = false;
+  projectorStatusOk   = false;
+  return stm32LinkRequest(STM32_REQ_STATUS, "$X", READ_TIMEOUT_MS, onProjectorStatusReply);
+}
+
+static float projectorTestStatusDone(int) {
+  return projectorStatusDone ? 1.0f : 0.0f;
+}
+
+static bool projectorTestStatusOk(int) {
+  return projectorStatusOk;
+}
+
+static constexpr TestStep projectorTestSteps[] = {
+  testAction(projectorTestOff),    testWait(PROJECTOR_TEST_OFF_MS),
+  testAction(projectorTestConfig), testWait(PROJECTOR_TEST_CONFIG_MS),
+  testAction(requestProjectorStatus),
+  testWaitUntil(projectorTestStatusDone, 0, TEST_STATUS_REPLY_MS, "STATUS"),
+  testAction(projectorTestStatusOk, 0, "FAIL")
+};
+
+void startProjectorTest() {
+  projectorHasResult     = false;
+  projectorStatusSuccess = false;
+  testRunnerStart(projectorTest, projectorTestSteps);
+  testRunnerTick(projectorTest, millis());
+  drawTestScreen(MENU_PROJEKSIYON);
+}
+
+void updateProjectorTest() {
+  if (!testRunnerTick(projectorTest, millis())) return;
+  projectorHasResult     = true;
+  projectorStatusSuccess = (projectorTest.state == TEST_RUN_PASS);
+  drawTestScreen(MENU_PROJEKSIYON);
+}
+
+// Gesture testi: $I (sensoru yeniden ayarla) -> GESTURE_INIT_SETTLE_MS -> $X,
+// gesture_sensor_status == 0 ise SUCCESS. Bekletmez; adimlar updateGestureTest() ile ilerler.
+static bool gestureTestConfig(int) {
+  sendGestureInit();
+  return true;
+}
+
+static void onGestureStatusReply(const char* line, void* ctx) {
+  int ntcDummy = 0, irDummy = 0;
+  gestureStatusOk = parseSensorStatusLine(line, ntcDummy, irDummy) && gesture_sensor_status == 0;
+  gestureStatusDone = true;
+}
+
+static bool requestGestureStatus(int) {
+  gestureStatusDone = false;
+  gestureStatusOk   = false;
+  return stm32LinkRequest(STM32_REQ_STATUS, "$X", READ_TIMEOUT_MS, onGestureStatusReply);
+}
+
+static float gestureTestStatusDone(int) {
+  return gestureStatusDone ? 1.0f : 0.0f;
+}
+
+static bool gestureTestStatusOk(int) {
+  return gestureStatusOk;
+}
+
+static constexpr TestStep gestureTestSteps[] = {
+  testAction(gestureTestConfig), testWait(GESTURE_INIT_SETTLE_MS),
+  testAction(requestGestureStatus),
+  testWaitUntil(gestureTestStatusDone, 0, TEST_STATUS_REPLY_MS, "STATUS"),
+  testAction(gestureTestStatusOk, 0, "FAIL")
+};
+
+void startGestureTest() {
+  gestureHasResult     = false;
+  gestureStatusSuccess = false;
+  testRunnerStart(gestureTest, gestureTestSteps);
+  testRunnerTick(gestureTest, millis());
+  drawTestScreen(MENU_GESTURE);
+}
+
+void updateGestureTest() {
+  if (!testRunnerTick(gestureTest, millis())) return;
+  gestureHasResult     = true;
+  gestureStatusSuccess = (gestureTest.state == TEST_RUN_PASS);
+  drawTestScreen(MENU_GESTURE);
+}
+
 static const char* getFanTestPhaseLabel(FanTestPhase phase) {
   if (phase == FAN_TEST_RAMP_UP) return "YUKSEL";
   if (phase == FAN_TEST_MEASURE) return "OLCUM";
@@ -1367,163 +1698,106 @@ static const char* getFanTestPhaseLabel(FanTestPhase phase) {
   return "BEKLEME";
 }
 
-static void setIntakeFanFailLabel(bool f1Fail, bool f2Fail) {
-  if (f1Fail && f2Fail) {
-    snprintf(intakeFanFailLabel, sizeof(intakeFanFailLabel), "F1 + F2");
-  } else if (f1Fail) {
-    snprintf(intakeFanFailLabel, sizeof(intakeFanFailLabel), "F1");
-  } else if (f2Fail) {
-    snprintf(intakeFanFailLabel, sizeof(intakeFanFailLabel), "F2");
-  } else {
-    intakeFanFailLabel[0] = '\0';
-  }
-}
-
-static void resetIntakeFanState() {
-  intakeFanSelection = 0;
-  intakeFanTestRunning = false;
-  intakeFanHasResult = false;
-  intakeFanStatusSuccess = false;
-  intakeFanTestPhase = FAN_TEST_IDLE;
-  intakeFanPhaseStartMs = 0;
-  intakeFanLastStepMs = 0;
-  intakeFanFailLabel[0] = '\0';
-  fanSpeedPercent = 0;
-  fanSpeedSent = false;
-  intake1_fan_error = 0;
-  intake2_fan_error = 0;
-  intake1_fan_raw = 0.0f;
-  intake2_fan_raw = 0.0f;
-}
-
-static void failIntakeFanTest(bool f1Fail, bool f2Fail) {
-  intakeFanTestRunning = false;
-  intakeFanHasResult = true;
-  intakeFanStatusSuccess = false;
-  intakeFanTestPhase = FAN_TEST_IDLE;
-  setIntakeFanFailLabel(f1Fail, f2Fail);
-  fanSpeedPercent = 0;
-  sendIntakeFanCommand();
-  drawIntakeFanScreen();
-}
-
-static void resetExhaustFanState() {
-  exhaustFanSelection = 0;
-  exhaustFanTestRunning = false;
-  exhaustFanHasResult = false;
-  exhaustFanStatusSuccess = false;
-  exhaustFanTestPhase = FAN_TEST_IDLE;
-  exhaustFanPhaseStartMs = 0;
-  exhaustFanLastStepMs = 0;
-  exhaustFanFailLabel[0] = '\0';
-  exhaustFanSpeedPercent = 0;
-  exhaustFanSpeedSent = false;
-  exhaust_fan_error = 0;
-  exhaust_fan_raw = 0.0f;
-}
-
-static void failExhaustFanTest(const char* label) {
-  exhaustFanTestRunning = false;
-  exhaustFanHasResult = true;
-  exhaustFanStatusSuccess = false;
-  exhaustFanTestPhase = FAN_TEST_IDLE;
-  snprintf(exhaustFanFailLabel, sizeof(exhaustFanFailLabel), "%s", label);
-  exhaustFanSpeedPercent = 0;
-  sendExhaustFanCommand();
-  drawExhaustFanScreen();
-}
-
-void drawIntakeFanScreen() {
+// Menu ekranina ait fan grubu (fan ekrani degilse -1)
+static int fanGroupForMenu(MenuState menu) {
+  for (int g = 0; g < FAN_GROUP_COUNT; g++) {
+    if (fanGroups[g].menu == menu) return g;
+  }
+  return -1;
+}
+
+static void resetFanGroupState(FanGroupId g) {
+  FanGroupState &st = fanGroupStates[g];
+  const FanGroup &group = fanGroups[g];
+  st.selection = 0;
+  testRunnerAbort(st.test);
+  st.hasResult = false;
+  st.statusSuccess = false;
+  st.failLabel[0] = '\0';
+  st.speedPercent = 0;
+  st.speedSent = false;
+  for (int n = 0; n < group.channelCount; n++) {
+    *group.channels[n].error = 0;
+    *group.channels[n].rpm = 0.0f;
+  }
+}
+
+// Fan ekrani (intake / exhaust ortak): test suruyorsa hiz, faz ve kanal RPM'leri
+static void drawFanScreen(FanGroupId g) {
+  const FanGroupState &st = fanGroupStates[g];
+  const FanGroup &group = fanGroups[g];
+  char title[24];
   display.clearDisplay();
-  if (intakeFanTestRunning) {
-    drawHeader("INTAKE TEST");
+  if (testRunnerBusy(st.test)) {
+    snprintf(title, sizeof(title), "%s TEST", group.title);
+    drawHeader(title);
     display.setTextSize(2);
     display.setCursor(0, 16);
-    display.print(fanSpeedPercent);
+    display.print(st.speedPercent);
     display.setTextSize(1);
     display.print("%");
     display.setCursor(78, 16);
-    display.print(getFanTestPhaseLabel(intakeFanTestPhase));
+    display.print(getFanTestPhaseLabel((FanTestPhase)st.test.phase));
 
-    drawProgressBar(0, 32, 128, fanSpeedPercent);
+    drawProgressBar(0, 32, 128, st.speedPercent);
 
     display.setCursor(0, 42);
-    display.print("F1:");
-    display.print(intake1_fan_raw, 0);
-    display.print("  F2:");
-    display.print(intake2_fan_raw, 0);
+    if (group.channelCount == 1) {
+      display.print("RPM: ");
+      display.print(*group.channels[0].rpm, 0);
+    } else {
+      for (int n = 0; n < group.channelCount; n++) {
+        if (n > 0) display.print("  ");
+        display.print(group.channels[n].label);
+        display.print(":");
+        display.print(*group.channels[n].rpm, 0);
+      }
+    }
 
     display.setCursor(0, 52);
     display.print("RPM min ");
     display.print((int)FAN_TEST_MIN_RPM);
-  } else if (intakeFanHasResult) {
-    drawHeader("INTAKE TEST");
+  } else if (st.hasResult) {
+    snprintf(title, sizeof(title), "%s TEST", group.title);
+    drawHeader(title);
     display.setTextSize(2);
-    drawCenteredText(intakeFanStatusSuccess ? 24 : 16, intakeFanStatusSuccess ? "SUCCESS" : "FAIL", 2);
+    drawCenteredText(st.statusSuccess ? 24 : 16, st.statusSuccess ? "SUCCESS" : "FAIL", 2);
     display.setTextSize(1);
-    if (!intakeFanStatusSuccess && intakeFanFailLabel[0]) {
-      drawCenteredText(38, intakeFanFailLabel, 1);
+    if (!st.statusSuccess && st.failLabel[0]) {
+      drawCenteredText(38, st.failLabel, 1);
     }
     display.setCursor(0, 56);
     display.print("Buton: Menu");
   } else {
-    drawHeader("INTAKE FAN");
+    snprintf(title, sizeof(title), "%s FAN", group.title);
+    drawHeader(title);
     display.setTextSize(1);
     display.setCursor(0, 26);
-    display.print(intakeFanSelection == 0 ? ">" : " ");
+    display.print(st.selection == 0 ? ">" : " ");
     display.print(" Test Et");
     display.setCursor(0, 38);
-    display.print(intakeFanSelection == 1 ? ">" : " ");
+    display.print(st.selection == 1 ? ">" : " ");
     display.print(" Cikis");
   }
   display.display();
 }
 
-void drawExhaustFanScreen() {
-  display.clearDisplay();
-  if (exhaustFanTestRunning) {
-    drawHeader("EXHAUST TEST");
-    display.setTextSize(2);
-    display.setCursor(0, 16);
-    display.print(exhaustFanSpeedPercent);
-    display.setTextSize(1);
-    display.print("%");
-    display.setCursor(78, 16);
-    display.print(getFanTestPhaseLabel(exhaustFanTestPhase));
+void drawIntakeFanScreen()  { drawFanScreen(FAN_GROUP_INTAKE); }
+void drawExhaustFanScreen() { drawFanScreen(FAN_GROUP_EXHAUST); }
 
-    drawProgressBar(0, 32, 128, exhaustFanSpeedPercent);
+void drawRGBLedScreen() {
+  display.clearDisplay();
 
-    display.setCursor(0, 42);
-    display.print("RPM: ");
-    display.print(exhaust_fan_raw, 0);
-    display.setCursor(0, 52);
-    display.print("RPM min ");
-    display.print((int)FAN_TEST_MIN_RPM);
-  } else if (exhaustFanHasResult) {
-    drawHeader("EXHAUST TEST");
-    display.setTextSize(2);
-    drawCenteredText(exhaustFanStatusSuccess ? 24 : 16, exhaustFanStatusSuccess ? "SUCCESS" : "FAIL", 2);
+  if (testRunnerBusy(rgbLedTest)) {
+    drawHeader("RGB LED TEST");
+    drawCenteredText(32, rgbTestLabel, 2);
     display.setTextSize(1);
-    if (!exhaustFanStatusSuccess && exhaustFanFailLabel[0]) {
-      drawCenteredText(38, exhaustFanFailLabel, 1);
-    }
     display.setCursor(0, 56);
-    display.print("Buton: Menu");
-  } else {
-    drawHeader("EXHAUST FAN");
-    display.setTextSize(1);
-    display.setCursor(0, 26);
-    display.print(exhaustFanSelection == 0 ? ">" : " ");
-    display.print(" Test Et");
-    display.setCursor(0, 38);
-    display.print(exhaustFanSelection == 1 ? ">" : " ");
-    display.print(" Cikis");
+    display.print("Buton: Iptal");
+    display.display();
+    return;
   }
-  display.display();
-}
 
-void drawRGBLedScreen() {
-  display.clearDisplay();
   drawHeader("RGB LED");
 
   // Basit RGB test menusu: LED Test / Cikis
@@ -1543,14 +1817,9 @@ void drawRGBLedScreen() {
 // RGB LED komutunu gonder
 void sendRGBLedCommand() {
   // Format: $LA320,100,100\r\n ($ + LA + Hue,Saturation,Value)
-  Serial1.print("$LA");
-  Serial1.print(rgbHue);
-  Serial1.print(",");
-  Serial1.print(rgbSaturation);
-  Serial1.print(",");
-  Serial1.print(rgbValue);
-  Serial1.print("\r\n");
-  Serial1.flush();
+  char cmd[STM32_CMD_MAX];
+  snprintf(cmd, sizeof(cmd), "$LA%d,%d,%d", rgbHue, rgbSaturation, rgbValue);
+  stm32LinkSend(cmd);
   Serial.print("Gonderildi: $LA");
   Serial.print(rgbHue);
   Serial.print(",");
@@ -1562,228 +1831,334 @@ void sendRGBLedCommand() {
   rgbCommandSent = true;
 }
 
-// RGB LED test sekansi: Kirmizi, Yesil, Mavi (2 tur) + Rainbow
-void runRGBLedTest() {
-  // Yardimci lambda: belirli bir rengi yak ve ekranda ortali yaz
-  auto showColor = [](int hue, int sat, int val, const char* label) {
-    rgbHue        = hue;
-    rgbSaturation = sat;
-    rgbValue      = val;
-    sendRGBLedCommand();
+// Belirli bir rengi yak (test ekrani periyodik yenilemede rgbTestLabel ile cizilir)
+static void showRGBTestColor(int hue, int sat, int val, const char* label) {
+  rgbHue        = hue;
+  rgbSaturation = sat;
+  rgbValue      = val;
+  sendRGBLedCommand();
+  rgbTestLabel = label;
+}
+
+// RGB LED test adimi: tek renk (arg = hue: 0 KIRMIZI, 120 YESIL, 240 MAVI)
+static bool showRGBTestStepColor(int hue) {
+  showRGBTestColor(hue, 100, 100, hue == 0 ? "KIRMIZI" : (hue == 120 ? "YESIL" : "MAVI"));
+  drawTestScreen(MENU_RGB_LED);
+  return true;
+}
 
-    display.clearDisplay();
-    drawHeader("RGB LED TEST");
-    drawCenteredText(32, label, 2);
-    display.display();
-  };
-
-  // 2 tur: KIRMIZI -> YESIL -> MAVI
-  for (int cycle = 0; cycle < 2; ++cycle) {
-    showColor(0,   100, 100, "KIRMIZI");
-    delay(1000);
-    showColor(120, 100, 100, "YESIL");
-    delay(1000);
-    showColor(240, 100, 100, "MAVI");
-    delay(1000);
-  }
-
-  // Rainbow gecisi: 5 saniye boyunca Hue 0-360 arasi don
-  unsigned long start = millis();
-  while (millis() - start < 5000) {
-    unsigned long t = millis() - start;
-    float progress = (float)t / 5000.0f;
-    int hue = (int)(progress * 360.0f);
-    if (hue > 360) hue = 360;
-
-    rgbHue        = hue;
-    rgbSaturation = 100;
-    rgbValue      = 100;
-    sendRGBLedCommand();
+// Rainbow adimi: arg 0 = basla (Hue 0), 1 = sonraki ton. RGB_TEST_RAINBOW_MS boyunca Hue 0-360.
+static bool showRGBTestRainbow(int advance) {
+  rgbTestRainbowStep = advance ? rgbTestRainbowStep + 1 : 0;
+  int hue = (int)((float)rgbTestRainbowStep * RGB_TEST_RAINBOW_STEP_MS / (float)RGB_TEST_RAINBOW_MS * 360.0f);
+  if (hue > 360) hue = 360;
+  showRGBTestColor(hue, 100, 100, "RAINBOW");
+  if (!advance) drawTestScreen(MENU_RGB_LED);
+  return true;
+}
 
-    display.clearDisplay();
-    drawHeader("RGB LED TEST");
-    drawCenteredText(32, "RAINBOW", 2);
-    display.display();
+// RGB LED test sekansi: Kirmizi, Yesil, Mavi (2 tur) + Rainbow.
+static constexpr TestStep rgbLedTestSteps[] = {
+  testAction(showRGBTestStepColor, 0),   testWait(RGB_TEST_COLOR_MS),
+  testAction(showRGBTestStepColor, 120), testWait(RGB_TEST_COLOR_MS),
+  testAction(showRGBTestStepColor, 240), testWait(RGB_TEST_COLOR_MS),
+  testRepeat(6, 1),
+  testAction(showRGBTestRainbow, 0),
+  testWait(RGB_TEST_RAINBOW_STEP_MS), testAction(showRGBTestRainbow, 1),
+  testRepeat(2, RGB_TEST_RAINBOW_MS / RGB_TEST_RAINBOW_STEP_MS - 1),
+  testWait(RGB_TEST_RAINBOW_MS % RGB_TEST_RAINBOW_STEP_MS)
+};
 
-    delay(80);
-  }
+// Adimlar updateRGBLedTest() ile ilerler; buton testi keser.
+void startRGBLedTest() {
+  testRunnerStart(rgbLedTest, rgbLedTestSteps);
+  testRunnerTick(rgbLedTest, millis());
+}
 
-  // Test sonunda RGB LED'i sondur
+static void finishRGBLedTest() {
+  // Test sonunda (veya iptalde) RGB LED'i sondur ve menü ekranina geri don
+  testRunnerAbort(rgbLedTest);
   rgbHue        = 0;
   rgbSaturation = 0;
   rgbValue      = 0;
   sendRGBLedCommand();
-
-  // Test bittikten sonra menü ekranina geri don
-  drawRGBLedScreen();
+  drawTestScreen(MENU_RGB_LED);
 }
 
-// Ortak yardimci: verilen parametrelerle Z motoru bir tur dondur
-// NOT: Enable/disable disaridan kontrol edilir; burada sadece move ve bekleme yapilir.
-static void zMotorMoveOneTurn(int dir, int speedStepsPerS) {
-  zMotorDir            = dir;
-  zMotorDistanceSteps  = Z_MOTOR_TURN_STEPS; // 1 tur (Z icin)
-  zMotorSpeedStepsPerS = speedStepsPerS;
-  sendZMotorMove();
-  // Tahmini sure: mesafe / hiz (s) + pay
-  unsigned long moveMs = (unsigned long)(((unsigned long)Z_MOTOR_TURN_STEPS * 1000UL) / (unsigned long)speedStepsPerS) + 300;
-  delay(moveMs);
+void updateRGBLedTest() {
+  if (testRunnerTick(rgbLedTest, millis())) finishRGBLedTest();
 }
 
-void runZMotorTest() {
-  display.clearDisplay();
-  drawHeader("Z Motor Test");
-  drawCenteredText(32, "TESTING...", 2);
-  display.display();
+// --- Z / Y / CVR 1-2 motor testleri ---
+// Her eksenin testi bir adim tablosudur: stop -> enable -> (hareket -> bekle [-> stop] -> bosluk) x N,
+// bitiste stop + disable. Hareketin bitisi $A motor mesgul bitinden okunur (eski STM32 yazilimi:
+// mesafe / hiz + pay olarak tahmin edilir). Her eksenin runner'i ayridir, eksenler ayni anda
+// test edilebilir ("Tumunu Test Et"). Adimlar updateMotorTest() ile ilerler; bu sirada telemetri
+// okunur ve ekranda TMC stop bitleri canli gorulur. Buton testi keser.
+struct MotorTestMove {
+  int           dir;             // 0: sola, 1: saga
+  long          steps;           // mikrostep
+  long          speedStepsPerS;  // mikrostep/s
+};
 
-  // Test baslangicinda once durdur, sonra enable et
-  sendZMotorStop();
-  delay(100);
-  sendZMotorEnable(true);
-  delay(150);
-
-  // Her fazda: bir tur bir yönde, sonra dur/boşluk, sonra bir tur diger yönde
-
-  // Düsük hiz
-  zMotorMoveOneTurn(1, 400);   // saga 1 tur
-  sendZMotorStop();            // harekete net bir stop
-  delay(800);                  // bosluk
-  zMotorMoveOneTurn(0, 400);   // sola 1 tur
-  sendZMotorStop();
-  delay(1200);
-
-  // Orta hiz
-  zMotorMoveOneTurn(1, 800);
-  sendZMotorStop();
-  delay(800);
-  zMotorMoveOneTurn(0, 800);
-  sendZMotorStop();
-  delay(1200);
-
-  // Yüksek hiz
-  zMotorMoveOneTurn(1, 1600);
-  sendZMotorStop();
-  delay(800);
-  zMotorMoveOneTurn(0, 1600);
-
-  sendZMotorStop();
-  sendZMotorEnable(false);
+// Tahmini hareket suresi: mesafe / hiz (s) + pay
+constexpr unsigned long motorTestMoveMs(const MotorTestMove &move, unsigned long marginMs) {
+  return (unsigned long)((move.steps * 1000L) / move.speedStepsPerS) + marginMs;
+}
 
-  // Test bitti: ekrani guncelle
-  drawZMotorScreen();
+static int motorTestBusyMask(MotorTestAxis axis) {
+  if (axis == MOTOR_AXIS_Z) return STM32_MOTOR_BUSY_Z;
+  if (axis == MOTOR_AXIS_Y) return STM32_MOTOR_BUSY_Y;
+  return STM32_MOTOR_BUSY_CVR1 | STM32_MOTOR_BUSY_CVR2;
 }
 
-// Ortak yardimci: verilen parametrelerle Y motoru bir tur dondur
-// NOT: Enable/disable disaridan kontrol edilir; burada sadece move ve bekleme yapilir.
-static void yMotorMoveOneTurn(int dir, int speedStepsPerS) {
-  yMotorDir            = dir;
-  yMotorDistanceSteps  = 1600; // 1 tur
-  yMotorSpeedStepsPerS = speedStepsPerS;
-  sendYMotorMove();
-  unsigned long moveMs = (unsigned long)((1600UL * 1000UL) / (unsigned long)speedStepsPerS) + 300;
-  delay(moveMs);
+// Hareket bitti mi: STM32 mesgul bitini gonderiyorsa hareket komutundan en az
+// MOTOR_BUSY_LATENCY_MS sonra alinan karede eksenin bitleri temiz olmali (STM32 rampa yapsa da
+// gercek bitis). Mesgul bitini gondermeyen eski yazilimda tahmini sure (estimateMs) beklenir.
+template <MotorTestAxis axis>
+static float motorTestMoveDone(int estimateMs) {
+  unsigned long sentMs = motorTestMoveSentMs[axis];
+  if (!motorBusyReported) {
+    return (millis() - sentMs >= (unsigned long)estimateMs) ? 1.0f : 0.0f;
+  }
+  if ((long)(motorBusyFrameMs - sentMs) < MOTOR_BUSY_LATENCY_MS) return 0.0f;
+  return (motor_busy_mask & motorTestBusyMask(axis)) ? 0.0f : 1.0f;
 }
 
-void runYMotorTest() {
-  display.clearDisplay();
-  drawHeader("Y Motor Test");
-  drawCenteredText(32, "TESTING...", 2);
-  display.display();
+// Hareketin bitmesini bekle; 2 x tahmini sure + MOTOR_MOVE_TIMEOUT_MS icinde bitmezse FAIL
+template <MotorTestAxis axis>
+constexpr TestStep motorTestWaitMove(const MotorTestMove &move, unsigned long marginMs) {
+  return testWaitUntil(motorTestMoveDone<axis>, (int)motorTestMoveMs(move, marginMs),
+                       2 * motorTestMoveMs(move, 0) + MOTOR_MOVE_TIMEOUT_MS, "TIMEOUT");
+}
 
-  // Test baslangicinda once durdur, sonra enable et
-  sendYMotorStop();
-  delay(100);
-  sendYMotorEnable(true);
-  delay(150);
+static void sendMotorTestStop(MotorTestAxis axis) {
+  if (axis == MOTOR_AXIS_Z) {
+    sendZMotorStop();
+  } else if (axis == MOTOR_AXIS_Y) {
+    sendYMotorStop();
+  } else {
+    sendCVRMotorStop(1);
+    sendCVRMotorStop(2);
+  }
+}
 
-  // Her fazda: bir tur bir yönde, sonra bir tur diger yönde
+static void sendMotorTestEnable(MotorTestAxis axis, bool enable) {
+  if (axis == MOTOR_AXIS_Z) {
+    sendZMotorEnable(enable);
+  } else if (axis == MOTOR_AXIS_Y) {
+    sendYMotorEnable(enable);
+  } else {
+    sendCVRMotorEnable(1, enable);
+    sendCVRMotorEnable(2, enable);
+  }
+}
 
-  // Düsük hiz
-  yMotorMoveOneTurn(1, 400);   // saga 1 tur
-  delay(1500);
-  yMotorMoveOneTurn(0, 400);   // sola 1 tur
-  delay(2000);
+static void sendMotorTestMove(MotorTestAxis axis, const MotorTestMove &move) {
+  if (axis == MOTOR_AXIS_Z) {
+    zMotorDir            = move.dir;
+    zMotorDistanceSteps  = move.steps;
+    zMotorSpeedStepsPerS = move.speedStepsPerS;
+    sendZMotorMove();
+  } else if (axis == MOTOR_AXIS_Y) {
+    yMotorDir            = move.dir;
+    yMotorDistanceSteps  = move.steps;
+    yMotorSpeedStepsPerS = move.speedStepsPerS;
+    sendYMotorMove();
+  } else {
+    for (int m = 1; m <= 2; ++m) {
+      cvrMotorDir[m]            = move.dir;
+      cvrMotorDistanceSteps[m]  = move.steps;
+      cvrMotorSpeedStepsPerS[m] = move.speedStepsPerS;
+    }
+    // Hareket komutlari ard arda gonderilir (neredeyse eszamanli)
+    sendCVRMotorMove(1);
+    sendCVRMotorMove(2);
+  }
+}
 
-  // Orta hiz
-  yMotorMoveOneTurn(1, 800);
-  delay(1500);
-  yMotorMoveOneTurn(0, 800);
-  delay(2000);
+static void drawMotorTestAxisScreen(MotorTestAxis axis) {
+  if (axis == MOTOR_AXIS_Z) {
+    drawTestScreen(MENU_Z_MOTOR);
+  } else if (axis == MOTOR_AXIS_Y) {
+    drawTestScreen(MENU_Y_MOTOR);
+  } else {
+    drawTestScreen(MENU_CVR_MOTOR);
+  }
+}
 
-  // Yüksek hiz
-  yMotorMoveOneTurn(1, 1600);
-  delay(1500);
-  yMotorMoveOneTurn(0, 1600);
+// Adim eylemleri: eksen sablon parametresidir (her eksenin tablosu kendi eylemlerini kullanir)
+template <MotorTestAxis axis>
+static bool motorTestStop(int) {
+  sendMotorTestStop(axis);
+  return true;
+}
+
+template <MotorTestAxis axis>
+static bool motorTestEnable(int enable) {
+  sendMotorTestEnable(axis, enable != 0);
+  return true;
+}
 
-  sendYMotorStop();
-  sendYMotorEnable(false);
+template <MotorTestAxis axis>
+static bool motorTestMove(int moveIndex);
 
-  // Test bitti: ekrani guncelle
-  drawYMotorScreen();
+// Z: her hizda saga 1 tur, stop, 800 ms, sola 1 tur, stop, 1200 ms
+static constexpr MotorTestMove zMotorTestMoves[] = {
+  { 1, Z_MOTOR_TURN_STEPS, 400 },  { 0, Z_MOTOR_TURN_STEPS, 400 },
+  { 1, Z_MOTOR_TURN_STEPS, 800 },  { 0, Z_MOTOR_TURN_STEPS, 800 },
+  { 1, Z_MOTOR_TURN_STEPS, 1600 }, { 0, Z_MOTOR_TURN_STEPS, 1600 }
+};
+static constexpr TestStep zMotorTestSteps[] = {
+  testAction(motorTestStop<MOTOR_AXIS_Z>),      testWait(MOTOR_TEST_STOP_MS),
+  testAction(motorTestEnable<MOTOR_AXIS_Z>, 1), testWait(MOTOR_TEST_ENABLE_MS),
+  testAction(motorTestMove<MOTOR_AXIS_Z>, 0), motorTestWaitMove<MOTOR_AXIS_Z>(zMotorTestMoves[0], MOTOR_TEST_MARGIN_MS),
+  testAction(motorTestStop<MOTOR_AXIS_Z>),    testWait(800),
+  testAction(motorTestMove<MOTOR_AXIS_Z>, 1), motorTestWaitMove<MOTOR_AXIS_Z>(zMotorTestMoves[1], MOTOR_TEST_MARGIN_MS),
+  testAction(motorTestStop<MOTOR_AXIS_Z>),    testWait(1200),
+  testAction(motorTestMove<MOTOR_AXIS_Z>, 2), motorTestWaitMove<MOTOR_AXIS_Z>(zMotorTestMoves[2], MOTOR_TEST_MARGIN_MS),
+  testAction(motorTestStop<MOTOR_AXIS_Z>),    testWait(800),
+  testAction(motorTestMove<MOTOR_AXIS_Z>, 3), motorTestWaitMove<MOTOR_AXIS_Z>(zMotorTestMoves[3], MOTOR_TEST_MARGIN_MS),
+  testAction(motorTestStop<MOTOR_AXIS_Z>),    testWait(1200),
+  testAction(motorTestMove<MOTOR_AXIS_Z>, 4), motorTestWaitMove<MOTOR_AXIS_Z>(zMotorTestMoves[4], MOTOR_TEST_MARGIN_MS),
+  testAction(motorTestStop<MOTOR_AXIS_Z>),    testWait(800),
+  testAction(motorTestMove<MOTOR_AXIS_Z>, 5), motorTestWaitMove<MOTOR_AXIS_Z>(zMotorTestMoves[5], MOTOR_TEST_MARGIN_MS)
+};
+
+// Y: her hizda saga 1 tur, 1500 ms, sola 1 tur, 2000 ms (hareket arasi stop yok)
+static constexpr MotorTestMove yMotorTestMoves[] = {
+  { 1, 1600, 400 },  { 0, 1600, 400 },
+  { 1, 1600, 800 },  { 0, 1600, 800 },
+  { 1, 1600, 1600 }, { 0, 1600, 1600 }
+};
+static constexpr TestStep yMotorTestSteps[] = {
+  testAction(motorTestStop<MOTOR_AXIS_Y>),      testWait(MOTOR_TEST_STOP_MS),
+  testAction(motorTestEnable<MOTOR_AXIS_Y>, 1), testWait(MOTOR_TEST_ENABLE_MS),
+  testAction(motorTestMove<MOTOR_AXIS_Y>, 0), motorTestWaitMove<MOTOR_AXIS_Y>(yMotorTestMoves[0], MOTOR_TEST_MARGIN_MS), testWait(1500),
+  testAction(motorTestMove<MOTOR_AXIS_Y>, 1), motorTestWaitMove<MOTOR_AXIS_Y>(yMotorTestMoves[1], MOTOR_TEST_MARGIN_MS), testWait(2000),
+  testAction(motorTestMove<MOTOR_AXIS_Y>, 2), motorTestWaitMove<MOTOR_AXIS_Y>(yMotorTestMoves[2], MOTOR_TEST_MARGIN_MS), testWait(1500),
+  testAction(motorTestMove<MOTOR_AXIS_Y>, 3), motorTestWaitMove<MOTOR_AXIS_Y>(yMotorTestMoves[3], MOTOR_TEST_MARGIN_MS), testWait(2000),
+  testAction(motorTestMove<MOTOR_AXIS_Y>, 4), motorTestWaitMove<MOTOR_AXIS_Y>(yMotorTestMoves[4], MOTOR_TEST_MARGIN_MS), testWait(1500),
+  testAction(motorTestMove<MOTOR_AXIS_Y>, 5), motorTestWaitMove<MOTOR_AXIS_Y>(yMotorTestMoves[5], MOTOR_TEST_MARGIN_MS)
+};
+
+// CVR 1-2: iki motor birlikte 40 tur saga, stop, 500 ms, 40 tur sola (hizli mod)
+static constexpr MotorTestMove cvrMotorTestMoves[] = {
+  { 1, 1600L * 40, 4000 }, { 0, 1600L * 40, 4000 }
+};
+static constexpr TestStep cvrMotorTestSteps[] = {
+  testAction(motorTestStop<MOTOR_AXIS_CVR>),      testWait(MOTOR_TEST_STOP_MS),
+  testAction(motorTestEnable<MOTOR_AXIS_CVR>, 1), testWait(MOTOR_TEST_ENABLE_MS),
+  testAction(motorTestMove<MOTOR_AXIS_CVR>, 0), motorTestWaitMove<MOTOR_AXIS_CVR>(cvrMotorTestMoves[0], CVR_MOTOR_TEST_MARGIN_MS),
+  testAction(motorTestStop<MOTOR_AXIS_CVR>),    testWait(500),
+  testAction(motorTestMove<MOTOR_AXIS_CVR>, 1), motorTestWaitMove<MOTOR_AXIS_CVR>(cvrMotorTestMoves[1], CVR_MOTOR_TEST_MARGIN_MS)
+};
+
+struct MotorTestPlan {
+  const char*          title;
+  const MotorTestMove* moves;
+  int                  moveCount;
+  const TestStep*      steps;
+  int                  stepCount;
+};
+
+#define MOTOR_TEST_PLAN(title, moves, steps) \
+  { title, moves, sizeof(moves) / sizeof(moves[0]), steps, sizeof(steps) / sizeof(steps[0]) }
+
+static const MotorTestPlan motorTestPlans[] = {
+  MOTOR_TEST_PLAN("Z Motor Test",       zMotorTestMoves,   zMotorTestSteps),   // MOTOR_AXIS_Z
+  MOTOR_TEST_PLAN("Y Motor Test",       yMotorTestMoves,   yMotorTestSteps),   // MOTOR_AXIS_Y
+  MOTOR_TEST_PLAN("CVR 1-2 Motor Test", cvrMotorTestMoves, cvrMotorTestSteps)  // MOTOR_AXIS_CVR
+};
+
+template <MotorTestAxis axis>
+static bool motorTestMove(int moveIndex) {
+  motorTestMoveIndex[axis] = moveIndex;
+  sendMotorTestMove(axis, motorTestPlans[axis].moves[moveIndex]);
+  motorTestMoveSentMs[axis] = millis();
+  drawMotorTestAxisScreen(axis);
+  return true;
 }
 
-// CVR 1-2 motorlari icin ortak: verilen hizla N tur saga veya sola
-static void cvrMotorsMoveTurnsBoth(int dir, int turns, int speedStepsPerS) {
-  long totalSteps = 1600L * (long)turns;
-  for (int m = 1; m <= 2; ++m) {
-    cvrMotorDir[m]            = dir;
-    cvrMotorDistanceSteps[m]  = totalSteps;
-    cvrMotorSpeedStepsPerS[m] = speedStepsPerS;
-  }
-  // Hareket komutlari ard arda gonderilir (neredeyse eszamanli)
-  sendCVRMotorMove(1);
-  sendCVRMotorMove(2);
-  unsigned long moveMs = (unsigned long)((totalSteps * 1000L) / (long)speedStepsPerS) + 500;
-  delay(moveMs);
+static void startMotorTest(MotorTestAxis axis) {
+  const MotorTestPlan &plan = motorTestPlans[axis];
+  motorTestMoveIndex[axis] = 0;
+  testRunnerStart(motorTests[axis], plan.steps, plan.stepCount);
+  testRunnerTick(motorTests[axis], millis());
+  drawMotorTestAxisScreen(axis);
 }
 
-void runCVRMotorTest() {
-  display.clearDisplay();
-  drawHeader("CVR 1-2 Motor Test");
-  drawCenteredText(32, "TESTING...", 2);
-  display.display();
+void startZMotorTest()   { startMotorTest(MOTOR_AXIS_Z); }
+void startYMotorTest()   { startMotorTest(MOTOR_AXIS_Y); }
+void startCVRMotorTest() { startMotorTest(MOTOR_AXIS_CVR); }
 
-  // Baslangicta stop + enable
-  sendCVRMotorStop(1);
-  sendCVRMotorStop(2);
-  delay(100);
-  sendCVRMotorEnable(1, true);
-  sendCVRMotorEnable(2, true);
-  delay(150);
+static void finishMotorTest(MotorTestAxis axis) {
+  testRunnerAbort(motorTests[axis]);
+  sendMotorTestStop(axis);
+  sendMotorTestEnable(axis, false);
+  // Test bitti: ekrani guncelle
+  drawMotorTestAxisScreen(axis);
+}
 
-  // HIZLI MOD: 40 tur saga, sonra 40 tur sola (her iki motor birlikte)
-  int fastSpeed = 4000; // biraz daha hizli
+void updateMotorTest() {
+  unsigned long now = millis();
+  for (int a = 0; a < MOTOR_AXIS_COUNT; a++) {
+    MotorTestAxis axis = (MotorTestAxis)a;
+    if (!testRunnerTick(motorTests[axis], now)) continue;
+    if (motorTests[axis].state == TEST_RUN_FAIL) {
+      Serial.print(motorTestPlans[axis].title);
+      Serial.print(": hareket ");
+      Serial.print(motorTestMoveIndex[axis] + 1);
+      Serial.println(" zaman asimi (mesgul biti temizlenmedi)");
+    }
+    finishMotorTest(axis);
+  }
+}
 
-  // 40 tur saga
-  cvrMotorsMoveTurnsBoth(1, 40, fastSpeed);
-  sendCVRMotorStop(1);
-  sendCVRMotorStop(2);
-  delay(500);
+static void abortMotorTest(MotorTestAxis axis) {
+  finishMotorTest(axis);
+}
 
-  // 40 tur sola
-  cvrMotorsMoveTurnsBoth(0, 40, fastSpeed);
-  sendCVRMotorStop(1);
-  sendCVRMotorStop(2);
+// Test sirasindaki ekran: faz, hareket no, hiz ve ilgili TMC stop bitleri
+static bool drawMotorTestProgress(MotorTestAxis axis) {
+  if (!testRunnerBusy(motorTests[axis])) return false;
 
-  // Test sonunda motorlari disable et
-  sendCVRMotorEnable(1, false);
-  sendCVRMotorEnable(2, false);
+  const MotorTestPlan &plan = motorTestPlans[axis];
+  int moveIndex = motorTestMoveIndex[axis];
+  display.clearDisplay();
+  drawHeader(plan.title);
+  drawCenteredText(18, "TESTING...", 2);
 
-  // Test bitti: ekrani guncelle
-  drawCVRMotorScreen();
+  display.setTextSize(1);
+  char buf[24];
+  const MotorTestMove &move = plan.moves[moveIndex < plan.moveCount ? moveIndex : plan.moveCount - 1];
+  snprintf(buf, sizeof(buf), "%d/%d %s %ld", moveIndex + 1, plan.moveCount,
+           move.dir ? "SAG" : "SOL", move.speedStepsPerS);
+  display.setCursor(0, 36);
+  display.print(buf);
+
+  if (axis == MOTOR_AXIS_Z) {
+    snprintf(buf, sizeof(buf), "Z_R:%d", z_tmc_status_stop_r);
+  } else if (axis == MOTOR_AXIS_Y) {
+    snprintf(buf, sizeof(buf), "Y_R:%d Y_L:%d", y_tmc_status_stop_r, y_tmc_status_stop_l);
+  } else {
+    snprintf(buf, sizeof(buf), "C1:%d%d C2:%d%d", cvr1_tmc_status_stop_r, cvr1_tmc_status_stop_l,
+             cvr2_tmc_status_stop_r, cvr2_tmc_status_stop_l);
+  }
+  display.setCursor(0, 46);
+  display.print(buf);
+  display.setCursor(0, 56);
+  display.print("Buton: Iptal");
+  display.display();
+  return true;
 }
 
 // Gesture sensör konfigürasyon komutu ($I)
 void sendGestureInit() {
-  Serial1.print("$I\r\n");
-  Serial1.flush();
+  stm32LinkSend("$I");
   Serial.println("Gesture init: $I\\r\\n");
 }
 
-static void sendLoadcellConfig() {
-  sendGestureInit();
-  delay(500);
-}
 
 static int getLoadcellFaultMask(float v1, float v2, float v3, float v4) {
   int faultMask = 0;
@@ -1794,72 +2169,61 @@ static int getLoadcellFaultMask(float v1, float v2, float v3, float v4) {
   return faultMask;
 }
 
-// $Wn komutu ile n. loadcell degerini oku (gram, ornek: $-152.28)
-static bool readLoadcellValue(int n, float &out) {
-  while (Serial1.available()) Serial1.read();
-  Serial1.print("$W");
-  Serial1.print(n);
-  Serial1.print("\r\n");
-  Serial1.flush();
-  delay(15);
-
-  char buffer[24];
-  int index = 0;
-  unsigned long startTime = millis();
-  while (millis() - startTime < READ_TIMEOUT_MS && index < (int)sizeof(buffer) - 1) {
-    if (Serial1.available()) {
-      char c = Serial1.read();
-      if (c == '\r' || c == '\n') {
-        if (index > 0) {
-          buffer[index] = '\0';
-          if (buffer[0] == '$') {
-            out = atof(buffer + 1);
-            return true;
-          }
-          return false;
-        }
-      } else if (c >= 32 && c < 127) {
-        buffer[index++] = c;
-      }
-    }
-  }
-  return false;
+// $Wn cevabi (gram, ornek: $-152.28)
+struct LoadcellReply {
+  float value;
+  bool  ok;
+  bool  done;
+};
+
+bool parseLoadcellLine(const char* line, float &value) {
+  int32_t raw[1];
+  if (stm32ParseFields(line, loadcellSchema, raw) != 1) return false;
+  value = stm32FieldValue(loadcellSchema[0], raw[0]);
+  return true;
 }
 
-static bool readAllLoadcellValues(float &v1, float &v2, float &v3, float &v4, int *readFaultMask = nullptr) {
-  int faultMask = 0;
-  bool allReadOk = true;
-  float tmp = 0.0f;
+static void onLoadcellReply(const char* line, void* ctx) {
+  LoadcellReply* reply = (LoadcellReply*)ctx;
+  if (parseLoadcellLine(line, reply->value)) reply->ok = true;
+  reply->done = true;
+}
 
-  if (readLoadcellValue(1, tmp)) {
-    v1 = tmp;
-  } else {
-    faultMask |= 1 << 0;
-    allReadOk = false;
-  }
-  delay(100);
+// Son $W1..$W4 okumasinin cevaplari (istekler yoldayken gecerli kalmasi icin statik)
+static LoadcellReply loadcellReplies[4];
 
-  if (readLoadcellValue(2, tmp)) {
-    v2 = tmp;
-  } else {
-    faultMask |= 1 << 1;
-    allReadOk = false;
+// $W1..$W4 ard arda gonderilir (4 istek ayni anda yolda); cevaplar geldikce sirayla eslenir
+static void startLoadcellRead() {
+  for (int n = 0; n < 4; n++) {
+    loadcellReplies[n].value = 0.0f;
+    loadcellReplies[n].ok    = false;
+    loadcellReplies[n].done  = false;
+    char cmd[8];
+    snprintf(cmd, sizeof(cmd), "$W%d", n + 1);
+    stm32LinkRequest(STM32_REQ_LOADCELL, cmd, READ_TIMEOUT_MS, onLoadcellReply, &loadcellReplies[n]);
   }
-  delay(100);
+}
 
-  if (readLoadcellValue(3, tmp)) {
-    v3 = tmp;
-  } else {
-    faultMask |= 1 << 2;
-    allReadOk = false;
+static bool loadcellReadDone() {
+  for (int n = 0; n < 4; n++) {
+    if (!loadcellReplies[n].done) return false;
   }
-  delay(100);
+  return true;
+}
 
-  if (readLoadcellValue(4, tmp)) {
-    v4 = tmp;
-  } else {
-    faultMask |= 1 << 3;
-    allReadOk = false;
+// Tamamlanan okumanin degerlerini al (okunamayan kanallar eski degerini korur)
+static bool finishLoadcellRead(float &v1, float &v2, float &v3, float &v4, int *readFaultMask = nullptr) {
+  const LoadcellReply* replies = loadcellReplies;
+  float* outs[4] = { &v1, &v2, &v3, &v4 };
+  int faultMask = 0;
+  bool allReadOk = true;
+  for (int n = 0; n < 4; n++) {
+    if (replies[n].ok) {
+      *outs[n] = replies[n].value;
+    } else {
+      faultMask |= 1 << n;
+      allReadOk = false;
+    }
   }
 
   if (readFaultMask != nullptr) {
@@ -1876,341 +2240,731 @@ static void resetLoadcellTestState() {
   loadcell2_g = 0.0f;
   loadcell3_g = 0.0f;
   loadcell4_g = 0.0f;
-  lastLoadcellUpdate = 0;
+  schedulerRunAfter(loadcellJob, 0);
 }
 
-void runLoadcellTest() {
-  // Her yeni test sifirdan baslasin
-  resetLoadcellTestState();
+static bool loadcellValuesReady(const float* v) {
+  for (int n = 0; n < 4; n++) {
+    if (v[n] < -LOADCELL_POST_TARE_READY_G || v[n] > LOADCELL_POST_TARE_READY_G) return false;
+  }
+  return true;
+}
 
-  // Butona basar basmaz ekranda TARE goster (tare suresi boyunca ekranda kalacak)
-  display.clearDisplay();
-  drawHeader("Loadcell");
-  display.setTextSize(2);
-  drawCenteredText(32, "TARE...", 2);
-  display.display();
+static void onLoadcellStatusReply(const char* line, void* ctx) {
+  int ntcDummy = 0, irDummy = 0;
+  loadcellStatusOk = parseSensorStatusLine(line, ntcDummy, irDummy);
+  // Baska bir testin $X cevabi global durumu sonradan ezebilir: bu cevaptaki degeri sakla
+  loadcellForceStatus = force_sensor_status;
+  loadcellStatusDone = true;
+}
 
-  for (int attempt = 0; attempt < 2; attempt++) {
-    // 1) Her test baslangicinda konfig gonder
-    sendLoadcellConfig();
+static void setLoadcellTestPhase(LoadcellTestPhase phase, unsigned long now) {
+  loadcellTestPhase = phase;
+  loadcellPhaseStartMs = now;
+}
 
-    // 2) $X ile force_sensor_status kontrolu
-    int ntcDummy = 0, irDummy = 0;
-    if (!getSensorStatus(ntcDummy, irDummy) || force_sensor_status == 1) {
-      if (attempt == 0) {
-        delay(300);
-        continue;
-      }
-      loadcellErrorType = (force_sensor_status == 1) ? 1 : 0;
-      loadcellScreenMode = 2;
-      drawLoadcellScreen();
+// Sonuc / HATA ekranindan menuye donus: konfig gonder, LOADCELL_CONFIG_MS bekleme bir faz
+// (loop beklemez). Bu sirada baslatilan test $I'yi yeniden gondermez, kalan sureyi bekler.
+static void sendLoadcellConfig() {
+  sendGestureInit();
+  loadcellReadPending = false;
+  setLoadcellTestPhase(LOADCELL_TEST_SETTLE, millis());
+}
+
+// Sonuc ekrani yenilemesi: $X temizse $W1..$W4 okumasini baslat, force hatasinda HATA ekrani
+static void loadcellRefreshStatusDone(unsigned long now) {
+  if (!loadcellStatusOk || loadcellForceStatus == 1) {
+    // Loadcell sensorde hata olursa hemen HATA ekranina gec
+    loadcellTestPhase = LOADCELL_TEST_IDLE;
+    loadcellErrorType = (loadcellForceStatus == 1) ? 1 : 0;
+    loadcellScreenMode = 2;
+    drawTestScreen(MENU_LOADCELL);
+    return;
+  }
+  startLoadcellRead();
+  loadcellReadPending = true;
+  setLoadcellTestPhase(LOADCELL_REFRESH_READ, now);
+}
+
+// Sonuc ekrani yenilemesi: okunan 4 degeri goster, okunamayan / sinir disi kanalda HATA
+static void loadcellRefreshReadDone() {
+  loadcellReadPending = false;
+  loadcellTestPhase = LOADCELL_TEST_IDLE;
+  float v1 = loadcell1_g;
+  float v2 = loadcell2_g;
+  float v3 = loadcell3_g;
+  float v4 = loadcell4_g;
+  int readFaultMask = 0;
+
+  if (finishLoadcellRead(v1, v2, v3, v4, &readFaultMask)) {
+    loadcell1_g = v1;
+    loadcell2_g = v2;
+    loadcell3_g = v3;
+    loadcell4_g = v4;
+    screenNeedsUpdate = true;
+  } else {
+    loadcellErrorType = 0;
+    loadcellFaultMask = readFaultMask | getLoadcellFaultMask(v1, v2, v3, v4);
+    loadcellScreenMode = 2;
+    drawTestScreen(MENU_LOADCELL);
+  }
+}
+
+// Test sonu: HATA ekrani (errorType 1: amplifier kart, 0: genel / faultMask'teki kanallar)
+static void failLoadcellTest(int errorType, int faultMask) {
+  loadcellTestPhase = LOADCELL_TEST_IDLE;
+  loadcellErrorType = errorType;
+  loadcellFaultMask = faultMask;
+  loadcellScreenMode = 2;
+  drawTestScreen(MENU_LOADCELL);
+}
+
+// Deneme basarisiz: ilk denemeyse LOADCELL_RETRY_MS sonra bastan, degilse HATA
+static void retryLoadcellTest(unsigned long now) {
+  if (loadcellTestAttempt == 0) {
+    setLoadcellTestPhase(LOADCELL_TEST_RETRY, now);
+  } else {
+    failLoadcellTest(0, 0);
+  }
+}
+
+// TARE suresi doldu (veya okuma basarisiz): okunan degerlerle karar ver
+static void finishLoadcellTare(unsigned long now) {
+  if (loadcellHasValidRead) {
+    const float* v = loadcellTestValues;
+    int faultMask = loadcellObservedFaultMask | getLoadcellFaultMask(v[0], v[1], v[2], v[3]);
+    if (faultMask != 0) {
+      failLoadcellTest(0, faultMask);
       return;
     }
+  }
+  retryLoadcellTest(now);
+}
 
-    // TARE komutunu gonder
-    Serial1.print("$WT\r\n");
-    Serial1.flush();
+// Dogrulama turlari bitti: hatasizsa son okunan degerler sonuc ekraninda gosterilir
+static void finishLoadcellValidate() {
+  if (loadcellObservedFaultMask != 0) {
+    failLoadcellTest(0, loadcellObservedFaultMask);
+    return;
+  }
+  loadcellTestPhase = LOADCELL_TEST_IDLE;
+  loadcellFaultMask = 0;
+  loadcell1_g = loadcellTestValues[0];
+  loadcell2_g = loadcellTestValues[1];
+  loadcell3_g = loadcellTestValues[2];
+  loadcell4_g = loadcellTestValues[3];
 
-    float v1 = 0.0f, v2 = 0.0f, v3 = 0.0f, v4 = 0.0f;
-    bool  hasValidRead = false;
-    int   observedFaultMask = 0;
+  loadcellScreenMode = 1;
+  schedulerRunAfter(loadcellJob, LOADCELL_UPDATE_MS);
+  drawTestScreen(MENU_LOADCELL);
+}
 
-    // Ilk gecici/yuksek degerler ekrana dusmesin diye, degerler makul seviyeye
-    // gelene kadar TARE... ekraninda beklemeye devam et.
-    unsigned long tareWaitStart = millis();
-    bool valuesReady = false;
+// Loadcell testi: $I -> 500ms -> $X -> $WT -> degerler makul seviyeye inene kadar oku ->
+// LOADCELL_VALIDATE_ROUNDS tur dogrula. Basarisiz ilk denemeden sonra bir kez daha denenir.
+// Adimlar updateLoadcellTest() ile ilerler; TARE ekraninda buton testi keser.
+void startLoadcellTest() {
+  // Her yeni test sifirdan baslasin
+  resetLoadcellTestState();
 
-    while ((millis() - tareWaitStart) < LOADCELL_TARE_WAIT_MS) {
+  // Butona basar basmaz ekranda TARE goster (tare suresi boyunca ekranda kalacak)
+  loadcellScreenMode = 3;
+  drawTestScreen(MENU_LOADCELL);
+
+  loadcellTestAttempt = 0;
+  // 1) Her test baslangicinda konfig gonder (menuye donuste gonderilen $I'nin suresi
+  // dolmadiysa o devralinir)
+  if (loadcellTestPhase == LOADCELL_TEST_SETTLE) {
+    loadcellTestPhase = LOADCELL_TEST_CONFIG;
+  } else {
+    sendGestureInit();
+    setLoadcellTestPhase(LOADCELL_TEST_CONFIG, millis());
+  }
+}
+
+void updateLoadcellTest() {
+  if (loadcellTestPhase == LOADCELL_TEST_IDLE) return;
+
+  unsigned long now = millis();
+  float* v = loadcellTestValues;
+
+  if (loadcellTestPhase == LOADCELL_TEST_CONFIG) {
+    // 2) $X ile force_sensor_status kontrolu (cevap onLoadcellStatusReply'da)
+    if (now - loadcellPhaseStartMs < LOADCELL_CONFIG_MS) return;
+    loadcellStatusDone = false;
+    loadcellStatusOk = false;
+    loadcellForceStatus = 0;
+    stm32LinkRequest(STM32_REQ_STATUS, "$X", READ_TIMEOUT_MS, onLoadcellStatusReply);
+    setLoadcellTestPhase(LOADCELL_TEST_STATUS, now);
+  } else if (loadcellTestPhase == LOADCELL_TEST_STATUS) {
+    if (!loadcellStatusDone) return;
+    if (!loadcellStatusOk || loadcellForceStatus == 1) {
+      if (loadcellTestAttempt == 0) {
+        setLoadcellTestPhase(LOADCELL_TEST_RETRY, now);
+      } else {
+        failLoadcellTest((loadcellForceStatus == 1) ? 1 : 0, 0);
+      }
+      return;
+    }
+    // TARE komutunu gonder; ilk gecici/yuksek degerler ekrana dusmesin diye degerler
+    // makul seviyeye gelene kadar TARE... ekraninda beklemeye devam et
+    stm32LinkSend("$WT");
+    for (int n = 0; n < 4; n++) v[n] = 0.0f;
+    loadcellHasValidRead = false;
+    loadcellObservedFaultMask = 0;
+    loadcellTareStartMs = now;
+    startLoadcellRead();
+    loadcellReadPending = true;
+    setLoadcellTestPhase(LOADCELL_TEST_TARE, now);
+  } else if (loadcellTestPhase == LOADCELL_TEST_TARE) {
+    if (loadcellReadPending) {
+      if (!loadcellReadDone()) return;
+      loadcellReadPending = false;
       int readFaultMask = 0;
-      bool readOk = readAllLoadcellValues(v1, v2, v3, v4, &readFaultMask);
-      observedFaultMask |= readFaultMask;
+      bool readOk = finishLoadcellRead(v[0], v[1], v[2], v[3], &readFaultMask);
+      loadcellObservedFaultMask |= readFaultMask;
       if (!readOk && readFaultMask == 0) {
-        break;
+        finishLoadcellTare(now);
+        return;
       }
-      hasValidRead = true;
-
-      valuesReady =
-        (v1 >= -LOADCELL_POST_TARE_READY_G && v1 <= LOADCELL_POST_TARE_READY_G) &&
-        (v2 >= -LOADCELL_POST_TARE_READY_G && v2 <= LOADCELL_POST_TARE_READY_G) &&
-        (v3 >= -LOADCELL_POST_TARE_READY_G && v3 <= LOADCELL_POST_TARE_READY_G) &&
-        (v4 >= -LOADCELL_POST_TARE_READY_G && v4 <= LOADCELL_POST_TARE_READY_G);
-
-      if (valuesReady) {
-        int faultMask = 0;
-
-        // Sonucu gostermeden once 5 tur daha kontrol et; TARE... ekranda kalmaya devam eder.
-        for (int round = 0; round < LOADCELL_VALIDATE_ROUNDS; round++) {
-          int readFaultMask = 0;
-          bool readOk = readAllLoadcellValues(v1, v2, v3, v4, &readFaultMask);
-          faultMask |= readFaultMask;
-          if (!readOk && readFaultMask == 0) {
-            break;
-          }
-          faultMask |= getLoadcellFaultMask(v1, v2, v3, v4);
-
-          if (round < (LOADCELL_VALIDATE_ROUNDS - 1)) {
-            delay(LOADCELL_POST_TARE_RETRY_DELAY_MS);
-          }
-        }
-
-        if (faultMask != 0) {
-          loadcellErrorType = 0;
-          loadcellFaultMask = faultMask;
-          loadcellScreenMode = 2;
-          drawLoadcellScreen();
-          return;
-        }
-
-        // Son okunan degerleri global degiskenlere yaz
-        loadcellFaultMask = 0;
-        loadcell1_g = v1;
-        loadcell2_g = v2;
-        loadcell3_g = v3;
-        loadcell4_g = v4;
-
-        loadcellScreenMode = 1;
-        lastLoadcellUpdate = millis();
-        drawLoadcellScreen();
+      loadcellHasValidRead = true;
+      if (loadcellValuesReady(v)) {
+        // Sonucu gostermeden once LOADCELL_VALIDATE_ROUNDS tur daha kontrol et
+        loadcellValidateRound = 0;
+        loadcellObservedFaultMask = 0;
+        startLoadcellRead();
+        loadcellReadPending = true;
+        setLoadcellTestPhase(LOADCELL_TEST_VALIDATE, now);
         return;
       }
-
-      delay(LOADCELL_POST_TARE_RETRY_DELAY_MS);
+      loadcellPhaseStartMs = now;  // sonraki okuma LOADCELL_POST_TARE_RETRY_DELAY_MS sonra
+    } else if (now - loadcellTareStartMs >= LOADCELL_TARE_WAIT_MS) {
+      finishLoadcellTare(now);
+    } else if (now - loadcellPhaseStartMs >= LOADCELL_POST_TARE_RETRY_DELAY_MS) {
+      startLoadcellRead();
+      loadcellReadPending = true;
     }
-
-    if (hasValidRead) {
-      int faultMask = observedFaultMask | getLoadcellFaultMask(v1, v2, v3, v4);
-      if (faultMask != 0) {
-        loadcellErrorType = 0;
-        loadcellFaultMask = faultMask;
-        loadcellScreenMode = 2;
-        drawLoadcellScreen();
+  } else if (loadcellTestPhase == LOADCELL_TEST_VALIDATE) {
+    if (loadcellReadPending) {
+      if (!loadcellReadDone()) return;
+      loadcellReadPending = false;
+      int readFaultMask = 0;
+      bool readOk = finishLoadcellRead(v[0], v[1], v[2], v[3], &readFaultMask);
+      loadcellObservedFaultMask |= readFaultMask;
+      if (!readOk && readFaultMask == 0) {
+        finishLoadcellValidate();
         return;
       }
+      loadcellObservedFaultMask |= getLoadcellFaultMask(v[0], v[1], v[2], v[3]);
+      if (++loadcellValidateRound >= LOADCELL_VALIDATE_ROUNDS) {
+        finishLoadcellValidate();
+        return;
+      }
+      loadcellPhaseStartMs = now;
+    } else if (now - loadcellPhaseStartMs >= LOADCELL_POST_TARE_RETRY_DELAY_MS) {
+      startLoadcellRead();
+      loadcellReadPending = true;
     }
+  } else if (loadcellTestPhase == LOADCELL_TEST_RETRY) {
+    if (now - loadcellPhaseStartMs < LOADCELL_RETRY_MS) return;
+    loadcellTestAttempt++;
+    sendGestureInit();
+    setLoadcellTestPhase(LOADCELL_TEST_CONFIG, now);
+  } else if (loadcellTestPhase == LOADCELL_TEST_SETTLE) {
+    if (now - loadcellPhaseStartMs >= LOADCELL_CONFIG_MS) loadcellTestPhase = LOADCELL_TEST_IDLE;
+  } else if (loadcellTestPhase == LOADCELL_REFRESH_STATUS) {
+    if (loadcellStatusDone) loadcellRefreshStatusDone(now);
+  } else if (loadcellTestPhase == LOADCELL_REFRESH_READ) {
+    if (loadcellReadDone()) loadcellRefreshReadDone();
+  }
+}
+
+static void abortLoadcellTest() {
+  // Yoldaki $W/$X cevaplari statik kayitlara yazilir, yeni test bunlari sifirlar
+  loadcellTestPhase = LOADCELL_TEST_IDLE;
+  loadcellReadPending = false;
+  resetLoadcellTestState();
+  loadcellScreenMode = 0;
+  loadcellSelection  = 0;
+  drawTestScreen(MENU_LOADCELL);
+}
+
+// --- Fan testleri (tum gruplar icin tek motor) ---
+// Adim tablosu: $X ile durum kontrolu -> %10'luk adimlarla %100'e cik -> RPM oturana kadar olc ->
+// $X + kanal basina hata / RPM kontrolu (ornekleme + esik adimlari) -> %10'luk adimlarla dur.
+// Eylemler grubu sablon parametresi olarak alir; her grubun runner'i ve $X kaydi ayridir,
+// gruplar ayni anda calisir.
+// Cikista her adimin RPM'i kaydedilir (RPM / duty egrisi, test sonunda Serial'e yazilir).
+
+// Grubun tum kanallarina hiz komutu: $F<n><hiz>, hiz = yuzde * 1999 / 100 (0-1999 arasi)
+static void sendFanGroupCommand(FanGroupId g) {
+  FanGroupState &st = fanGroupStates[g];
+  const FanGroup &group = fanGroups[g];
+  int speedValue = (st.speedPercent * 1999) / 100;
+
+  // Kanal komutlari ard arda kuyruga girer (arada bekleme yok, sira korunur)
+  for (int n = 0; n < group.channelCount; n++) {
+    char cmd[STM32_CMD_MAX];
+    snprintf(cmd, sizeof(cmd), "$F%d%d", group.channels[n].number, speedValue);
+    stm32LinkSend(cmd);
+    Serial.print("Gonderildi: ");
+    Serial.print(cmd);
+    Serial.println("\\r\\n");
+  }
+
+  st.speedSent = true;
+  st.lastCommandMs = millis();
+}
 
-    if (attempt == 0) {
-      delay(300);
+// $X cevabi: kanal hata bitleri cevap aninda grubun kaydina alinir (diger grubun veya
+// baska bir testin $X cevabi global hata bitlerini sonradan ezebilir)
+static void onFanStatusReply(const char* line, void* ctx) {
+  FanGroupState* st = (FanGroupState*)ctx;
+  const FanGroup &group = fanGroups[st - fanGroupStates];
+  int ntcDummy = 0, irDummy = 0;
+  st->statusOk = parseSensorStatusLine(line, ntcDummy, irDummy);
+  st->statusErrorMask = 0;
+  for (int n = 0; n < group.channelCount; n++) {
+    if (*group.channels[n].error != 0) st->statusErrorMask |= 1 << n;
+  }
+  st->statusDone = true;
+}
+
+template <FanGroupId g>
+static bool fanTestRequestStatus(int) {
+  FanGroupState &st = fanGroupStates[g];
+  st.statusDone = false;
+  st.statusOk   = false;
+  return stm32LinkRequest(STM32_REQ_STATUS, "$X", READ_TIMEOUT_MS, onFanStatusReply, &st);
+}
+
+template <FanGroupId g>
+static float fanTestStatusDone(int) {
+  return fanGroupStates[g].statusDone ? 1.0f : 0.0f;
+}
+
+template <FanGroupId g>
+static bool fanTestStatusOk(int) {
+  return fanGroupStates[g].statusOk;
+}
+
+// Egri noktasi: duty'de son $A karesindeki kanal RPM'leri
+static void recordFanCurvePoint(FanGroupId g, int duty, const float* rpm) {
+  FanGroupState &st = fanGroupStates[g];
+  int point = duty / 10;
+  if (point < 0 || point >= FAN_CURVE_POINTS) return;
+  for (int n = 0; n < fanGroups[g].channelCount; n++) st.curve[point][n] = rpm[n];
+  st.curveMask |= 1 << point;
+}
+
+static void printFanCurve(FanGroupId g) {
+  const FanGroupState &st = fanGroupStates[g];
+  const FanGroup &group = fanGroups[g];
+  if (st.curveMask == 0) return;
+  Serial.printf("%s RPM egrisi (olcum %lu ms%s)\n", group.title, st.settleMs,
+                st.settleCapped ? ", ust sinir" : "");
+  for (int point = 0; point < FAN_CURVE_POINTS; point++) {
+    if (!(st.curveMask & (1 << point))) continue;
+    Serial.printf("  %3d%%", point * 10);
+    for (int n = 0; n < group.channelCount; n++) {
+      Serial.printf("  %s:%.0f", group.channels[n].label, st.curve[point][n]);
     }
+    Serial.println();
   }
+}
 
-  loadcellErrorType = 0;
-  loadcellScreenMode = 2;
-  drawLoadcellScreen();
+template <FanGroupId g>
+static bool fanTestStepSpeed(int deltaPercent) {
+  FanGroupState &st = fanGroupStates[g];
+  // Cikista her kademe FAN_TEST_STEP_MS surdu: kademenin RPM'i egriye
+  if (deltaPercent > 0 && testRunnerBusy(st.test)) {
+    float rpm[FAN_GROUP_MAX_CHANNELS];
+    for (int n = 0; n < fanGroups[g].channelCount; n++) rpm[n] = *fanGroups[g].channels[n].rpm;
+    recordFanCurvePoint(g, st.speedPercent, rpm);
+  }
+  st.speedPercent += deltaPercent;
+  if (st.speedPercent < 0) st.speedPercent = 0;
+  if (st.speedPercent > 100) st.speedPercent = 100;
+  sendFanGroupCommand(g);
+  drawTestScreen(fanGroups[g].menu);
+  return true;
 }
 
-// Intake fan komutlarini gonder
-void sendIntakeFanCommand() {
-  // Format: $F1550\r\n ($ + F + fan_no + hiz)
-  // Hiz: yuzde * 1999 / 100 (0-1999 arasi)
-  int fanSpeedValue = (fanSpeedPercent * 1999) / 100;
-  
-  // Fan 1 icin komut gonder
-  Serial1.print("$F1");
-  Serial1.print(fanSpeedValue);
-  Serial1.print("\r\n");
-  Serial1.flush();
-  Serial.print("Gonderildi: $F1");
-  Serial.print(fanSpeedValue);
-  Serial.println("\\r\\n");
-  
-  delay(25); // F1/F2 arasi kisa gecikme
-  
-  // Fan 2 icin komut gonder
-  Serial1.print("$F2");
-  Serial1.print(fanSpeedValue);
-  Serial1.print("\r\n");
-  Serial1.flush();
-  Serial.print(" $F2");
-  Serial.print(fanSpeedValue);
-  Serial.println("\\r\\n");
-  
-  fanSpeedSent = true;
-  lastIntakeFanCommandMs = millis();
+// Olcum fazi baslangici: pencereler bos, ilk ornek bir sonraki $A karesinden
+template <FanGroupId g>
+static bool fanTestBeginMeasure(int) {
+  FanGroupState &st = fanGroupStates[g];
+  for (int n = 0; n < FAN_GROUP_MAX_CHANNELS; n++) {
+    steadyWindowReset(st.settle[n], FAN_SETTLE_WINDOW);
+  }
+  st.settleSeq = lastTelemetrySeq;
+  st.settleStartMs = millis();
+  st.settleMs = 0;
+  st.settleCapped = false;
+  return true;
 }
 
-// Exhaust fan komutunu gonder
-void sendExhaustFanCommand() {
-  // Format: $F31000\r\n ($ + F + 3 + hiz)
-  // Hiz: yuzde * 1999 / 100 (0-1999 arasi)
-  int exhaustFanSpeedValue = (exhaustFanSpeedPercent * 1999) / 100;
-  
-  // Exhaust fan icin komut gonder
-  Serial1.print("$F3");
-  Serial1.print(exhaustFanSpeedValue);
-  Serial1.print("\r\n");
-  Serial1.flush();
-  Serial.print("Gonderildi: $F3");
-  Serial.print(exhaustFanSpeedValue);
-  Serial.println("\\r\\n");
-  
-  exhaustFanSpeedSent = true;
-  lastExhaustFanCommandMs = millis();
-}
-
-void startIntakeFanTest() {
-  int ntcDummy = 0;
-  int irDummy  = 0;
-
-  intakeFanTestRunning = false;
-  intakeFanHasResult = false;
-  intakeFanStatusSuccess = false;
-  intakeFanFailLabel[0] = '\0';
-  intake1_fan_error = 0;
-  intake2_fan_error = 0;
-  intake1_fan_raw = 0.0f;
-  intake2_fan_raw = 0.0f;
-  fanSpeedPercent = 0;
-  sendIntakeFanCommand();
-  delay(40);
-
-  if (!getSensorStatus(ntcDummy, irDummy)) {
-    failIntakeFanTest(false, false);
-    snprintf(intakeFanFailLabel, sizeof(intakeFanFailLabel), "STATUS");
-    drawIntakeFanScreen();
-    return;
+// Kanalin olcumu bitti mi (pencere dolu olmali):
+//  - penceredeki tum olcumler esigin ustunde ve RPM dusmuyor (beklemek sonucu degistirmez)
+//  - RPM oturmus (egim ve sapma kucuk)
+// Aksi halde hala yukseliyor veya gurultulu. Gecti / kaldi karari adim tablosundaki
+// ornekleme + kontrol adimlarindadir (pencere ortalamasi).
+static bool fanChannelDecided(const SteadyWindow &w) {
+  if (!steadyWindowFull(w)) return false;
+  if (steadyWindowMin(w) >= FAN_TEST_MIN_RPM && steadyWindowSlope(w) >= -FAN_SETTLE_MAX_SLOPE) return true;
+  return steadyWindowSettled(w, FAN_SETTLE_MAX_SLOPE, FAN_SETTLE_MAX_STDDEV);
+}
+
+// Karar aninda: %100 noktasi pencere ortalamasi (pencere bossa son RPM) olarak egriye
+static void finishFanMeasure(FanGroupId g, bool capped) {
+  FanGroupState &st = fanGroupStates[g];
+  const FanGroup &group = fanGroups[g];
+  float rpm[FAN_GROUP_MAX_CHANNELS];
+  for (int n = 0; n < group.channelCount; n++) {
+    rpm[n] = st.settle[n].count > 0 ? steadyWindowMean(st.settle[n]) : *group.channels[n].rpm;
   }
+  recordFanCurvePoint(g, 100, rpm);
+  st.settleMs = millis() - st.settleStartMs;
+  st.settleCapped = capped;
+}
+
+// Her yeni $A karesinde kanal RPM'lerini pencereye ekle; tum kanallar karara vardiginda veya
+// FAN_TEST_SETTLE_MAX_MS dolunca olcum biter (sabit bekleme yok)
+template <FanGroupId g>
+static float fanTestSettled(int) {
+  FanGroupState &st = fanGroupStates[g];
+  const FanGroup &group = fanGroups[g];
+  if (st.settleSeq != lastTelemetrySeq) {
+    st.settleSeq = lastTelemetrySeq;
+    bool decided = true;
+    for (int n = 0; n < group.channelCount; n++) {
+      steadyWindowAdd(st.settle[n], lastTelemetryMs, *group.channels[n].rpm);
+      if (!fanChannelDecided(st.settle[n])) decided = false;
+    }
+    if (decided) {
+      finishFanMeasure(g, false);
+      return 1.0f;
+    }
+  }
+  if (millis() - st.settleStartMs >= FAN_TEST_SETTLE_MAX_MS) {
+    finishFanMeasure(g, true);
+    return 1.0f;
+  }
+  return 0.0f;
+}
+
+// Ornekleme adimlari: kanalin %100'deki RPM'i = oturma penceresi ortalamasi (bossa son RPM)
+template <FanGroupId g>
+static float fanTestChannelRpm(int n) {
+  const FanGroupState &st = fanGroupStates[g];
+  return st.settle[n].count > 0 ? steadyWindowMean(st.settle[n]) : *fanGroups[g].channels[n].rpm;
+}
+
+// Kanalin son test $X cevabindaki hata biti (0 / 1)
+template <FanGroupId g>
+static float fanTestChannelError(int n) {
+  return (fanGroupStates[g].statusErrorMask & (1 << n)) ? 1.0f : 0.0f;
+}
+
+// Tum gruplarda ortak adimlar: $X durum kontrolu, %10 adimlarla %100'e cikis, oturana kadar
+// olcum ve ikinci $X. Ardindan grubun kanal limitleri, en sonda FAN_TEST_RAMP_DOWN_STEPS.
+#define FAN_TEST_MEASURE_STEPS(g) \
+  testAction(fanTestStepSpeed<g>, -100), \
+  testAction(fanTestRequestStatus<g>), testWaitUntil(fanTestStatusDone<g>, 0, TEST_STATUS_REPLY_MS, "STATUS"), \
+  testAction(fanTestStatusOk<g>, 0, "STATUS"), \
+  testPhase(FAN_TEST_RAMP_UP), \
+  testWait(FAN_TEST_STEP_MS), testAction(fanTestStepSpeed<g>, 10), testRepeat(2, 9), \
+  testPhase(FAN_TEST_MEASURE), \
+  testAction(fanTestBeginMeasure<g>), \
+  testWaitUntil(fanTestSettled<g>, 0, FAN_TEST_SETTLE_MAX_MS, "RPM"), \
+  testAction(fanTestRequestStatus<g>), testWaitUntil(fanTestStatusDone<g>, 0, TEST_STATUS_REPLY_MS, "STATUS"), \
+  testAction(fanTestStatusOk<g>, 0, "STATUS")
+
+#define FAN_TEST_RAMP_DOWN_STEPS(g) \
+  testPhase(FAN_TEST_RAMP_DOWN), \
+  testWait(FAN_TEST_STEP_MS), testAction(fanTestStepSpeed<g>, -10), testRepeat(2, 9)
+
+// Kanal limitleri (gruba ozel tarif): $X hata biti 0 ve olcum fazi RPM'i >= FAN_TEST_MIN_RPM.
+// Ilk kalan kontrolun etiketi FAIL ekraninda gosterilir.
+static constexpr TestStep intakeFanTestSteps[] = {
+  FAN_TEST_MEASURE_STEPS(FAN_GROUP_INTAKE),
+  testSample(fanTestChannelError<FAN_GROUP_INTAKE>, 0, 1, 0), testAssert(0.0f, 0.0f, "F1"),
+  testSample(fanTestChannelRpm<FAN_GROUP_INTAKE>, 0, 1, 0),   testAssert(FAN_TEST_MIN_RPM, FLT_MAX, "F1"),
+  testSample(fanTestChannelError<FAN_GROUP_INTAKE>, 1, 1, 0), testAssert(0.0f, 0.0f, "F2"),
+  testSample(fanTestChannelRpm<FAN_GROUP_INTAKE>, 1, 1, 0),   testAssert(FAN_TEST_MIN_RPM, FLT_MAX, "F2"),
+  FAN_TEST_RAMP_DOWN_STEPS(FAN_GROUP_INTAKE)
+};
+
+static constexpr TestStep exhaustFanTestSteps[] = {
+  FAN_TEST_MEASURE_STEPS(FAN_GROUP_EXHAUST),
+  testSample(fanTestChannelError<FAN_GROUP_EXHAUST>, 0, 1, 0), testAssert(0.0f, 0.0f, "EXHAUST"),
+  testSample(fanTestChannelRpm<FAN_GROUP_EXHAUST>, 0, 1, 0),   testAssert(FAN_TEST_MIN_RPM, FLT_MAX, "EXHAUST"),
+  FAN_TEST_RAMP_DOWN_STEPS(FAN_GROUP_EXHAUST)
+};
+
+#define FAN_TEST_STEPS(steps) { steps, (int)(sizeof(steps) / sizeof(steps[0])) }
+
+struct FanTestTable {
+  const TestStep* steps;
+  int             stepCount;
+};
+
+// Grup basina adim tablosu (FanGroupId sirasiyla)
+static const FanTestTable fanTestTables[FAN_GROUP_COUNT] = {
+  FAN_TEST_STEPS(intakeFanTestSteps),   // FAN_GROUP_INTAKE
+  FAN_TEST_STEPS(exhaustFanTestSteps)   // FAN_GROUP_EXHAUST
+};
 
-  intakeFanTestRunning = true;
-  intakeFanHasResult = false;
-  intakeFanTestPhase = FAN_TEST_RAMP_UP;
-  intakeFanPhaseStartMs = millis();
-  intakeFanLastStepMs = intakeFanPhaseStartMs;
-  drawIntakeFanScreen();
+static void startFanTest(FanGroupId g) {
+  FanGroupState &st = fanGroupStates[g];
+  const FanGroup &group = fanGroups[g];
+  st.hasResult = false;
+  st.statusSuccess = false;
+  st.failLabel[0] = '\0';
+  st.curveMask = 0;
+  st.settleMs = 0;
+  st.settleCapped = false;
+  for (int n = 0; n < group.channelCount; n++) {
+    *group.channels[n].error = 0;
+    *group.channels[n].rpm = 0.0f;
+  }
+  testRunnerStart(st.test, fanTestTables[g].steps, fanTestTables[g].stepCount);
+  testRunnerTick(st.test, millis());
+}
+
+// Tum fan gruplarinin testleri tek tick'te ilerler
+void updateFanTests() {
+  unsigned long now = millis();
+  for (int i = 0; i < FAN_GROUP_COUNT; i++) {
+    FanGroupId g = (FanGroupId)i;
+    FanGroupState &st = fanGroupStates[g];
+    if (!testRunnerTick(st.test, now)) continue;
+
+    st.hasResult = true;
+    st.statusSuccess = (st.test.state == TEST_RUN_PASS);
+    if (!st.statusSuccess) {
+      snprintf(st.failLabel, sizeof(st.failLabel), "%s", st.test.failLabel ? st.test.failLabel : "");
+      st.speedPercent = 0;
+      sendFanGroupCommand(g);
+    }
+    printFanCurve(g);
+    drawTestScreen(fanGroups[g].menu);
+  }
 }
 
-void startExhaustFanTest() {
-  int ntcDummy = 0;
-  int irDummy  = 0;
+// Iptal (toplu kosuda): fanlar durdurulur, sonuc yok
+static void abortFanTest(FanGroupId g) {
+  FanGroupState &st = fanGroupStates[g];
+  testRunnerAbort(st.test);
+  st.speedPercent = 0;
+  sendFanGroupCommand(g);
+  drawTestScreen(fanGroups[g].menu);
+}
+
+// NTC testi: sensor bagli degilse hemen FAIL, degilse olcumleri ntcSampler toplar
+static void startNTCTest(bool sensorOk) {
+  if (!sensorOk) {
+    sampleAccumulatorStop(ntcSampler);
+    ntcHasResult     = true;
+    ntcStatusSuccess = false;
+    return;
+  }
+  // Sensor saglam ise NTC testini bastan baslat
+  ntcAverageTemp   = 0.0f;
+  ntcHasResult     = false;
+  ntcStatusSuccess = false;
+  sampleAccumulatorStart(ntcSampler, tempTestMode == TEMP_TEST_SEQUENTIAL, millis());
+}
 
-  exhaustFanTestRunning = false;
-  exhaustFanHasResult = false;
-  exhaustFanStatusSuccess = false;
-  exhaustFanFailLabel[0] = '\0';
-  exhaust_fan_error = 0;
-  exhaust_fan_raw = 0.0f;
-  exhaustFanSpeedPercent = 0;
-  sendExhaustFanCommand();
-  delay(40);
+// NTC ve IR ekranindaki "Mod" satiri: sabit sayi <-> ardisik (iki test ayni modu kullanir)
+static void toggleTempTestMode() {
+  tempTestMode = (tempTestMode == TEMP_TEST_FIXED) ? TEMP_TEST_SEQUENTIAL : TEMP_TEST_FIXED;
+}
 
-  if (!getSensorStatus(ntcDummy, irDummy)) {
-    failExhaustFanTest("STATUS");
+// IR testi: NTC ile ayni akis (resin_temp_raw)
+static void startIRTest(bool sensorOk) {
+  if (!sensorOk) {
+    sampleAccumulatorStop(irSampler);
+    irHasResult     = true;
+    irStatusSuccess = false;
     return;
   }
+  irAverageTemp    = 0.0f;
+  irHasResult      = false;
+  irStatusSuccess  = false;
+  sampleAccumulatorStart(irSampler, tempTestMode == TEMP_TEST_SEQUENTIAL, millis());
+}
+
+// --- Tumunu Test Et ---
+// Operator gerektirmeyen testler tek kosuda, kaynak kilitleriyle ayni anda calisir (gesture
+// sensoru el hareketi istedigi icin disarida). Tablo sirasi baslatma onceligidir: uzun suren
+// eksen testleri once, ayni kaynagi bekleyenler (fren, loadcell: Z) arkalarinda.
+// NTC/IR testi sensor durumunu ($X) beklemeden ister; ornekleme cevap gelince baslar
+// (onSensorStatusReply). Iki test ayni anda baslarsa tek $X ikisine de yeter.
+static void runAllStartNTC() {
+  bool requested = ntcStartOnStatus || irStartOnStatus;
+  ntcStartOnStatus = true;
+  if (!requested) requestSensorStatus();
+}
+static bool runAllNTCBusy()   { return ntcStartOnStatus || sampleAccumulatorRunning(ntcSampler); }
+static bool runAllNTCPassed() { return ntcHasResult && ntcStatusSuccess; }
+static void runAllAbortNTC()  { ntcStartOnStatus = false; sampleAccumulatorStop(ntcSampler); }
+
+static void runAllStartIR() {
+  bool requested = ntcStartOnStatus || irStartOnStatus;
+  irStartOnStatus = true;
+  if (!requested) requestSensorStatus();
+}
+static bool runAllIRBusy()   { return irStartOnStatus || sampleAccumulatorRunning(irSampler); }
+static bool runAllIRPassed() { return irHasResult && irStatusSuccess; }
+static void runAllAbortIR()  { irStartOnStatus = false; sampleAccumulatorStop(irSampler); }
+
+template <FanGroupId g>
+static void runAllStartFan() { startFanTest(g); }
+template <FanGroupId g>
+static bool runAllFanBusy() { return testRunnerBusy(fanGroupStates[g].test); }
+template <FanGroupId g>
+static bool runAllFanPassed() { return fanGroupStates[g].hasResult && fanGroupStates[g].statusSuccess; }
+template <FanGroupId g>
+static void runAllAbortFan() { abortFanTest(g); }
+
+static bool runAllRGBBusy()   { return testRunnerBusy(rgbLedTest); }
+static bool runAllRGBPassed() { return rgbLedTest.state == TEST_RUN_PASS; }
+
+static bool runAllBrakeBusy()   { return testRunnerBusy(brakeMotorTest); }
+static bool runAllBrakePassed() { return brakeMotorTest.state == TEST_RUN_PASS; }
+
+template <MotorTestAxis axis>
+static bool runAllMotorBusy() { return testRunnerBusy(motorTests[axis]); }
+template <MotorTestAxis axis>
+static bool runAllMotorPassed() { return motorTests[axis].state == TEST_RUN_PASS; }
+template <MotorTestAxis axis>
+static void runAllAbortMotor() { abortMotorTest(axis); }
+
+static bool runAllLoadcellBusy()   { return loadcellTestPhase != LOADCELL_TEST_IDLE; }
+static bool runAllLoadcellPassed() { return loadcellScreenMode == 1; }
+
+static bool runAllProjectorBusy()   { return testRunnerBusy(projectorTest); }
+static bool runAllProjectorPassed() { return projectorHasResult && projectorStatusSuccess; }
+static void runAllAbortProjector()  { testRunnerAbort(projectorTest); }
+
+static const TestSuiteEntry runAllTests[] = {
+  { "Z Motor",    TEST_RES_Z_AXIS, startZMotorTest, runAllMotorBusy<MOTOR_AXIS_Z>,
+    runAllMotorPassed<MOTOR_AXIS_Z>, runAllAbortMotor<MOTOR_AXIS_Z> },
+  { "CVR Motor",  TEST_RES_CVR_AXIS, startCVRMotorTest, runAllMotorBusy<MOTOR_AXIS_CVR>,
+    runAllMotorPassed<MOTOR_AXIS_CVR>, runAllAbortMotor<MOTOR_AXIS_CVR> },
+  { "Y Motor",    TEST_RES_Y_AXIS, startYMotorTest, runAllMotorBusy<MOTOR_AXIS_Y>,
+    runAllMotorPassed<MOTOR_AXIS_Y>, runAllAbortMotor<MOTOR_AXIS_Y> },
+  { "Intake",     TEST_RES_INTAKE_FAN, runAllStartFan<FAN_GROUP_INTAKE>, runAllFanBusy<FAN_GROUP_INTAKE>,
+    runAllFanPassed<FAN_GROUP_INTAKE>, runAllAbortFan<FAN_GROUP_INTAKE> },
+  { "Exhaust",    TEST_RES_EXHAUST_FAN, runAllStartFan<FAN_GROUP_EXHAUST>, runAllFanBusy<FAN_GROUP_EXHAUST>,
+    runAllFanPassed<FAN_GROUP_EXHAUST>, runAllAbortFan<FAN_GROUP_EXHAUST> },
+  { "RGB LED",    TEST_RES_RGB_LED, startRGBLedTest, runAllRGBBusy, runAllRGBPassed, finishRGBLedTest },
+  { "NTC",        0, runAllStartNTC, runAllNTCBusy, runAllNTCPassed, runAllAbortNTC },
+  { "IR Temp",    0, runAllStartIR, runAllIRBusy, runAllIRPassed, runAllAbortIR },
+  { "Projection", TEST_RES_SENSOR_CONFIG, startProjectorTest, runAllProjectorBusy,
+    runAllProjectorPassed, runAllAbortProjector },
+  { "Motor Freni", TEST_RES_Z_AXIS, startBrakeMotorTest, runAllBrakeBusy, runAllBrakePassed,
+    abortBrakeMotorTest },
+  { "Loadcell",   TEST_RES_Z_AXIS | TEST_RES_SENSOR_CONFIG, startLoadcellTest, runAllLoadcellBusy,
+    runAllLoadcellPassed, abortLoadcellTest }
+};
+
+#define RUN_ALL_VISIBLE_ROWS 5  // ozet ekraninda ayni anda gorunen test satiri
 
-  exhaustFanTestRunning = true;
-  exhaustFanHasResult = false;
-  exhaustFanTestPhase = FAN_TEST_RAMP_UP;
-  exhaustFanPhaseStartMs = millis();
-  exhaustFanLastStepMs = exhaustFanPhaseStartMs;
-  drawExhaustFanScreen();
+const TestSuiteEntry* runAllEntries(int &count) {
+  count = sizeof(runAllTests) / sizeof(runAllTests[0]);
+  return runAllTests;
 }
 
-void updateIntakeFanTest() {
-  if (!intakeFanTestRunning) return;
+void prepareRunAll() {
+  for (int g = 0; g < FAN_GROUP_COUNT; g++) resetFanGroupState((FanGroupId)g);
+  brakeMotorActive = false;
+  projectorHasResult = false;
+  // NTC/IR baglanti durumu testler baslarken $X ile istenir (runAllStartNTC / runAllStartIR)
+  ntcSensorStatusValid = false;
+  irSensorStatusValid  = false;
+  ntcStartOnStatus     = false;
+  irStartOnStatus      = false;
+}
 
+void startRunAll() {
+  currentMenu = MENU_RUN_ALL;
+  runAllScroll = 0;
+  encoderPos = 0;
+  lastEncoderPos = 0;
+  prepareRunAll();
+  Serial.println("Tumunu Test Et: basladi");
+  testSuiteStart(runAllSuite, runAllTests, millis());
+  testSuiteTick(runAllSuite, millis());
+  drawCurrentScreen();
+}
+
+static void updateRunAll() {
   unsigned long now = millis();
-  if (intakeFanTestPhase == FAN_TEST_RAMP_UP) {
-    if (now - intakeFanLastStepMs >= FAN_TEST_STEP_MS) {
-      intakeFanLastStepMs = now;
-      if (fanSpeedPercent < 100) {
-        fanSpeedPercent += 10;
-        if (fanSpeedPercent > 100) fanSpeedPercent = 100;
-        sendIntakeFanCommand();
-      }
-      if (fanSpeedPercent >= 100) {
-        intakeFanTestPhase = FAN_TEST_MEASURE;
-        intakeFanPhaseStartMs = now;
-      }
-      drawIntakeFanScreen();
-    }
-  } else if (intakeFanTestPhase == FAN_TEST_MEASURE) {
-    if (now - intakeFanPhaseStartMs >= FAN_TEST_SETTLE_MS) {
-      int ntcDummy = 0;
-      int irDummy  = 0;
-      bool gotStatus = getSensorStatus(ntcDummy, irDummy);
-      bool f1Fail = !gotStatus || (intake1_fan_error == 1) || (intake1_fan_raw < FAN_TEST_MIN_RPM);
-      bool f2Fail = !gotStatus || (intake2_fan_error == 1) || (intake2_fan_raw < FAN_TEST_MIN_RPM);
-      if (f1Fail || f2Fail) {
-        failIntakeFanTest(f1Fail, f2Fail);
-        if (!gotStatus) snprintf(intakeFanFailLabel, sizeof(intakeFanFailLabel), "STATUS");
-      } else {
-        intakeFanTestPhase = FAN_TEST_RAMP_DOWN;
-        intakeFanLastStepMs = now;
-      }
-      drawIntakeFanScreen();
-    }
-  } else if (intakeFanTestPhase == FAN_TEST_RAMP_DOWN) {
-    if (now - intakeFanLastStepMs >= FAN_TEST_STEP_MS) {
-      intakeFanLastStepMs = now;
-      if (fanSpeedPercent > 0) {
-        fanSpeedPercent -= 10;
-        if (fanSpeedPercent < 0) fanSpeedPercent = 0;
-        sendIntakeFanCommand();
-      }
-      if (fanSpeedPercent <= 0) {
-        intakeFanTestRunning = false;
-        intakeFanHasResult = true;
-        intakeFanStatusSuccess = true;
-        intakeFanTestPhase = FAN_TEST_IDLE;
-      }
-      drawIntakeFanScreen();
-    }
+  if (!testSuiteTick(runAllSuite, now)) return;
+
+  // Kosu bitti: sonuclari Serial'e de yaz (takt suresi kaydi icin)
+  for (int i = 0; i < runAllSuite.entryCount; i++) {
+    Serial.printf("  %-11s %s %lu ms\n", runAllTests[i].name,
+                  runAllSuite.results[i] == TEST_SUITE_PASS ? "OK" : "FAIL",
+                  runAllSuite.durationMs[i]);
   }
+  Serial.printf("Tumunu Test Et: %d/%d OK, %lu ms\n", testSuiteCount(runAllSuite, TEST_SUITE_PASS),
+                runAllSuite.entryCount, testSuiteElapsedMs(runAllSuite, now));
+  screenNeedsUpdate = true;
+}
+
+static void abortRunAll() {
+  testSuiteAbort(runAllSuite, millis());
+  Serial.println("Tumunu Test Et: iptal");
+  drawTestScreen(MENU_RUN_ALL);
 }
 
-void updateExhaustFanTest() {
-  if (!exhaustFanTestRunning) return;
+static const char* getRunAllResultLabel(TestSuiteResult result) {
+  if (result == TEST_SUITE_RUNNING) return "TEST";
+  if (result == TEST_SUITE_PASS) return "OK";
+  if (result == TEST_SUITE_FAIL) return "FAIL";
+  if (result == TEST_SUITE_ABORTED) return "IPTAL";
+  return "BEKLE";
+}
 
+// Ozet ekrani: baslikta gecen sure ve gecen / toplam, altta test satirlari (encoder ile kaydir)
+void drawRunAllScreen() {
   unsigned long now = millis();
-  if (exhaustFanTestPhase == FAN_TEST_RAMP_UP) {
-    if (now - exhaustFanLastStepMs >= FAN_TEST_STEP_MS) {
-      exhaustFanLastStepMs = now;
-      if (exhaustFanSpeedPercent < 100) {
-        exhaustFanSpeedPercent += 10;
-        if (exhaustFanSpeedPercent > 100) exhaustFanSpeedPercent = 100;
-        sendExhaustFanCommand();
-      }
-      if (exhaustFanSpeedPercent >= 100) {
-        exhaustFanTestPhase = FAN_TEST_MEASURE;
-        exhaustFanPhaseStartMs = now;
-      }
-      drawExhaustFanScreen();
-    }
-  } else if (exhaustFanTestPhase == FAN_TEST_MEASURE) {
-    if (now - exhaustFanPhaseStartMs >= FAN_TEST_SETTLE_MS) {
-      int ntcDummy = 0;
-      int irDummy  = 0;
-      bool gotStatus = getSensorStatus(ntcDummy, irDummy);
-      bool exhFail = !gotStatus || (exhaust_fan_error == 1) || (exhaust_fan_raw < FAN_TEST_MIN_RPM);
-      if (exhFail) {
-        failExhaustFanTest(!gotStatus ? "STATUS" : "EXHAUST");
-      } else {
-        exhaustFanTestPhase = FAN_TEST_RAMP_DOWN;
-        exhaustFanLastStepMs = now;
-      }
-      drawExhaustFanScreen();
-    }
-  } else if (exhaustFanTestPhase == FAN_TEST_RAMP_DOWN) {
-    if (now - exhaustFanLastStepMs >= FAN_TEST_STEP_MS) {
-      exhaustFanLastStepMs = now;
-      if (exhaustFanSpeedPercent > 0) {
-        exhaustFanSpeedPercent -= 10;
-        if (exhaustFanSpeedPercent < 0) exhaustFanSpeedPercent = 0;
-        sendExhaustFanCommand();
-      }
-      if (exhaustFanSpeedPercent <= 0) {
-        exhaustFanTestRunning = false;
-        exhaustFanHasResult = true;
-        exhaustFanStatusSuccess = true;
-        exhaustFanTestPhase = FAN_TEST_IDLE;
-      }
-      drawExhaustFanScreen();
+  display.clearDisplay();
+  display.setTextSize(1);
+
+  char buf[32];  // Uzun sure / sayilar da sigsin (-Wformat-truncation)
+  snprintf(buf, sizeof(buf), "TUMU %lus %d/%d", testSuiteElapsedMs(runAllSuite, now) / 1000,
+           testSuiteCount(runAllSuite, TEST_SUITE_PASS), runAllSuite.entryCount);
+  drawHeader(buf);
+
+  int y = 12;
+  for (int i = runAllScroll; i < runAllSuite.entryCount && i < runAllScroll + RUN_ALL_VISIBLE_ROWS; i++) {
+    TestSuiteResult result = runAllSuite.results[i];
+    display.setCursor(0, y);
+    display.print(runAllTests[i].name);
+    display.setCursor(72, y);
+    display.print(getRunAllResultLabel(result));
+    if (result != TEST_SUITE_PENDING) {
+      unsigned long ms = (result == TEST_SUITE_RUNNING) ? now - runAllSuite.durationMs[i]
+                                                         : runAllSuite.durationMs[i];
+      snprintf(buf, sizeof(buf), "%lus", ms / 1000);
+      display.setCursor(104, y);
+      display.print(buf);
     }
+    y += 9;
   }
+
+  display.setCursor(0, 56);
+  display.print(testSuiteBusy(runAllSuite) ? "Buton: Iptal" : "Buton: Menu");
+  display.display();
 }
 
 void updateMenu() {
+  PROFILE_ZONE(PROFILE_UPDATE_MENU);
   // Encoder ile menü seçimi veya hız ayarlama
+  encoderPos += halInput().takeEncoderSteps();
   if (encoderPos != lastEncoderPos) {
     int rawDiff = encoderPos - lastEncoderPos;
     if (rawDiff > -2 && rawDiff < 2) {
@@ -2222,58 +2976,62 @@ void updateMenu() {
       menuSelection += diff;
       if (menuSelection < 0) menuSelection = menuItemCount - 1;
       if (menuSelection >= menuItemCount) menuSelection = 0;
-      drawMenu();
-      screenNeedsUpdate = false;
-    } else if (currentMenu == MENU_INTAKE_FAN) {
-      if (!intakeFanTestRunning && !intakeFanHasResult) {
-        intakeFanSelection += diff;
-        if (intakeFanSelection < 0) intakeFanSelection = 1;
-        if (intakeFanSelection > 1) intakeFanSelection = 0;
-        drawIntakeFanScreen();
-      }
+      drawCurrentScreen();
       screenNeedsUpdate = false;
-    } else if (currentMenu == MENU_EXHAUST_FAN) {
-      if (!exhaustFanTestRunning && !exhaustFanHasResult) {
-        exhaustFanSelection += diff;
-        if (exhaustFanSelection < 0) exhaustFanSelection = 1;
-        if (exhaustFanSelection > 1) exhaustFanSelection = 0;
-        drawExhaustFanScreen();
+    } else if (fanGroupForMenu(currentMenu) >= 0) {
+      FanGroupId g = (FanGroupId)fanGroupForMenu(currentMenu);
+      FanGroupState &st = fanGroupStates[g];
+      if (!testRunnerBusy(st.test) && !st.hasResult) {
+        st.selection += diff;
+        if (st.selection < 0) st.selection = 1;
+        if (st.selection > 1) st.selection = 0;
+        drawCurrentScreen();
       }
       screenNeedsUpdate = false;
     } else if (currentMenu == MENU_RGB_LED) {
       // RGB LED menusu: LED Test / Cikis
-      rgbMenuSelection += diff;
-      if (rgbMenuSelection < 0) rgbMenuSelection = 1;
-      if (rgbMenuSelection > 1) rgbMenuSelection = 0;
-      drawRGBLedScreen();
+      if (!testRunnerBusy(rgbLedTest)) {
+        rgbMenuSelection += diff;
+        if (rgbMenuSelection < 0) rgbMenuSelection = 1;
+        if (rgbMenuSelection > 1) rgbMenuSelection = 0;
+        drawCurrentScreen();
+      }
       screenNeedsUpdate = false;
     } else if (currentMenu == MENU_BRAKE_MOTOR) {
       // Motor freni ekraninda: Test / Cikis secimi
-      brakeMotorSelection += diff;
-      if (brakeMotorSelection < 0) brakeMotorSelection = 1;
-      if (brakeMotorSelection > 1) brakeMotorSelection = 0;
-      drawBrakeMotorScreen();
+      if (!testRunnerBusy(brakeMotorTest)) {
+        brakeMotorSelection += diff;
+        if (brakeMotorSelection < 0) brakeMotorSelection = 1;
+        if (brakeMotorSelection > 1) brakeMotorSelection = 0;
+        drawCurrentScreen();
+      }
       screenNeedsUpdate = false;
     } else if (currentMenu == MENU_Z_MOTOR) {
       // Z MOTOR test ekraninda: Test / Cikis secimi
-      zMotorTestSelection += diff;
-      if (zMotorTestSelection < 0) zMotorTestSelection = 1;
-      if (zMotorTestSelection > 1) zMotorTestSelection = 0;
-      drawZMotorScreen();
+      if (!testRunnerBusy(motorTests[MOTOR_AXIS_Z])) {
+        zMotorTestSelection += diff;
+        if (zMotorTestSelection < 0) zMotorTestSelection = 1;
+        if (zMotorTestSelection > 1) zMotorTestSelection = 0;
+        drawCurrentScreen();
+      }
       screenNeedsUpdate = false;
     } else if (currentMenu == MENU_Y_MOTOR) {
       // Y MOTOR test ekraninda: Test / Cikis secimi
-      yMotorTestSelection += diff;
-      if (yMotorTestSelection < 0) yMotorTestSelection = 1;
-      if (yMotorTestSelection > 1) yMotorTestSelection = 0;
-      drawYMotorScreen();
+      if (!testRunnerBusy(motorTests[MOTOR_AXIS_Y])) {
+        yMotorTestSelection += diff;
+        if (yMotorTestSelection < 0) yMotorTestSelection = 1;
+        if (yMotorTestSelection > 1) yMotorTestSelection = 0;
+        drawCurrentScreen();
+      }
       screenNeedsUpdate = false;
     } else if (currentMenu == MENU_CVR_MOTOR) {
       // CVR 1-2 MOTOR test ekraninda: Test / Cikis secimi
-      cvrMotorTestSelection += diff;
-      if (cvrMotorTestSelection < 0) cvrMotorTestSelection = 1;
-      if (cvrMotorTestSelection > 1) cvrMotorTestSelection = 0;
-      drawCVRMotorScreen();
+      if (!testRunnerBusy(motorTests[MOTOR_AXIS_CVR])) {
+        cvrMotorTestSelection += diff;
+        if (cvrMotorTestSelection < 0) cvrMotorTestSelection = 1;
+        if (cvrMotorTestSelection > 1) cvrMotorTestSelection = 0;
+        drawCurrentScreen();
+      }
       screenNeedsUpdate = false;
     } else if (currentMenu == MENU_LOADCELL) {
       // Loadcell ekraninda: sadece menu modunda encoder ile secim
@@ -2281,7 +3039,7 @@ void updateMenu() {
         loadcellSelection += diff;
         if (loadcellSelection < 0) loadcellSelection = 1;
         if (loadcellSelection > 1) loadcellSelection = 0;
-        drawLoadcellScreen();
+        drawCurrentScreen();
         screenNeedsUpdate = false;
       }
     } else if (currentMenu == MENU_PROJEKSIYON) {
@@ -2298,23 +3056,23 @@ void updateMenu() {
         if (projectorSelection < 0) projectorSelection = 3;
         if (projectorSelection > 3) projectorSelection = 0;
       }
-      drawProjeksiyonScreen();
+      drawCurrentScreen();
       screenNeedsUpdate = false;
     } else if (currentMenu == MENU_NTC) {
       // NTC ekraninda encoder ile alt secenekler (Test / Cikis) arasında gez
-      if (!ntcTestRunning) {
+      if (!sampleAccumulatorRunning(ntcSampler)) {
         ntcSelection += diff;
-        if (ntcSelection < 0) ntcSelection = 1;
-        if (ntcSelection > 1) ntcSelection = 0;
-        drawNTCScreen();
+        if (ntcSelection < 0) ntcSelection = 2;
+        if (ntcSelection > 2) ntcSelection = 0;
+        drawCurrentScreen();
         screenNeedsUpdate = false;
       }
     } else if (currentMenu == MENU_IR_TEMP) {
-      if (!irTestRunning) {
+      if (!sampleAccumulatorRunning(irSampler)) {
         irSelection += diff;
-        if (irSelection < 0) irSelection = 1;
-        if (irSelection > 1) irSelection = 0;
-        drawIRTempScreen();
+        if (irSelection < 0) irSelection = 2;
+        if (irSelection > 2) irSelection = 0;
+        drawCurrentScreen();
       }
       screenNeedsUpdate = false;
     } else if (currentMenu == MENU_GESTURE) {
@@ -2322,72 +3080,77 @@ void updateMenu() {
       gestureSelection += diff;
       if (gestureSelection < 0) gestureSelection = 1;
       if (gestureSelection > 1) gestureSelection = 0;
-      drawGestureScreen();
+      drawCurrentScreen();
+      screenNeedsUpdate = false;
+    } else if (currentMenu == MENU_RUN_ALL) {
+      // Ozet ekraninda test satirlarini kaydir
+      int maxScroll = runAllSuite.entryCount - RUN_ALL_VISIBLE_ROWS;
+      runAllScroll += diff;
+      if (runAllScroll > maxScroll) runAllScroll = maxScroll;
+      if (runAllScroll < 0) runAllScroll = 0;
+      drawCurrentScreen();
       screenNeedsUpdate = false;
     }
   }
   
   // Buton ile seçim/geri dön
   static bool lastButtonState = HIGH;
-  bool currentButtonState = digitalRead(ENCODER_SW);
+  static bool buttonPressArmed = false;       // basma kenari goruldu, BUTTON_SETTLE_MS bekleniyor
+  static unsigned long buttonPressEdgeMs = 0;
+  bool currentButtonState = halInput().buttonDown() ? LOW : HIGH;
   
   // Buton basıldı (HIGH -> LOW geçişi, pull-up olduğu için LOW = basılı)
   if (lastButtonState == HIGH && currentButtonState == LOW && millis() - lastButtonPress > BUTTON_DEBOUNCE_MS) {
+    buttonPressArmed  = true;
+    buttonPressEdgeMs = millis();
+  }
+  // Donanim debounce (beklemeden): sure dolmadan birakildiysa sicramadir, basim sayilmaz.
+  // Sonraki loop() turlari (test isi 10 ms'de bir uyandirir) sureyi kontrol eder.
+  if (currentButtonState == HIGH) buttonPressArmed = false;
+  if (buttonPressArmed && millis() - buttonPressEdgeMs >= BUTTON_SETTLE_MS) {
+    buttonPressArmed = false;
     lastButtonPress = millis();
-    delay(25); // Donanim debounce
     
     if (currentMenu == MENU_MAIN) {
       // Menüden seçim yap
       if (menuSelection == 0) {
         currentMenu = MENU_IR_TEMP;
         irHasResult      = false;
-        irTestRunning    = false;
-        irSampleCount    = 0;
-        irSampleSum      = 0.0f;
+        sampleAccumulatorStop(irSampler);
         irAverageTemp    = 0.0f;
         irSelection      = 0;
         irSensorStatus   = -1;
         irSensorStatusValid = false;
-        int ntcStatusTemp = 0;
-        if (getSensorStatus(ntcStatusTemp, irSensorStatus)) {
-          irSensorStatusValid = true;
-          irSensorDisconnected = (irSensorStatus == 1);
-        }
-        lastSensorStatusCheck = millis();
-        delay(40);
-        drawIRTempScreen();
+        irStartOnStatus  = false;
+        // $X cevabi beklenmez: onSensorStatusReply() durumu ekrana yansitir
+        requestSensorStatus();
+        schedulerRunAfter(sensorStatusJob, SENSOR_STATUS_REFRESH_MS);
+        drawCurrentScreen();
       } else if (menuSelection == 1) {
         currentMenu = MENU_NTC;
         // NTC test durumunu sifirla
-        ntcTestRunning   = false;
-        ntcSampleCount   = 0;
-        ntcSampleSum     = 0.0f;
+        sampleAccumulatorStop(ntcSampler);
         ntcAverageTemp   = 0.0f;
         ntcHasResult     = false;
         ntcStatusSuccess = false;
-        ntcTestStartTime = 0;
         ntcSelection     = 0; // varsayilan secim: Test
-        // Menüye girerken $X komutunu gonder ve NTC sensor durumunu oku
+        // Menüye girerken $X komutunu gonder; cevap onSensorStatusReply() ile gelir
         ntcSensorStatus      = -1;
         ntcSensorStatusValid = false;
-        int irStatusTemp     = 0;
-        if (getSensorStatus(ntcSensorStatus, irStatusTemp)) {
-          ntcSensorStatusValid = true;
-          ntcSensorDisconnected = (ntcSensorStatus == 1);
-        }
-        lastSensorStatusCheck = millis();
-        delay(40);
-        drawNTCScreen();
+        ntcStartOnStatus     = false;
+        requestSensorStatus();
+        schedulerRunAfter(sensorStatusJob, SENSOR_STATUS_REFRESH_MS);
+        drawCurrentScreen();
       } else if (menuSelection == 2) {
         currentMenu = MENU_INTAKE_FAN;
-        resetIntakeFanState();
+        resetFanGroupState(FAN_GROUP_INTAKE);
         lastEncoderPos = encoderPos;
-        drawIntakeFanScreen();
+        drawCurrentScreen();
       } else if (menuSelection == 3) {
         currentMenu = MENU_EXHAUST_FAN;
-        resetExhaustFanState();
+        resetFanGroupState(FAN_GROUP_EXHAUST);
         lastEncoderPos = encoderPos;
-        drawExhaustFanScreen();
+        drawCurrentScreen();
       } else if (menuSelection == 4) {
         currentMenu = MENU_RGB_LED;
         rgbHue = 0; // Hue 0 ile baslat
@@ -2399,7 +3162,7 @@ void updateMenu() {
         rgbCommandSent = false; // Komut gonderilmedi
         encoderPos = 0; // Encoder pozisyonunu sifirla
         lastEncoderPos = 0; // Encoder pozisyonunu sifirla
-        drawRGBLedScreen();
+        drawCurrentScreen();
       } else if (menuSelection == 5) {
         currentMenu = MENU_GESTURE;
         // Gesture menüsüne girerken sensörü konfigüre et ($I)
@@ -2409,25 +3172,26 @@ void updateMenu() {
         gestureSelection      = 0; // Varsayilan: Test
         last_gesture_type     = GESTURE_NONE;
         sendGestureInit();
-        delay(40); // STM32'nin $I sonrasi hazir olmasi icin kisa bekleme
-        drawGestureScreen();
+        // STM32'nin $I sonrasi hazir olmasi icin siradaki $A istegini ertele (beklemeden)
+        schedulerRunAfter(readJob, GESTURE_INIT_SETTLE_MS);
+        drawCurrentScreen();
       } else if (menuSelection == 6) {
         currentMenu = MENU_Z_REF;
-        drawZRefScreen();
+        drawCurrentScreen();
       } else if (menuSelection == 7) {
         currentMenu = MENU_Y_REF;
-        drawYRefScreen();
+        drawCurrentScreen();
       } else if (menuSelection == 8) {
         currentMenu = MENU_CVR1_REF;
-        drawCVR1RefScreen();
+        drawCurrentScreen();
       } else if (menuSelection == 9) {
         currentMenu = MENU_CVR2_REF;
-        drawCVR2RefScreen();
+        drawCurrentScreen();
       } else if (menuSelection == 10) {
         currentMenu = MENU_BRAKE_MOTOR;
         brakeMotorActive = false; // Pasif ile baslat
         lastEncoderPos = encoderPos; // Encoder pozisyonunu koru
-        drawBrakeMotorScreen();
+        drawCurrentScreen();
       } else if (menuSelection == 11) {
         currentMenu = MENU_Z_MOTOR;
         // Varsayilan Z motor parametreleri
@@ -2440,7 +3204,7 @@ void updateMenu() {
         encoderPos = 0;
         lastEncoderPos = 0;
         Serial.println("Z Menu: enter");
-        drawZMotorScreen();
+        drawCurrentScreen();
       } else if (menuSelection == 12) {
         currentMenu = MENU_Y_MOTOR;
         // Varsayilan Y motor parametreleri
@@ -2452,7 +3216,7 @@ void updateMenu() {
         yMotorEditMode = false;
         encoderPos = 0;
         lastEncoderPos = 0;
-        drawYMotorScreen();
+        drawCurrentScreen();
       } else if (menuSelection == 13) {
         currentMenu = MENU_CVR_MOTOR;
         // Varsayilan CVR motor parametreleri
@@ -2469,13 +3233,14 @@ void updateMenu() {
         cvrMotorEditMode = false;
         encoderPos = 0;
         lastEncoderPos = 0;
-        drawCVRMotorScreen();
+        drawCurrentScreen();
       } else if (menuSelection == 14) {
         currentMenu = MENU_LOADCELL;
+        loadcellScreenMode = 0;  // "Tumunu Test Et" sonucu kalmis olabilir
         loadcellSelection = 0;
         encoderPos = 0;
         lastEncoderPos = 0;
-        drawLoadcellScreen();
+        drawCurrentScreen();
       } else if (menuSelection == 15) {
         currentMenu = MENU_PROJEKSIYON;
         projeksiyonLedOn = false;
@@ -2484,165 +3249,98 @@ void updateMenu() {
         projectorStatusSuccess = false;
         projectorSelection     = 0; // Varsayilan: LED satiri
         projectorEditMode      = false;
-        // Baslangic sirasi: $PF -> 500ms -> $I -> $X
-        Serial1.print("$PF\r\n");
-        Serial1.flush();
-        Serial.println("Projeksiyon: $PF\\r\\n (OFF)");
-        delay(500);
-        // $I komutu projektoru de ayarlar
-        sendGestureInit();
-        delay(40);
-        int ntcDummy = 0;
-        int irDummy  = 0;
-        if (getSensorStatus(ntcDummy, irDummy)) {
-          projectorHasResult     = true;
-          projectorStatusSuccess = (projector_sensor_status == 0);
-        }
         encoderPos = 0;
         lastEncoderPos = 0;
-        drawProjeksiyonScreen();
+        // Baslangic sirasi: $PF -> 500ms -> $I -> $X (projeksiyon testi ile ayni, bekletmez)
+        startProjectorTest();
+      } else if (menuSelection == 16) {
+        startRunAll();
       }
     } else if (currentMenu == MENU_NTC) {
       // NTC menusu: buton islemleri
-      if (!ntcTestRunning) {
+      if (!sampleAccumulatorRunning(ntcSampler)) {
         if (ntcSelection == 0) {
           // Test icin tikla: once sensor durumunu kontrol et
-          bool sensorOk = false;
-
           if (ntcSensorStatusValid) {
-            // Menüye girerken okunmus $X sonucunu kullan
-            sensorOk = (ntcSensorStatus == 0);
-          } else {
-            // Henuz okunmadiysa bir kez $X ile dene ve sonucu cache'le
-            sensorOk = isNTCSensorOk();
-            ntcSensorStatus      = sensorOk ? 0 : 1;
-            ntcSensorStatusValid = true;
+            // Menüye girerken okunmus $X / $A sonucunu kullan
+            startNTCTest(ntcSensorStatus == 0);
+            // Sensor durum/NTC test bilgilerini ekrana yansıt
+            drawCurrentScreen();
+          } else if (!ntcStartOnStatus) {
+            // Henuz okunmadiysa $X iste; test cevap gelince baslar (cevapsizsa FAIL)
+            ntcStartOnStatus = true;
+            requestSensorStatus();
           }
-
-          if (!sensorOk) {
-            ntcTestRunning   = false;
-            ntcHasResult     = true;
-            ntcStatusSuccess = false;
-          } else {
-            // Sensor saglam ise NTC testini bastan baslat
-            ntcTestRunning   = true;
-            ntcSampleCount   = 0;
-            ntcSampleSum     = 0.0f;
-            ntcAverageTemp   = 0.0f;
-            ntcMinTemp       = 0.0f;
-            ntcMaxTemp       = 0.0f;
-            ntcLastTemp      = 0.0f;
-            ntcHasLastTemp   = false;
-            ntcHasResult     = false;
-            ntcStatusSuccess = true; // baslangicta OK, olcumler bozar ise FAIL olur
-            ntcTestStartTime = millis();
-          }
-          // Sensor durum/NTC test bilgilerini ekrana yansıt
-          drawNTCScreen();
         } else if (ntcSelection == 1) {
           // Cikis: ana menuye don
+          ntcStartOnStatus = false;
           currentMenu = MENU_MAIN;
-          drawMenu();
+          drawCurrentScreen();
+        } else {
+          toggleTempTestMode();
+          drawCurrentScreen();
         }
       }
       screenNeedsUpdate = false;
-    } else if (currentMenu == MENU_INTAKE_FAN) {
-      if (intakeFanTestRunning) {
-        drawIntakeFanScreen();
-      } else if (intakeFanHasResult) {
-        resetIntakeFanState();
-        drawIntakeFanScreen();
-      } else if (intakeFanSelection == 0) {
-        startIntakeFanTest();
-      } else {
-        fanSpeedPercent = 0;
-        sendIntakeFanCommand();
-        resetIntakeFanState();
-        currentMenu = MENU_MAIN;
-        drawMenu();
-      }
-    } else if (currentMenu == MENU_EXHAUST_FAN) {
-      if (exhaustFanTestRunning) {
-        drawExhaustFanScreen();
-      } else if (exhaustFanHasResult) {
-        resetExhaustFanState();
-        drawExhaustFanScreen();
-      } else if (exhaustFanSelection == 0) {
-        startExhaustFanTest();
+    } else if (fanGroupForMenu(currentMenu) >= 0) {
+      FanGroupId g = (FanGroupId)fanGroupForMenu(currentMenu);
+      FanGroupState &st = fanGroupStates[g];
+      if (testRunnerBusy(st.test)) {
+        drawCurrentScreen();
+      } else if (st.hasResult) {
+        resetFanGroupState(g);
+        drawCurrentScreen();
+      } else if (st.selection == 0) {
+        startFanTest(g);
       } else {
-        exhaustFanSpeedPercent = 0;
-        sendExhaustFanCommand();
-        resetExhaustFanState();
+        st.speedPercent = 0;
+        sendFanGroupCommand(g);
+        resetFanGroupState(g);
         currentMenu = MENU_MAIN;
-        drawMenu();
+        drawCurrentScreen();
       }
     } else if (currentMenu == MENU_RGB_LED) {
-      // RGB LED menusu: LED Test veya Cikis
-      if (rgbMenuSelection == 0) {
+      // RGB LED menusu: LED Test veya Cikis (test suruyorsa iptal)
+      if (testRunnerBusy(rgbLedTest)) {
+        finishRGBLedTest();
+      } else if (rgbMenuSelection == 0) {
         // LED test akisi
-        runRGBLedTest();
+        startRGBLedTest();
       } else if (rgbMenuSelection == 1) {
         // Cikis: ana menuye don
         currentMenu = MENU_MAIN;
-        drawMenu();
+        drawCurrentScreen();
       }
     } else if (currentMenu == MENU_GESTURE) {
       // Gesture menusu: Test / Cikis
-      if (gestureSelection == 0) {
-        // TEST akisi
-        // 1) Sensörü yeniden konfigure et ($I)
-        sendGestureInit();
-        delay(40); // $I sonrasi kisa bekleme
-        // 2) $X ile durum kontrolu
-        int ntcDummy = 0;
-        int irDummy  = 0;
-        if (getSensorStatus(ntcDummy, irDummy)) {
-          // gesture_sensor_status global olarak guncellendi
-          gestureHasResult     = true;
-          gestureStatusSuccess = (gesture_sensor_status == 0);
-        } else {
-          // $X cevabi alinmazsa FAIL kabul et
-          gestureHasResult     = true;
-          gestureStatusSuccess = false;
-        }
-        drawGestureScreen();
+      if (testRunnerBusy(gestureTest)) {
+        // Test suruyor ($I / $X bekleniyor): basimi yok say
+      } else if (gestureSelection == 0) {
+        // TEST akisi: $I -> bekle -> $X ($X cevapsizsa FAIL)
+        startGestureTest();
       } else if (gestureSelection == 1) {
         // CIKIS: ana menuye don
         currentMenu = MENU_MAIN;
-        drawMenu();
+        drawCurrentScreen();
       }
     } else if (currentMenu == MENU_IR_TEMP) {
-      if (!irTestRunning) {
+      if (!sampleAccumulatorRunning(irSampler)) {
         if (irSelection == 0) {
-          // Test icin tikla: $A cache kullan ($X cagirmak $A ile cakisma yapiyor, arka arkaya test bozuluyor)
-          bool sensorOk = false;
+          // Test icin tikla: $A / $X cache kullan, yoksa $X cevabi gelince basla (NTC ile ayni)
           if (irSensorStatusValid) {
-            sensorOk = (irSensorStatus == 0);
-          } else {
-            sensorOk = isIRSensorOk();
-            irSensorStatus      = sensorOk ? 0 : 1;
-            irSensorStatusValid = true;
+            startIRTest(irSensorStatus == 0);
+            drawCurrentScreen();
+          } else if (!irStartOnStatus) {
+            irStartOnStatus = true;
+            requestSensorStatus();
           }
-          if (!sensorOk) {
-            irHasResult     = true;
-            irStatusSuccess = false;
-          } else {
-            irTestRunning    = true;
-            irSampleCount    = 0;
-            irSampleSum      = 0.0f;
-            irAverageTemp    = 0.0f;
-            irMinTemp        = 0.0f;
-            irMaxTemp        = 0.0f;
-            irLastTempStep   = 0.0f;
-            irHasLastTemp    = false;
-            irHasResult      = false;
-            irStatusSuccess  = true;
-            irTestStartTime  = millis();
-          }
-          drawIRTempScreen();
         } else if (irSelection == 1) {
+          irStartOnStatus = false;
           currentMenu = MENU_MAIN;
-          drawMenu();
+          drawCurrentScreen();
+        } else {
+          toggleTempTestMode();
+          drawCurrentScreen();
         }
       }
       screenNeedsUpdate = false;
@@ -2650,44 +3348,52 @@ void updateMenu() {
                currentMenu == MENU_CVR1_REF || currentMenu == MENU_CVR2_REF) {
       // TMC Ref ekranlarindan butona basinca ana menuye don
       currentMenu = MENU_MAIN;
-      drawMenu();
+      drawCurrentScreen();
     } else if (currentMenu == MENU_BRAKE_MOTOR) {
-      // Motor freni ekraninda: Test veya Cikis
-      if (brakeMotorSelection == 0) {
-        runBrakeMotorTest();
+      // Motor freni ekraninda: Test veya Cikis (test suruyorsa iptal)
+      if (testRunnerBusy(brakeMotorTest)) {
+        abortBrakeMotorTest();
+      } else if (brakeMotorSelection == 0) {
+        startBrakeMotorTest();
       } else {
         currentMenu = MENU_MAIN;
-        drawMenu();
+        drawCurrentScreen();
       }
     } else if (currentMenu == MENU_Z_MOTOR) {
       // Z Motor test ekraninda: Test / Cikis
-      if (zMotorTestSelection == 0) {
+      if (testRunnerBusy(motorTests[MOTOR_AXIS_Z])) {
+        abortMotorTest(MOTOR_AXIS_Z);
+      } else if (zMotorTestSelection == 0) {
         // TEST akisi
-        runZMotorTest();
+        startZMotorTest();
       } else if (zMotorTestSelection == 1) {
         // Geri: ana menuye don
         currentMenu = MENU_MAIN;
-        drawMenu();
+        drawCurrentScreen();
       }
     } else if (currentMenu == MENU_Y_MOTOR) {
       // Y Motor test ekraninda: Test / Cikis
-      if (yMotorTestSelection == 0) {
+      if (testRunnerBusy(motorTests[MOTOR_AXIS_Y])) {
+        abortMotorTest(MOTOR_AXIS_Y);
+      } else if (yMotorTestSelection == 0) {
         // TEST akisi
-        runYMotorTest();
+        startYMotorTest();
       } else if (yMotorTestSelection == 1) {
         // Geri: ana menuye don
         currentMenu = MENU_MAIN;
-        drawMenu();
+        drawCurrentScreen();
       }
     } else if (currentMenu == MENU_CVR_MOTOR) {
       // CVR 1-2 Motor test ekraninda: Test / Cikis
-      if (cvrMotorTestSelection == 0) {
+      if (testRunnerBusy(motorTests[MOTOR_AXIS_CVR])) {
+        abortMotorTest(MOTOR_AXIS_CVR);
+      } else if (cvrMotorTestSelection == 0) {
         // TEST akisi (iki motor ayni anda)
-        runCVRMotorTest();
+        startCVRMotorTest();
       } else if (cvrMotorTestSelection == 1) {
         // CIKIS: ana menuye don
         currentMenu = MENU_MAIN;
-        drawMenu();
+        drawCurrentScreen();
       }
     } else if (currentMenu == MENU_PROJEKSIYON) {
       // Projeksiyon ekraninda: LED / Akim / Test / Cikis
@@ -2701,48 +3407,41 @@ void updateMenu() {
             sendProjeksiyonOff();
           }
         }
-        drawProjeksiyonScreen();
+        drawCurrentScreen();
       } else if (projectorSelection == 1) {
         // Akim: edit modunu ac/kapat
         projectorEditMode = !projectorEditMode;
-        drawProjeksiyonScreen();
+        drawCurrentScreen();
       } else if (projectorSelection == 2) {
-        // TEST akisi:
-        // 1) Projektoru kapat: $PF
-        Serial1.print("$PF\r\n");
-        Serial1.flush();
-        Serial.println("Projeksiyon TEST: $PF\\r\\n (OFF)");
-        delay(500);
-        // 2) Config gonder: $I
-        sendGestureInit();
-        delay(40);
-        // 3) $X ile durum kontrolu
-        int ntcDummy = 0;
-        int irDummy  = 0;
-        if (getSensorStatus(ntcDummy, irDummy)) {
-          projectorHasResult     = true;
-          projectorStatusSuccess = (projector_sensor_status == 0);
-        } else {
-          projectorHasResult     = true;
-          projectorStatusSuccess = false;
-        }
-        drawProjeksiyonScreen();
+        // TEST akisi: $PF -> $I -> $X (test suruyorsa yeniden baslatma)
+        if (!testRunnerBusy(projectorTest)) startProjectorTest();
       } else if (projectorSelection == 3) {
         // CIKIS: ana menuye don
         currentMenu = MENU_MAIN;
-        drawMenu();
+        drawCurrentScreen();
+      }
+    } else if (currentMenu == MENU_RUN_ALL) {
+      // Kosu suruyorsa iptal (ozet ekraninda kalir), bittiyse ana menuye don
+      if (testSuiteBusy(runAllSuite)) {
+        abortRunAll();
+      } else {
+        currentMenu = MENU_MAIN;
+        drawCurrentScreen();
       }
     } else if (currentMenu == MENU_LOADCELL) {
       // Loadcell menusu: Test Et / Cikis veya sonuc ekranlari
-      if (loadcellScreenMode == 0) {
+      if (loadcellScreenMode == 3) {
+        // TARE suruyor: testi iptal et
+        abortLoadcellTest();
+      } else if (loadcellScreenMode == 0) {
         // Menu modu
         if (loadcellSelection == 0) {
           // Test Et: $I -> 500ms -> $X -> (hata varsa HATA, yoksa tare + 4 okuma)
-          runLoadcellTest();
+          startLoadcellTest();
         } else {
           // Cikis: ana menuye don
           currentMenu = MENU_MAIN;
-          drawMenu();
+          drawCurrentScreen();
         }
       } else {
         // SUCCESS veya HATA ekranindayken butona basinca loadcell menüsüne don
@@ -2750,12 +3449,12 @@ void updateMenu() {
         resetLoadcellTestState();
         loadcellScreenMode = 0;
         loadcellSelection  = 0;
-        drawLoadcellScreen();
+        drawCurrentScreen();
       }
     } else {
       // Diger detay ekranlarindan geri don
       currentMenu = MENU_MAIN;
-      drawMenu();
+      drawCurrentScreen();
     }
     screenNeedsUpdate = false;
   }
@@ -2763,7 +3462,264 @@ void updateMenu() {
   lastButtonState = currentButtonState;
 }
 
-static unsigned long lastScreenUpdate = 0;
+// --- Gorunum modelleri ---
+// Her ekranin cizdigi degerler; ekran yalnizca bu degerlerin ozeti degistiginde yeniden cizilir.
+// Ondalikli degerler ekrandaki hassasiyetle yuvarlanir (gorunmeyen gurultu cizim tetiklemesin).
+
+struct MenuView {
+  int selection;
+};
+
+static uint32_t menuViewHash() {
+  MenuView v;
+  viewModelClear(v);
+  v.selection = menuSelection;
+  return viewModelHash(v);
+}
+
+// NTC / IR ekranlari
+struct TempTestView {
+  bool running;
+  bool disconnected;
+  bool hasResult;
+  bool success;
+  int  valueDeci;   // 0.1 C
+  int  selection;
+  int  mode;
+};
+
+static uint32_t tempTestViewHash(const SampleAccumulator &sampler, bool disconnected, bool hasResult,
+                                 bool success, float average, int selection) {
+  TempTestView v;
+  viewModelClear(v);
+  v.running      = sampleAccumulatorRunning(sampler);
+  v.disconnected = disconnected;
+  v.hasResult    = hasResult;
+  v.success      = success;
+  v.valueDeci    = (int)lroundf(average * 10.0f);
+  v.selection    = selection;
+  v.mode         = tempTestMode;
+  return viewModelHash(v);
+}
+
+static uint32_t irTempViewHash() {
+  return tempTestViewHash(irSampler, irSensorDisconnected, irHasResult, irStatusSuccess,
+                          irAverageTemp, irSelection);
+}
+
+static uint32_t ntcViewHash() {
+  return tempTestViewHash(ntcSampler, ntcSensorDisconnected, ntcHasResult, ntcStatusSuccess,
+                          ntcAverageTemp, ntcSelection);
+}
+
+struct FanView {
+  bool busy;
+  int  speedPercent;
+  int  phase;
+  long rpm[FAN_GROUP_MAX_CHANNELS];  // tam RPM
+  bool hasResult;
+  bool success;
+  char failLabel[24];
+  int  selection;
+};
+
+static uint32_t fanViewHash(FanGroupId g) {
+  const FanGroupState &st = fanGroupStates[g];
+  const FanGroup &group = fanGroups[g];
+  FanView v;
+  viewModelClear(v);
+  v.busy         = testRunnerBusy(st.test);
+  v.speedPercent = st.speedPercent;
+  v.phase        = st.test.phase;
+  for (int n = 0; n < group.channelCount; n++) {
+    v.rpm[n] = lroundf(*group.channels[n].rpm);
+  }
+  v.hasResult = st.hasResult;
+  v.success   = st.statusSuccess;
+  strncpy(v.failLabel, st.failLabel, sizeof(v.failLabel) - 1);
+  v.selection = st.selection;
+  return viewModelHash(v);
+}
+
+static uint32_t intakeFanViewHash()  { return fanViewHash(FAN_GROUP_INTAKE); }
+static uint32_t exhaustFanViewHash() { return fanViewHash(FAN_GROUP_EXHAUST); }
+
+struct RGBLedView {
+  bool        busy;
+  const char* label;  // sabit renk adlari: adres karsilastirmasi yeterli
+  int         selection;
+};
+
+static uint32_t rgbLedViewHash() {
+  RGBLedView v;
+  viewModelClear(v);
+  v.busy      = testRunnerBusy(rgbLedTest);
+  v.label     = rgbTestLabel;
+  v.selection = rgbMenuSelection;
+  return viewModelHash(v);
+}
+
+struct GestureView {
+  int  gesture;
+  bool busy;
+  bool hasResult;
+  bool success;
+  int  selection;
+};
+
+static uint32_t gestureViewHash() {
+  GestureView v;
+  viewModelClear(v);
+  v.gesture   = last_gesture_type;
+  v.busy      = testRunnerBusy(gestureTest);
+  v.hasResult = gestureHasResult;
+  v.success   = gestureStatusSuccess;
+  v.selection = gestureSelection;
+  return viewModelHash(v);
+}
+
+// TMC Ref ekranlari: stop bitleri
+struct RefView {
+  int stopR;
+  int stopL;
+};
+
+static uint32_t refViewHash(int stopR, int stopL) {
+  RefView v;
+  viewModelClear(v);
+  v.stopR = stopR;
+  v.stopL = stopL;
+  return viewModelHash(v);
+}
+
+static uint32_t zRefViewHash()    { return refViewHash(z_tmc_status_stop_r, 0); }
+static uint32_t yRefViewHash()    { return refViewHash(y_tmc_status_stop_r, y_tmc_status_stop_l); }
+static uint32_t cvr1RefViewHash() { return refViewHash(cvr1_tmc_status_stop_r, cvr1_tmc_status_stop_l); }
+static uint32_t cvr2RefViewHash() { return refViewHash(cvr2_tmc_status_stop_r, cvr2_tmc_status_stop_l); }
+
+struct BrakeMotorView {
+  bool busy;
+  int  cycle;
+  bool active;
+  int  selection;
+};
+
+static uint32_t brakeMotorViewHash() {
+  BrakeMotorView v;
+  viewModelClear(v);
+  v.busy      = testRunnerBusy(brakeMotorTest);
+  v.cycle     = brakeTestCycle;
+  v.active    = brakeMotorActive;
+  v.selection = brakeMotorSelection;
+  return viewModelHash(v);
+}
+
+// Motor test ekranlari: test sirasinda hareket no ve eksenin stop bitleri
+struct MotorTestView {
+  bool busy;
+  int  moveIndex;
+  int  stops[4];
+  int  selection;
+};
+
+static uint32_t motorTestViewHash(MotorTestAxis axis, int selection) {
+  MotorTestView v;
+  viewModelClear(v);
+  v.busy      = testRunnerBusy(motorTests[axis]);
+  v.moveIndex = motorTestMoveIndex[axis];
+  if (axis == MOTOR_AXIS_Z) {
+    v.stops[0] = z_tmc_status_stop_r;
+  } else if (axis == MOTOR_AXIS_Y) {
+    v.stops[0] = y_tmc_status_stop_r;
+    v.stops[1] = y_tmc_status_stop_l;
+  } else {
+    v.stops[0] = cvr1_tmc_status_stop_r;
+    v.stops[1] = cvr1_tmc_status_stop_l;
+    v.stops[2] = cvr2_tmc_status_stop_r;
+    v.stops[3] = cvr2_tmc_status_stop_l;
+  }
+  v.selection = selection;
+  return viewModelHash(v);
+}
+
+static uint32_t zMotorViewHash()   { return motorTestViewHash(MOTOR_AXIS_Z, zMotorTestSelection); }
+static uint32_t yMotorViewHash()   { return motorTestViewHash(MOTOR_AXIS_Y, yMotorTestSelection); }
+static uint32_t cvrMotorViewHash() { return motorTestViewHash(MOTOR_AXIS_CVR, cvrMotorTestSelection); }
+
+struct LoadcellView {
+  int  mode;
+  int  selection;
+  int  errorType;
+  int  faultMask;
+  long centiGrams[4];  // 0.01 g
+};
+
+static uint32_t loadcellViewHash() {
+  LoadcellView v;
+  viewModelClear(v);
+  v.mode      = loadcellScreenMode;
+  v.selection = loadcellSelection;
+  v.errorType = loadcellErrorType;
+  v.faultMask = loadcellFaultMask;
+  v.centiGrams[0] = lroundf(loadcell1_g * 100.0f);
+  v.centiGrams[1] = lroundf(loadcell2_g * 100.0f);
+  v.centiGrams[2] = lroundf(loadcell3_g * 100.0f);
+  v.centiGrams[3] = lroundf(loadcell4_g * 100.0f);
+  return viewModelHash(v);
+}
+
+struct ProjectorView {
+  bool busy;
+  bool hasResult;
+  bool success;
+  int  selection;
+  bool ledOn;
+  int  current;
+  bool editMode;
+};
+
+static uint32_t projeksiyonViewHash() {
+  ProjectorView v;
+  viewModelClear(v);
+  v.busy      = testRunnerBusy(projectorTest);
+  v.hasResult = projectorHasResult;
+  v.success   = projectorStatusSuccess;
+  v.selection = projectorSelection;
+  v.ledOn     = projeksiyonLedOn;
+  v.current   = projeksiyonAkim;
+  v.editMode  = projectorEditMode;
+  return viewModelHash(v);
+}
+
+// Ozet ekrani: sureler ekranda saniye olarak gorunur
+struct RunAllView {
+  unsigned long   elapsedS;
+  int             passCount;
+  int             scroll;
+  bool            busy;
+  TestSuiteResult results[TEST_SUITE_MAX_ENTRIES];
+  unsigned long   seconds[TEST_SUITE_MAX_ENTRIES];
+};
+
+static uint32_t runAllViewHash() {
+  unsigned long now = millis();
+  RunAllView v;
+  viewModelClear(v);
+  v.elapsedS  = testSuiteElapsedMs(runAllSuite, now) / 1000;
+  v.passCount = testSuiteCount(runAllSuite, TEST_SUITE_PASS);
+  v.scroll    = runAllScroll;
+  v.busy      = testSuiteBusy(runAllSuite);
+  for (int i = 0; i < runAllSuite.entryCount; i++) {
+    TestSuiteResult result = runAllSuite.results[i];
+    v.results[i] = result;
+    if (result != TEST_SUITE_PENDING) {
+      unsigned long ms = (result == TEST_SUITE_RUNNING) ? now - runAllSuite.durationMs[i]
+                                                         : runAllSuite.durationMs[i];
+      v.seconds[i] = ms / 1000;
+    }
+  }
+  return viewModelHash(v);
+}
 
 // Function pointer array - ekran çizim fonksiyonları için optimize edilmiş
 typedef void (*DrawScreenFunc)();
@@ -2784,18 +3740,61 @@ DrawScreenFunc drawScreenFunctions[] = {
   drawYMotorScreen,      // MENU_Y_MOTOR
   drawCVRMotorScreen,    // MENU_CVR_MOTOR
   drawLoadcellScreen,    // MENU_LOADCELL
-  drawProjeksiyonScreen  // MENU_PROJEKSIYON
+  drawProjeksiyonScreen, // MENU_PROJEKSIYON
+  drawRunAllScreen       // MENU_RUN_ALL
 };
 
-// Optimize edilmiş ekran çizim fonksiyonu
+// Ekranlarin gorunum modeli ozetleri (drawScreenFunctions ile ayni sira)
+typedef uint32_t (*ScreenViewHashFunc)();
+static const ScreenViewHashFunc screenViewHashFunctions[] = {
+  menuViewHash,          // MENU_MAIN
+  irTempViewHash,        // MENU_IR_TEMP
+  ntcViewHash,           // MENU_NTC
+  intakeFanViewHash,     // MENU_INTAKE_FAN
+  exhaustFanViewHash,    // MENU_EXHAUST_FAN
+  rgbLedViewHash,        // MENU_RGB_LED
+  gestureViewHash,       // MENU_GESTURE
+  zRefViewHash,          // MENU_Z_REF
+  yRefViewHash,          // MENU_Y_REF
+  cvr1RefViewHash,       // MENU_CVR1_REF
+  cvr2RefViewHash,       // MENU_CVR2_REF
+  brakeMotorViewHash,    // MENU_BRAKE_MOTOR
+  zMotorViewHash,        // MENU_Z_MOTOR
+  yMotorViewHash,        // MENU_Y_MOTOR
+  cvrMotorViewHash,      // MENU_CVR_MOTOR
+  loadcellViewHash,      // MENU_LOADCELL
+  projeksiyonViewHash,   // MENU_PROJEKSIYON
+  runAllViewHash         // MENU_RUN_ALL
+};
+static_assert(sizeof(screenViewHashFunctions) / sizeof(screenViewHashFunctions[0]) ==
+              sizeof(drawScreenFunctions) / sizeof(drawScreenFunctions[0]),
+              "her ekranin bir gorunum modeli olmali");
+
+// Son cizilen ekran: menu, gorunum modeli ozeti ve cizimden sonraki display() sayaci.
+// Araya baska bir cizim girdiyse (acilis / durum ekrani) sayac tutmaz ve ekran yeniden cizilir.
+static int      drawnMenu       = -1;
+static uint32_t drawnViewHash   = 0;
+static uint32_t drawnFlushCount = 0;
+
+// Acik ekrani ciz; menu ve gorunum modeli son cizimle ayniysa hicbir sey yapma
 void drawCurrentScreen() {
-  if (currentMenu >= 0 && currentMenu < sizeof(drawScreenFunctions) / sizeof(drawScreenFunctions[0])) {
-    drawScreenFunctions[currentMenu]();
+  PROFILE_ZONE(PROFILE_DRAW_SCREEN);
+  if (currentMenu < 0 || currentMenu >= sizeof(drawScreenFunctions) / sizeof(drawScreenFunctions[0])) {
+    return;
+  }
+  uint32_t viewHash = screenViewHashFunctions[currentMenu]();
+  if (currentMenu == drawnMenu && viewHash == drawnViewHash && display.flushCount() == drawnFlushCount) {
+    return;
   }
+  drawScreenFunctions[currentMenu]();
+  drawnMenu       = currentMenu;
+  drawnViewHash   = viewHash;
+  drawnFlushCount = display.flushCount();
 }
 
-// $X komutu ile NTC, IR, fan, gesture, projeksiyon ve force sensor durumlarini oku
-bool getSensorStatus(int &ntcStatus, int &irStatus) {
+// $X cevabini parse et ve fan/gesture/projeksiyon/force durumlarini guncelle.
+// buffer == nullptr (zaman asimi) ise durumlar sifirlanir ve false doner.
+bool parseSensorStatusLine(const char* buffer, int &ntcStatus, int &irStatus) {
   ntcStatus = 1;
   irStatus  = 1;
   exhaust_fan_error     = 0;
@@ -2805,82 +3804,16 @@ bool getSensorStatus(int &ntcStatus, int &irStatus) {
   projector_sensor_status = 0;
   force_sensor_status = 0;
 
-  // Once eski veriyi temizle ki sadece taze $X cevabini okuyalim
-  while (Serial1.available()) {
-    Serial1.read();
-  }
-
-  Serial1.print("$X\r\n");
-  Serial1.flush();
-
-  char buffer[32];
-  int index = 0;
-  unsigned long startTime = millis();
-  bool lineComplete = false;
-
-  while (millis() - startTime < READ_TIMEOUT_MS && index < (int)sizeof(buffer) - 1) {
-    if (Serial1.available()) {
-      char c = Serial1.read();
-      if (c == '\r' || c == '\n') {
-        if (index > 0) {
-          buffer[index] = '\0';
-          lineComplete = true;
-          break;
-        }
-      } else if (c >= 32 && c < 127) {
-        buffer[index++] = c;
-      }
-    }
-  }
-
-  if (!lineComplete) return false;
-  if (buffer[0] != '$') return false;
-
-  // Beklenen format:
-  // $ntc_sensor_status,
-  //  ir_sensor_status,
-  //  exhaust_fan_err,
-  //  intake1_fan_err,
-  //  intake2_fan_err,
-  //  gesture_sensor_status,
-  //  projector_sensor_status,
-  //  force_sensor_status
+  // Beklenen format (statusSchema):
+  // $ntc_sensor_status,ir_sensor_status,exhaust_fan_err,intake1_fan_err,intake2_fan_err,
+  //  gesture_sensor_status,projector_sensor_status,force_sensor_status
   // Su an STM32 tarafindan 8 deger gonderiliyor: $0,1,0,0,0,0,0,1
-  //  0: ntc, 1: ir, 2: exhaust, 3: intake1, 4: intake2, 5: gesture, 6: projector, 7: force
-  int values[8] = {0, 0, 0, 0, 0, 0, 0, 0};
-  int valueIndex = 0;
-  int numValue = 0;
-  bool inNumber = false;
-
-  for (int i = 1; i <= index; i++) {
-    char c = (i < index) ? buffer[i] : '\0';
-    if (c >= '0' && c <= '9') {
-      numValue = numValue * 10 + (c - '0');
-      inNumber = true;
-    } else if (c == ',' || c == '\0' || c == '\r' || c == '\n') {
-      if (inNumber && valueIndex < 8) {
-        values[valueIndex++] = numValue;
-        numValue = 0;
-        inNumber = false;
-      }
-      if (c == '\0' || c == '\r' || c == '\n') break;
-    }
-  }
-
-  if (inNumber && valueIndex < 8) {
-    values[valueIndex++] = numValue;
-  }
-
-  if (valueIndex < 2) return false;
+  // En az NTC ve IR gelmeli; eksik alanlarin degiskenleri yukarida OK'a cekildi
+  int32_t values[8];
+  if (stm32ParseInto(buffer, statusSchema, values, 2) < 0) return false;
 
   ntcStatus = values[0];
   irStatus  = values[1];
-  if (valueIndex >= 3) exhaust_fan_error       = values[2];
-  if (valueIndex >= 4) intake1_fan_error       = values[3];
-  if (valueIndex >= 5) intake2_fan_error       = values[4];
-  if (valueIndex >= 6) gesture_sensor_status     = values[5];
-  if (valueIndex >= 7) projector_sensor_status   = values[6];
-  if (valueIndex >= 8) force_sensor_status       = values[7];
 
   // Debug: $X cevabini ve parse edilen status degerlerini goster
   Serial.print("X cevabi: ");
@@ -2902,190 +3835,203 @@ bool getSensorStatus(int &ntcStatus, int &irStatus) {
   Serial.print(" , FORCE status = ");
   Serial.println(force_sensor_status);
 
-  // $X cevabindan arta kalan byte'lari temizle (sonraki $A okumasini bozmasin)
-  while (Serial1.available()) {
-    Serial1.read();
-  }
-
   return true;
 }
 
-bool isNTCSensorOk() {
-  int ntcStatus = 1, irStatus = 1;
-  if (!getSensorStatus(ntcStatus, irStatus)) {
-    return false;
+// Periyodik (asenkron) $X cevabi: acik menunun sensor durumunu guncelle, durumu bekleyen
+// NTC / IR testini baslat (cevapsiz veya gecersiz cevapta sensor yok sayilir, test FAIL)
+static void onSensorStatusReply(const char* line, void* ctx) {
+  int ntcStatus = 1;
+  int irStatus  = 1;
+  bool ok = parseSensorStatusLine(line, ntcStatus, irStatus);
+
+  if (ntcStartOnStatus) {
+    ntcStartOnStatus     = false;
+    ntcSensorStatus      = (ok && ntcStatus == 0) ? 0 : 1;
+    ntcSensorStatusValid = true;
+    startNTCTest(ntcSensorStatus == 0);
+  } else if (currentMenu == MENU_NTC && !sampleAccumulatorRunning(ntcSampler)) {
+    ntcSensorStatus = ntcStatus;
+    if (ok) {
+      ntcSensorStatusValid = true;
+      ntcSensorDisconnected = (ntcSensorStatus == 1);
+    }
   }
-  return ntcStatus == 0;
-}
-
-bool isIRSensorOk() {
-  int ntcStatus = 1, irStatus = 1;
-  if (!getSensorStatus(ntcStatus, irStatus)) {
-    return false;
+  if (irStartOnStatus) {
+    irStartOnStatus     = false;
+    irSensorStatus      = (ok && irStatus == 0) ? 0 : 1;
+    irSensorStatusValid = true;
+    startIRTest(irSensorStatus == 0);
+  } else if (currentMenu == MENU_IR_TEMP && !sampleAccumulatorRunning(irSampler)) {
+    irSensorStatus = irStatus;
+    if (ok) {
+      irSensorStatusValid = true;
+      irSensorDisconnected = (irSensorStatus == 1);
+    }
   }
-  return irStatus == 0;
+  // projector_sensor_status ve fan hata bitleri global olarak guncellendi
+  stm32ReplyHandled = true;
+  screenNeedsUpdate = true;
 }
 
-void loop() {
-  // Menu guncelle
-  updateMenu();
-  
-  unsigned long now = millis();
+// $X iste, cevap onSensorStatusReply()'a gelir. Yoldaki $X baska bir testin (projeksiyon,
+// gesture) olabilecegi icin her cagri yeni istek gonderir.
+static void requestSensorStatus() {
+  stm32LinkRequest(STM32_REQ_STATUS, "$X", READ_TIMEOUT_MS, onSensorStatusReply);
+}
 
-  updateIntakeFanTest();
-  updateExhaustFanTest();
-  
-  // Sensör verisi: Gesture ekranindayken daha sik istek,
-  // NTC/IR testi sirasinda 100ms aralikla olcum
-  unsigned long readInterval;
+// Sensör verisi periyodu: Gesture ekranindayken daha sik istek,
+// NTC/IR testi sirasinda (hangi ekranda olursa olsun) 100ms aralikla olcum
+static unsigned long currentReadInterval() {
   if (currentMenu == MENU_GESTURE) {
-    readInterval = GESTURE_READ_MS;
-  } else if (currentMenu == MENU_NTC && ntcTestRunning) {
-    readInterval = NTC_SAMPLE_INTERVAL_MS;
-  } else if (currentMenu == MENU_IR_TEMP && irTestRunning) {
-    readInterval = NTC_SAMPLE_INTERVAL_MS;  // NTC ile ayni: 100ms
-  } else {
-    readInterval = READ_INTERVAL_MS;
+    return stm32LinkBinaryFrames() ? GESTURE_READ_BIN_MS : GESTURE_READ_MS;
+  } else if (sampleAccumulatorRunning(ntcSampler) || sampleAccumulatorRunning(irSampler)) {
+    return NTC_SAMPLE_INTERVAL_MS;  // IR de NTC ile ayni: 100ms
   }
-  if (currentMenu != MENU_LOADCELL && now - lastRead >= readInterval) {
-    lastRead = now;
+  return READ_INTERVAL_MS;
+}
+
+// Akis gelmiyorsa eski usul $A polling (loadcell menusunde hat $W okumalarina kalir)
+static void readJobTick(unsigned long now) {
+  if (currentMenu != MENU_LOADCELL && !stm32LinkStreaming()) {
     readSTM32Data();
-    // Veri gelince ekrani hemen guncelle (gecikmesiz yazdir)
-    if (screenNeedsUpdate) {
-      screenNeedsUpdate = false;
-      drawCurrentScreen();
-    }
-  }
-  
-  // Periyodik ekran yenileme (veri gelmese bile)
-  unsigned long screenUpdateInterval = (currentMenu == MENU_GESTURE) ? GESTURE_SCREEN_MS : SCREEN_UPDATE_MS;
-  if (now - lastScreenUpdate >= screenUpdateInterval) {
-    lastScreenUpdate = now;
-    drawCurrentScreen();
   }
+}
 
-  // NTC/IR sensör, fan, gesture ve projeksiyon hata durumunu periyodik yenile (test calisirken degil)
-  if (now - lastSensorStatusCheck >= SENSOR_STATUS_REFRESH_MS) {
-    if (currentMenu == MENU_NTC && !ntcTestRunning) {
-      int irStatusTemp = 0;
-      if (getSensorStatus(ntcSensorStatus, irStatusTemp)) {
-        ntcSensorStatusValid = true;
-        ntcSensorDisconnected = (ntcSensorStatus == 1);
-      }
-      lastSensorStatusCheck = now;
-      delay(40);
-      drawNTCScreen();
-    } else if (currentMenu == MENU_IR_TEMP && !irTestRunning) {
-      int ntcStatusTemp = 0;
-      if (getSensorStatus(ntcStatusTemp, irSensorStatus)) {
-        irSensorStatusValid = true;
-        irSensorDisconnected = (irSensorStatus == 1);
-      }
-      lastSensorStatusCheck = now;
-      delay(40);
-      drawIRTempScreen();
-    } else if (currentMenu == MENU_INTAKE_FAN) {
-      // Test kosarken UART karmasasi olusmasin diye periyodik $X sorgusunu durdur.
-      if (!intakeFanTestRunning) {
-        int ntcDummy = 0;
-        int irDummy  = 0;
-        getSensorStatus(ntcDummy, irDummy);
-      }
-      lastSensorStatusCheck = now;
-      delay(40);
-      drawIntakeFanScreen();
-    } else if (currentMenu == MENU_EXHAUST_FAN) {
-      // Test kosarken UART karmasasi olusmasin diye periyodik $X sorgusunu durdur.
-      if (!exhaustFanTestRunning) {
-        int ntcDummy = 0;
-        int irDummy  = 0;
-        getSensorStatus(ntcDummy, irDummy);
-      }
-      lastSensorStatusCheck = now;
-      delay(40);
-      drawExhaustFanScreen();
-    } else if (currentMenu == MENU_PROJEKSIYON) {
-      // Projeksiyon menüsünde $X ile projeksiyon sensor status de guncelle
-      int ntcDummy = 0;
-      int irDummy  = 0;
-      if (getSensorStatus(ntcDummy, irDummy)) {
-        // projector_sensor_status global olarak guncellendi
-        screenNeedsUpdate = true;
-      }
-      lastSensorStatusCheck = now;
-      delay(40);
-    } else {
-      lastSensorStatusCheck = now;
-    }
+// Periyodik gorunum kontrolu (veri gelmese bile: sayaclar, test fazlari). Ekran yalnizca
+// gorunum modeli degistiyse cizilir.
+static void screenJobTick(unsigned long now) {
+  drawCurrentScreen();
+}
+
+// NTC/IR sensör, fan, gesture ve projeksiyon hata durumunu periyodik yenile (test calisirken degil).
+// $X cevabi beklenmez; $A ile ayni anda yolda olabilir, cevap onSensorStatusReply() ile islenir.
+static void sensorStatusJobTick(unsigned long now) {
+  int g = fanGroupForMenu(currentMenu);
+  bool wantStatus =
+    (currentMenu == MENU_NTC && !sampleAccumulatorRunning(ntcSampler)) ||
+    (currentMenu == MENU_IR_TEMP && !sampleAccumulatorRunning(irSampler)) ||
+    (g >= 0 && !testRunnerBusy(fanGroupStates[g].test)) ||
+    currentMenu == MENU_PROJEKSIYON;
+  if (wantStatus && !stm32LinkIsPending(STM32_REQ_STATUS)) {
+    stm32LinkRequest(STM32_REQ_STATUS, "$X", READ_TIMEOUT_MS, onSensorStatusReply);
   }
+}
 
-  // Loadcell sonuc ekraninda 4 degeri periyodik guncelle
-  if (currentMenu == MENU_LOADCELL && loadcellScreenMode == 1) {
-    if (now - lastLoadcellUpdate >= LOADCELL_UPDATE_MS) {
-      lastLoadcellUpdate = now;
+// Loadcell sonuc ekraninda 4 degeri periyodik guncelle
+static void loadcellJobTick(unsigned long now) {
+  if (currentMenu != MENU_LOADCELL || loadcellScreenMode != 1) return;
+
+  // Onceki yenileme (veya menuye donus bekleme fazi) suruyor
+  if (loadcellTestPhase != LOADCELL_TEST_IDLE) return;
+
+  // Her yenilemede once force_sensor_status'u kontrol et, sonra 4 degeri oku. Cevaplar
+  // beklenmez: fazlar updateLoadcellTest() ile ilerler (test isi, TEST_TICK_MS)
+  loadcellStatusDone = false;
+  loadcellStatusOk = false;
+  loadcellForceStatus = 0;
+  stm32LinkRequest(STM32_REQ_STATUS, "$X", READ_TIMEOUT_MS, onLoadcellStatusReply);
+  setLoadcellTestPhase(LOADCELL_REFRESH_STATUS, now);
+}
+
+// Test adimlari (fan, fren, RGB, motor, loadcell, projeksiyon), NTC/IR test timeout kontrolu
+// ve "Tumunu Test Et" kosusu (testler menuden bagimsiz ilerler)
+static void testJobTick(unsigned long now) {
+  PROFILE_ZONE(PROFILE_TEST_JOB);
+  updateFanTests();
+  updateBrakeMotorTest();
+  updateRGBLedTest();
+  updateMotorTest();
+  updateLoadcellTest();
+  updateProjectorTest();
+  updateGestureTest();
+
+  // NTC / IR testi icin timeout kontrolu (olcum varsa ortalamaya gore, yoksa FAIL)
+  if (sampleAccumulatorRunning(ntcSampler) && now - ntcSampler.startMs > NTC_TEST_TIMEOUT_MS) {
+    sampleAccumulatorTimeout(ntcSampler, now);
+  }
+  if (sampleAccumulatorRunning(irSampler) && now - irSampler.startMs > IR_TEST_TIMEOUT_MS) {
+    sampleAccumulatorTimeout(irSampler, now);
+  }
 
-      // Her yenilemede once force_sensor_status'u kontrol et
-      int ntcDummy2 = 0, irDummy2 = 0;
-      if (!getSensorStatus(ntcDummy2, irDummy2) || force_sensor_status == 1) {
-        // Loadcell sensorde hata olursa hemen HATA ekranina gec
-        loadcellErrorType = (force_sensor_status == 1) ? 1 : 0;
-        loadcellScreenMode = 2;
-        drawLoadcellScreen();
-      } else {
-        // Hata yoksa 4 loadcell degerini guncelle
-        float v1 = loadcell1_g;
-        float v2 = loadcell2_g;
-        float v3 = loadcell3_g;
-        float v4 = loadcell4_g;
-        int readFaultMask = 0;
-
-        if (readAllLoadcellValues(v1, v2, v3, v4, &readFaultMask)) {
-          loadcell1_g = v1;
-          loadcell2_g = v2;
-          loadcell3_g = v3;
-          loadcell4_g = v4;
-          screenNeedsUpdate = true;
-        } else {
-          loadcellErrorType = 0;
-          loadcellFaultMask = readFaultMask | getLoadcellFaultMask(v1, v2, v3, v4);
-          loadcellScreenMode = 2;
-          drawLoadcellScreen();
-        }
-      }
-    }
+  updateRunAll();
+}
+
+// Serial debug konsolu: satir sonuna kadar biriktir, komutu calistir
+//   prof        profiler tablosu (profiler.h) + ekran aktarim sayaclari
+//   prof reset  olcum penceresini sifirla
+static char     consoleLine[CONSOLE_LINE_MAX];
+static size_t   consoleLen = 0;
+static uint32_t consoleFlushBase = 0;  // prof reset anindaki display sayaclari
+static uint32_t consoleSentBase = 0;
+static uint32_t consoleSkippedBase = 0;
+
+static void runConsoleCommand(const char* cmd) {
+  if (strcmp(cmd, "prof") == 0) {
+    profilerDump(Serial);
+    Serial.printf("ekran: %lu flush, %lu bayt gonderildi, %lu bayt atlandi\r\n",
+                  (unsigned long)(display.flushCount() - consoleFlushBase),
+                  (unsigned long)(display.bytesSent() - consoleSentBase),
+                  (unsigned long)(display.bytesSkipped() - consoleSkippedBase));
+  } else if (strcmp(cmd, "prof reset") == 0) {
+    profilerReset();
+    consoleFlushBase   = display.flushCount();
+    consoleSentBase    = display.bytesSent();
+    consoleSkippedBase = display.bytesSkipped();
+    Serial.println("profiler: sifirlandi");
+  } else if (cmd[0] != '\0') {
+    Serial.println("komutlar: prof, prof reset");
   }
+}
 
-  // NTC testi icin timeout kontrolu
-  if (currentMenu == MENU_NTC && ntcTestRunning && ntcTestStartTime > 0) {
-    if (now - ntcTestStartTime > NTC_TEST_TIMEOUT_MS) {
-      ntcTestRunning = false;
-      ntcHasResult   = true;
-      if (ntcSampleCount > 0) {
-        ntcAverageTemp = ntcSampleSum / ntcSampleCount;
-        ntcStatusSuccess = (ntcAverageTemp >= 0.0f && ntcAverageTemp <= 100.0f);
-      } else {
-        ntcAverageTemp   = 0.0f;
-        ntcStatusSuccess = false;
-      }
-      drawNTCScreen();
+static void consoleJobTick(unsigned long now) {
+  while (Serial.available() > 0) {
+    int c = Serial.read();
+    if (c < 0) break;
+    if (c == '\r' || c == '\n') {
+      consoleLine[consoleLen] = '\0';
+      runConsoleCommand(consoleLine);
+      consoleLen = 0;
+    } else if (consoleLen < sizeof(consoleLine) - 1) {
+      consoleLine[consoleLen++] = (char)c;
     }
   }
+}
 
-  // IR Temp testi icin timeout kontrolu (NTC ile ayni)
-  if (currentMenu == MENU_IR_TEMP && irTestRunning && irTestStartTime > 0) {
-    if (now - irTestStartTime > IR_TEST_TIMEOUT_MS) {
-      irTestRunning = false;
-      irHasResult   = true;
-      if (irSampleCount > 0) {
-        irAverageTemp = irSampleSum / irSampleCount;
-        irStatusSuccess = (irAverageTemp >= 0.0f && irAverageTemp <= 100.0f);
-      } else {
-        irAverageTemp   = 0.0f;
-        irStatusSuccess = false;
-      }
-      drawIRTempScreen();
-    }
+static void registerLoopJobs() {
+  readJob         = schedulerAdd(readJobTick, READ_INTERVAL_MS, READ_INTERVAL_MS);
+  screenJob       = schedulerAdd(screenJobTick, SCREEN_UPDATE_MS);
+  sensorStatusJob = schedulerAdd(sensorStatusJobTick, SENSOR_STATUS_REFRESH_MS);
+  loadcellJob     = schedulerAdd(loadcellJobTick, LOADCELL_UPDATE_MS);
+  testJob         = schedulerAdd(testJobTick, TEST_TICK_MS);
+  consoleJob      = schedulerAdd(consoleJobTick, CONSOLE_POLL_MS);
+}
+
+// loop() govdesi: uyku haric bir tur
+static void loopStep() {
+  PROFILE_ZONE(PROFILE_LOOP);
+
+  // Menu guncelle
+  updateMenu();
+
+  // Arka planda tamamlanan cevaplari isle; veri gelince ekrani hemen guncelle (gecikmesiz yazdir)
+  if (pollSTM32Link() && screenNeedsUpdate) {
+    screenNeedsUpdate = false;
+    drawCurrentScreen();
   }
-  
-  delay(LOOP_DELAY_MS);
+
+  // Menuye gore periyotlar; degismisse yeni deadline son calismadan itibaren sayilir
+  unsigned long readInterval = currentReadInterval();
+  schedulerSetPeriod(readJob, readInterval);
+  schedulerSetPeriod(screenJob, (currentMenu == MENU_GESTURE) ? GESTURE_SCREEN_MS : SCREEN_UPDATE_MS);
+  // Akis: STM32 $A satirini readInterval aralikla kendisi gonderir (loadcell menusunde kapali)
+  stm32LinkSubscribe(currentMenu == MENU_LOADCELL ? 0 : readInterval);
+
+  schedulerRunDue();
+}
+
+void loop() {
+  loopStep();
+  // Bir sonraki ise, encoder/buton kesmesine veya STM32 cevabina kadar uyu
+  schedulerSleep();
 }
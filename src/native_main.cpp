@@ -0,0 +1,633 @@
+#ifndef ARDUINO
+
+// Host calistirici ([env:native])
+// `pio run -e native` ile derlenir, `.pio/build/native/program <komut>` ile calisir.
+// Donanimdan bagimsiz firmware modullerini sahte HAL (hal_host.h) ve sanal saatle calistirir;
+// her komut bir senaryodur ve sonucunu stdout'a yazar.
+
+#include <chrono>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#if defined(__unix__) || defined(__APPLE__)
+#include <time.h>
+#include <unistd.h>
+#endif
+
+#include <Arduino.h>
+#include <Wire.h>
+
+#include "frame_diff.h"
+#include "hal_host.h"
+#include "parser_fuzz.h"
+#include "profiler.h"
+#include "run_all.h"
+#include "scheduler.h"
+#include "stm32_decode.h"
+#include "stm32_fields.h"
+#include "stm32_link.h"
+#include "stm32_model.h"
+
+struct HostCommand {
+  const char* name;
+  const char* help;
+  int (*run)(int argc, char** argv);
+};
+
+// --- scheduler: firmware'deki is periyotlariyla N sanal saniye ---
+#define HOST_SCHED_JOBS 3
+
+static const unsigned long hostSchedPeriods[HOST_SCHED_JOBS] = { 50, 100, 10 };  // $A, $X, test
+static unsigned long hostSchedRuns[HOST_SCHED_JOBS];
+
+template <int job>
+static void hostSchedJob(unsigned long) {
+  hostSchedRuns[job]++;
+}
+
+static int cmdScheduler(int argc, char** argv) {
+  unsigned long seconds = argc > 0 ? strtoul(argv[0], nullptr, 10) : 10;
+  FakeClock &clock = hostClock();
+  schedulerBegin();
+  schedulerAdd(hostSchedJob<0>, hostSchedPeriods[0]);
+  schedulerAdd(hostSchedJob<1>, hostSchedPeriods[1]);
+  schedulerAdd(hostSchedJob<2>, hostSchedPeriods[2]);
+
+  unsigned long endMs = clock.millis() + seconds * 1000;
+  unsigned long loops = 0;
+  while ((long)(clock.millis() - endMs) < 0) {
+    schedulerRunDue();
+    schedulerSleep();
+    loops++;
+  }
+  printf("scheduler: %lu s sanal, %lu loop turu, uyku %.1f%%\n", seconds, loops,
+         100.0 * clock.sleptMicros() / clock.nowMicros());
+  for (int j = 0; j < HOST_SCHED_JOBS; j++) {
+    printf("  is %d: periyot %lu ms, %lu calisma (beklenen %lu)\n", j, hostSchedPeriods[j],
+           hostSchedRuns[j], seconds * 1000 / hostSchedPeriods[j]);
+  }
+  return 0;
+}
+
+// --- frame: ekran farki, tipik degisimlerde gonderilen bayt ---
+static int cmdFrame(int, char**) {
+  static FrameDiff diff;
+  HostFrameRecorder panel;
+  uint8_t buffer[FRAME_DIFF_MAX_BUFFER];
+  memset(buffer, 0, sizeof(buffer));
+  for (int i = 0; i < (int)sizeof(buffer); i++) buffer[i] = (uint8_t)(i * 37);
+
+  frameDiffBegin(diff, 128, 64);
+  printf("frame: ilk kare %u bayt\n", (unsigned)frameDiffFlush(diff, buffer, panel));
+  printf("frame: ayni kare %u bayt\n", (unsigned)frameDiffFlush(diff, buffer, panel));
+  buffer[3 * 128 + 60] ^= 0xFF;
+  printf("frame: tek bayt %u bayt\n", (unsigned)frameDiffFlush(diff, buffer, panel));
+  printf("frame: panel %s, %u aralik\n",
+         memcmp(panel.panel, buffer, sizeof(buffer)) == 0 ? "esit" : "FARKLI", (unsigned)panel.spans);
+  return memcmp(panel.panel, buffer, sizeof(buffer)) == 0 ? 0 : 1;
+}
+
+// --- sim: STM32 modeli bellek ici hatta, ESP32 tarafi basit bir istemci ---
+// Model hostStm32Link()'in karsi ucunda sanal saatin her ms'sinde calisir.
+#define SIM_REPLY_TIMEOUT_MS 150  // READ_TIMEOUT_MS ile ayni
+#define SIM_FAULT_ROUNDS     2000
+
+static Stm32Model simModel;
+
+static void simTick(unsigned long nowMs, void*) {
+  stm32ModelService(simModel, hostStm32Link().peer, nowMs);
+}
+
+// Hat hatalari: [kayip_ppm] [bozulma_ppm] [gecikme_ms] [jitter_ms]
+static void simParseLink(int argc, char** argv, Stm32ModelLink &link) {
+  if (argc > 0) link.lossPpm    = strtoul(argv[0], nullptr, 10);
+  if (argc > 1) link.corruptPpm = strtoul(argv[1], nullptr, 10);
+  if (argc > 2) link.latencyMs  = strtoul(argv[2], nullptr, 10);
+  if (argc > 3) link.jitterMs   = strtoul(argv[3], nullptr, 10);
+}
+
+static void simSend(const char* cmd) {
+  HostStreamEnd &esp = hostStm32Link().firmware;
+  esp.write((const uint8_t*)cmd, strlen(cmd));
+  esp.write((const uint8_t*)"\r\n", 2);
+}
+
+// Alim: ASCII satir ("\r\n" haric) veya ikili cerceve (CRC haric). Zaman asiminda 0,
+// CRC hatasinda -1 doner. Zaman asimi yarim kalan satiri/cerceveyi atar (yeniden senkron).
+static int simReadReply(char* out, size_t outLen, unsigned long timeoutMs) {
+  HostStreamEnd &esp = hostStm32Link().firmware;
+  FakeClock &clock = hostClock();
+  unsigned long start = clock.millis();
+  size_t len = 0;
+  int binLen = -1;  // >= 0: ikili cerceve toplaniyor
+  while (clock.millis() - start < timeoutMs) {
+    uint8_t b;
+    if (esp.read(&b, 1) == 0) {
+      clock.advanceMs(1);
+      continue;
+    }
+    if (len == 0 && binLen < 0 && b == STM32_BIN_SYNC) {
+      binLen = 0;
+      out[len++] = (char)b;
+      continue;
+    }
+    if (binLen >= 0) {
+      if (len >= outLen) return -1;
+      out[len++] = (char)b;
+      if (len == 2) binLen = b;
+      if (len < 2 || (int)len < 2 + binLen + 2) continue;
+      const uint8_t* f = (const uint8_t*)out;
+      uint16_t crc = (uint16_t)f[2 + binLen] | ((uint16_t)f[3 + binLen] << 8);
+      return stm32LinkCrc16(f + 1, 1 + binLen) == crc ? 2 + binLen : -1;
+    }
+    if (b == '\n') {
+      if (len == 0) continue;
+      out[len] = '\0';
+      return (int)len;
+    }
+    if (b != '\r' && len + 1 < outLen) out[len++] = (char)b;
+  }
+  return 0;
+}
+
+// Istek gonder ve cevabi bekle; gidis-donus suresi rttMs'e
+static int simTransact(const char* cmd, char* reply, size_t replyLen, unsigned long &rttMs) {
+  unsigned long start = hostClock().millis();
+  simSend(cmd);
+  int n = simReadReply(reply, replyLen, SIM_REPLY_TIMEOUT_MS);
+  rttMs = hostClock().millis() - start;
+  return n;
+}
+
+static const Stm32Field simIntField = stm32IntField(nullptr, true);
+static const Stm32Field simDataSchema[STM32_DATA_FIELDS] = {
+  simIntField, simIntField, simIntField, simIntField, simIntField, simIntField, simIntField, simIntField,
+  simIntField, simIntField, simIntField, simIntField, simIntField, simIntField, simIntField, simIntField
+};
+static const Stm32Field simStatusSchema[STM32_MODEL_STATUS_FIELDS] = {
+  simIntField, simIntField, simIntField, simIntField, simIntField, simIntField, simIntField, simIntField
+};
+static const Stm32Field simLoadcellSchema[1] = { stm32DecimalField(nullptr, 2) };
+
+// $A iste ve ASCII alanlari values'a ac (basarisizsa false)
+static bool simReadData(int32_t (&values)[STM32_DATA_FIELDS]) {
+  char reply[STM32_LINE_MAX];
+  unsigned long rtt;
+  if (simTransact("$A", reply, sizeof(reply), rtt) <= 0) return false;
+  return stm32ParseFields(reply, simDataSchema, values) == STM32_DATA_FIELDS;
+}
+
+static int cmdSim(int argc, char** argv) {
+  FakeClock &clock = hostClock();
+  char reply[STM32_LINE_MAX];
+  int32_t v[STM32_DATA_FIELDS];
+  unsigned long rtt;
+  stm32ModelBegin(simModel);
+  clock.setTickHook(simTick, nullptr);
+
+  // 1) Temel istek / cevap
+  int n = simTransact("$A", reply, sizeof(reply), rtt);
+  printf("sim: $A -> %s (%lu ms, %d byte)\n", n > 0 ? reply : "CEVAP YOK", rtt, n);
+  n = simTransact("$X", reply, sizeof(reply), rtt);
+  printf("sim: $X -> %s (%lu ms)\n", n > 0 ? reply : "CEVAP YOK", rtt);
+
+  // 2) Fan: %100 duty'ye birinci dereceden yanit, olu fan $X'te hata
+  simSend("$F11999");
+  simSend("$F21999");
+  printf("sim: intake %%100, RPM (x10):");
+  for (int i = 0; i < 12; i++) {
+    clock.advanceMs(250);
+    if (simReadData(v)) printf(" %ld", (long)v[4]);
+  }
+  printf("\n");
+  simModel.fanMaxRpm[1] = 0.0f;  // intake 2 durdu
+  clock.advanceMs(STM32_MODEL_FAN_TAU_MS * 5 + STM32_MODEL_FAN_ERR_MS);
+  n = simTransact("$X", reply, sizeof(reply), rtt);
+  printf("sim: intake2 durdu, $X -> %s\n", n > 0 ? reply : "CEVAP YOK");
+
+  // 3) Motor: Y hat sonuna kadar surulur, stop switch'inde durur
+  simSend("$SYE");
+  simSend("$SY1,150000,20000");
+  unsigned long moveStart = clock.millis();
+  unsigned long moveMs = 0;
+  while (clock.millis() - moveStart < 10000) {
+    clock.advanceMs(20);
+    if (simReadData(v) && (v[15] & STM32_MOTOR_BUSY_Y) == 0) {
+      moveMs = clock.millis() - moveStart;
+      break;
+    }
+  }
+  printf("sim: Y 150000 adim @20000/s -> %lu ms sonra durdu, Y_R=%ld, stop'ta duran %u\n", moveMs,
+         (long)v[9], (unsigned)simModel.stats.limitHits);
+
+  // 4) Loadcell: tare sonrasi +-15 g'ye oturma
+  simSend("$WT");
+  unsigned long tareStart = clock.millis();
+  float grams = 0.0f;
+  while (clock.millis() - tareStart < 7000) {
+    int32_t raw[1];
+    if (simTransact("$W4", reply, sizeof(reply), rtt) > 0 &&
+        stm32ParseFields(reply, simLoadcellSchema, raw) == 1) {
+      grams = stm32FieldValue(simLoadcellSchema[0], raw[0]);
+      if (grams > -15.0f && grams < 15.0f) break;
+    }
+    clock.advanceMs(100);
+  }
+  printf("sim: $WT -> L4 %lu ms'de %.2f g\n", clock.millis() - tareStart, grams);
+
+  // 5) Hat hatalari altinda ayristirma: ASCII $X (kontrol yok) ve ikili $A (CRC)
+  simModel.fanMaxRpm[1] = STM32_MODEL_FAN_MAX_RPM;
+  simSend("$F10");
+  simSend("$F20");
+  clock.advanceMs(100);
+  simModel.link.lossPpm = 200;
+  simModel.link.corruptPpm = 200;
+  simModel.link.jitterMs = 3;
+  simParseLink(argc, argv, simModel.link);
+  printf("sim: hat kayip %u ppm, bozulma %u ppm, gecikme %lu+0..%lu ms, %d tur\n",
+         (unsigned)simModel.link.lossPpm, (unsigned)simModel.link.corruptPpm,
+         simModel.link.latencyMs, simModel.link.jitterMs, SIM_FAULT_ROUNDS);
+
+  int ok = 0, silent = 0, rejected = 0, lost = 0;
+  unsigned long rttMax = 0;
+  for (int i = 0; i < SIM_FAULT_ROUNDS; i++) {
+    int32_t raw[STM32_MODEL_STATUS_FIELDS];
+    n = simTransact("$X", reply, sizeof(reply), rtt);
+    if (n > 0 && rtt > rttMax) rttMax = rtt;
+    if (n <= 0) {
+      lost++;
+    } else if (stm32ParseFields(reply, simStatusSchema, raw) != STM32_MODEL_STATUS_FIELDS) {
+      rejected++;
+    } else if (strcmp(reply, "$0,0,0,0,0,0,0,0") != 0) {
+      silent++;  // gecerli gorunen ama yanlis deger: ASCII'de yakalanamaz
+    } else {
+      ok++;
+    }
+  }
+  printf("  ASCII $X : %d dogru, %d reddedildi, %d sessiz bozuk, %d cevapsiz, en uzun %lu ms\n",
+         ok, rejected, silent, lost, rttMax);
+
+  simModel.link.lossPpm = 0;
+  simModel.link.corruptPpm = 0;
+  n = simTransact("$AB1", reply, sizeof(reply), rtt);
+  simParseLink(argc, argv, simModel.link);
+  if (argc == 0) {
+    simModel.link.lossPpm = 200;
+    simModel.link.corruptPpm = 200;
+  }
+  ok = rejected = lost = 0;
+  for (int i = 0; i < SIM_FAULT_ROUNDS; i++) {
+    n = simTransact("$A", reply, sizeof(reply), rtt);
+    if (n == 0) lost++;
+    else if (n < 0 || (uint8_t)reply[0] != STM32_BIN_SYNC) rejected++;
+    else ok++;
+  }
+  printf("  ikili $A : %d dogru, %d CRC/cerceve hatasi, %d cevapsiz\n", ok, rejected, lost);
+
+  const Stm32ModelStats &st = simModel.stats;
+  printf("sim: model %u komut (%u taninmadi), %u cevap, %llu/%llu byte giris/cikis, "
+         "%u kayip, %u bozuk\n",
+         (unsigned)st.commands, (unsigned)st.unknownCommands, (unsigned)st.replies,
+         (unsigned long long)st.bytesIn, (unsigned long long)st.bytesOut,
+         (unsigned)st.bytesLost, (unsigned)st.bytesCorrupted);
+  clock.setTickHook(nullptr, nullptr);
+  return 0;
+}
+
+#if defined(__unix__) || defined(__APPLE__)
+// --- sim-pty: ayni model gercek zamanda bir pty'de (seri terminal / socat / ESP32 koprusu) ---
+static unsigned long realMillis() {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (unsigned long)(ts.tv_sec * 1000UL + ts.tv_nsec / 1000000UL);
+}
+
+static int cmdSimPty(int argc, char** argv) {
+  unsigned long seconds = argc > 0 ? strtoul(argv[0], nullptr, 10) : 0;
+  char name[64];
+  int fd = hostOpenPty(name, sizeof(name));
+  if (fd < 0) {
+    perror("sim-pty");
+    return 1;
+  }
+  HostFdStream stream(fd);
+  stm32ModelBegin(simModel, (uint32_t)realMillis());
+  if (argc > 1) simParseLink(argc - 1, argv + 1, simModel.link);
+  printf("sim-pty: STM32 modeli %s uzerinde (%s)\n", name, seconds ? "sureli" : "Ctrl+C ile cik");
+  fflush(stdout);
+
+  unsigned long start = realMillis();
+  while (seconds == 0 || realMillis() - start < seconds * 1000) {
+    stm32ModelService(simModel, stream, realMillis());
+    usleep(1000);
+  }
+  printf("sim-pty: %u komut, %u cevap, %u akis satiri\n", (unsigned)simModel.stats.commands,
+         (unsigned)simModel.stats.replies, (unsigned)simModel.stats.streamLines);
+  close(fd);
+  return 0;
+}
+#endif
+
+// --- bench: gercek firmware (main.cpp setup/loop) STM32 modeline karsi, menu testlerinin takt suresi ---
+// Sanal saatte sure yalnizca uyku (zamanlayici bekliyor), delay() ve bloklayan STM32 beklemesiyle
+// ilerler; islemci suresi sifirdir. Bu yuzden sure = uyku + delay, io-blok delay'in parcasidir
+// (stm32LinkTransact / stm32LinkWaitUntil / dolu kuyruk). Kalan "delay" testlerin ve ekranin
+// sabit beklemeleridir; kisaltilabilecek sure once bu iki sutunda aranir.
+// Argumansiz: once her test tek tek, sonra toplu kosu. "all": yalnizca toplu kosu. Test adi:
+// yalnizca o test.
+#define BENCH_TEST_LIMIT_MS 180000  // tek test / toplu kosu icin ust sinir (sanal)
+#define BENCH_SETTLE_MS     1000    // testler arasi bosta bekleme (fanlar durur, akis biter)
+
+struct BenchCounters {
+  uint64_t us;
+  uint64_t sleptUs;
+  uint64_t delayedUs;
+  uint32_t blockedMs;
+  uint64_t txBytes;      // ESP32 -> STM32
+  uint64_t rxBytes;      // STM32 -> ESP32
+  uint32_t roundTrips;   // cevabi gelen istek
+  uint32_t timeouts;
+  uint32_t replyWaitMs;  // isteklerin cevap bekleme toplami (asenkron dahil)
+  uint64_t i2cBytes;     // OLED
+};
+
+static void benchTick(unsigned long nowMs, void*) {
+  stm32ModelService(simModel, hostStm32Link().peer, nowMs);
+  stm32LinkHostPoll();
+}
+
+static BenchCounters benchSnapshot() {
+  FakeClock &clock = hostClock();
+  BenchCounters c;
+  c.us          = clock.nowMicros();
+  c.sleptUs     = clock.sleptMicros();
+  c.delayedUs   = clock.delayedMicros();
+  c.blockedMs   = stm32LinkBlockedMs();
+  c.txBytes     = hostStm32Link().toPeer.totalBytes;
+  c.rxBytes     = hostStm32Link().toFirmware.totalBytes;
+  c.roundTrips  = stm32LinkRoundTrips();
+  c.timeouts    = stm32LinkTimeouts();
+  c.replyWaitMs = stm32LinkReplyWaitMs();
+  c.i2cBytes    = Wire.bytes;
+  return c;
+}
+
+static void benchPrintHeader() {
+  printf("  %-12s %-6s %8s %8s %8s %8s %7s %7s %5s %5s %7s %8s\n", "test", "sonuc", "sure_ms",
+         "uyku_ms", "delay_ms", "io_ms", "tx_B", "rx_B", "tur", "kayip", "cvp_ms", "i2c_B");
+}
+
+static void benchPrintRow(const char* name, const char* result, const BenchCounters &a,
+                          const BenchCounters &b) {
+  unsigned long blocked = b.blockedMs - a.blockedMs;
+  unsigned long delayed = (unsigned long)((b.delayedUs - a.delayedUs) / 1000);
+  printf("  %-12s %-6s %8lu %8lu %8lu %8lu %7lu %7lu %5lu %5lu %7lu %8lu\n", name, result,
+         (unsigned long)((b.us - a.us) / 1000), (unsigned long)((b.sleptUs - a.sleptUs) / 1000),
+         delayed > blocked ? delayed - blocked : 0, blocked,
+         (unsigned long)(b.txBytes - a.txBytes), (unsigned long)(b.rxBytes - a.rxBytes),
+         (unsigned long)(b.roundTrips - a.roundTrips), (unsigned long)(b.timeouts - a.timeouts),
+         (unsigned long)(b.replyWaitMs - a.replyWaitMs), (unsigned long)(b.i2cBytes - a.i2cBytes));
+}
+
+// Sure dolana veya busy() false olana kadar loop(); sure dolarsa false
+static bool benchRunUntil(bool (*busy)(), unsigned long limitMs) {
+  FakeClock &clock = hostClock();
+  unsigned long start = clock.millis();
+  while (busy()) {
+    if (clock.millis() - start >= limitMs) return false;
+    loop();
+  }
+  return true;
+}
+
+static bool runAllBusy() {
+  return testSuiteBusy(runAllSuite);
+}
+
+// Serial susturulmus olsa da stdout'a yazan Print (profiler tablosu icin)
+class StdoutPrint : public Print {
+public:
+  size_t write(uint8_t c) override { return fputc(c, stdout) == EOF ? 0 : 1; }
+};
+
+static int cmdBench(int argc, char** argv) {
+  const char* only = nullptr;  // tek test (ad) veya "all"
+  bool profile = false;        // -p: setup sonrasi profiler tablosu (gercek ns, -D PROFILER)
+  for (int i = 0; i < argc; i++) {
+    if (strcmp(argv[i], "-v") == 0) hostSerialEcho(true);
+    else if (strcmp(argv[i], "-p") == 0) profile = true;
+    else only = argv[i];
+  }
+  FakeClock &clock = hostClock();
+  stm32ModelBegin(simModel);
+  clock.setTickHook(benchTick, nullptr);
+
+  BenchCounters a = benchSnapshot();
+  setup();
+  BenchCounters b = benchSnapshot();
+  printf("bench: firmware STM32 modeline karsi, sanal saat (sure = uyku + delay; io delay'in parcasi)\n");
+  benchPrintHeader();
+  benchPrintRow("setup", "-", a, b);
+  profilerReset();
+
+  int count = 0;
+  const TestSuiteEntry* entries = runAllEntries(count);
+  int failed = 0;
+  bool runAllOnly = (only != nullptr && strcmp(only, "all") == 0);
+  for (int i = 0; i < count && !runAllOnly; i++) {
+    if (only != nullptr && strcmp(only, entries[i].name) != 0) continue;
+    a = benchSnapshot();
+    prepareRunAll();
+    entries[i].start();
+    bool done = benchRunUntil(entries[i].busy, BENCH_TEST_LIMIT_MS);
+    if (!done) entries[i].abort();
+    b = benchSnapshot();
+    bool ok = done && entries[i].passed();
+    if (!ok) failed++;
+    benchPrintRow(entries[i].name, !done ? "SURE" : ok ? "OK" : "FAIL", a, b);
+    // Bir sonraki test temiz baslasin (motor / fan / akis)
+    unsigned long settle = clock.millis();
+    while (clock.millis() - settle < BENCH_SETTLE_MS) loop();
+  }
+
+  if (only == nullptr || runAllOnly) {
+    a = benchSnapshot();
+    startRunAll();
+    bool done = benchRunUntil(runAllBusy, BENCH_TEST_LIMIT_MS);
+    b = benchSnapshot();
+    int passed = testSuiteCount(runAllSuite, TEST_SUITE_PASS);
+    if (!done || passed != count) failed++;
+    char result[16];
+    snprintf(result, sizeof(result), "%d/%d", passed, count);
+    benchPrintRow("Tumunu Test", done ? result : "SURE", a, b);
+    for (int i = 0; i < runAllSuite.entryCount; i++) {
+      printf("    %-12s %-6s %8lu\n", entries[i].name,
+             runAllSuite.results[i] == TEST_SUITE_PASS ? "OK" : "FAIL", runAllSuite.durationMs[i]);
+    }
+  }
+  printf("bench: STM32 %u komut, %u cevap, %u taninmayan\n", (unsigned)simModel.stats.commands,
+         (unsigned)simModel.stats.replies, (unsigned)simModel.stats.unknownCommands);
+  if (profile) {
+    StdoutPrint out;
+    profilerDump(out);
+  }
+  clock.setTickHook(nullptr, nullptr);
+  return failed == 0 ? 0 : 1;
+}
+
+// --- parse-bench: STM32 cevap cozuculerinin gercek sureli verimi (ns/kare) ---
+// "ayristirma" satirlari yalnizca stm32_fields.h / cerceve acma, "firmware" satirlari main.cpp'deki
+// tam yol (ayristir + kareye yaz + yayinla + log satiri bicimlendir). Serial host'ta susturuldugu
+// icin UART'a yazma suresi dahil degildir. "hat" satiri bayttan cozucuye kadar tum alimdir.
+#define PARSE_BENCH_LINES 8
+
+static volatile int32_t parseBenchSink;
+
+static uint64_t realNanos() {
+  return (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+           std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+struct ParseBenchInput {
+  char    dataLines[PARSE_BENCH_LINES][STM32_LINE_MAX];
+  uint8_t frames[PARSE_BENCH_LINES][STM32_LINE_MAX];
+  char    statusLines[PARSE_BENCH_LINES][STM32_LINE_MAX];
+  char    loadcellLines[PARSE_BENCH_LINES][STM32_LINE_MAX];
+  uint8_t stream[PARSE_BENCH_LINES][STM32_LINE_MAX];  // "$A...\r\n"
+  size_t  streamLen[PARSE_BENCH_LINES];
+};
+
+// Model ornekleriyle gercekci satirlar (degerler degissin diye farkli anlar)
+static void parseBenchInputs(ParseBenchInput &in) {
+  stm32ModelBegin(simModel);
+  for (int i = 0; i < PARSE_BENCH_LINES; i++) {
+    int32_t v[STM32_DATA_FIELDS];
+    stm32ModelSample(simModel, 1000 + i * 733, v);
+    int n = snprintf(in.dataLines[i], STM32_LINE_MAX, "$%d", (int)v[0]);
+    for (int f = 1; f < STM32_DATA_FIELDS; f++) {
+      n += snprintf(in.dataLines[i] + n, STM32_LINE_MAX - n, ",%d", (int)v[f]);
+    }
+    stm32LinkEncodeDataFrame(v, in.frames[i]);
+    snprintf(in.statusLines[i], STM32_LINE_MAX, "$%d,%d,0,0,%d,0,0,1", i & 1, (i >> 1) & 1, (i >> 2) & 1);
+    snprintf(in.loadcellLines[i], STM32_LINE_MAX, "$%d.%02d", -150 + i * 37, (i * 13) % 100);
+    size_t len = strlen(in.dataLines[i]);
+    memcpy(in.stream[i], in.dataLines[i], len);
+    memcpy(in.stream[i] + len, "\r\n", 2);
+    in.streamLen[i] = len + 2;
+  }
+}
+
+static void onParseBenchData(const char* line, void*) {
+  if (stm32LinkIsDataFrame(line)) parseSTM32DataFrame(line);
+  else parseSTM32DataLine(line);
+}
+
+static void parseBenchRow(const char* name, uint32_t iterations, uint64_t ns, size_t bytes) {
+  double perFrame = (double)ns / iterations;
+  printf("  %-24s %9.1f %12.0f %6u\n", name, perFrame, 1e9 / perFrame, (unsigned)bytes);
+}
+
+static int cmdParseBench(int argc, char** argv) {
+  uint32_t iterations = argc > 0 ? (uint32_t)strtoul(argv[0], nullptr, 10) : 200000;
+  if (iterations == 0) iterations = 1;
+  static ParseBenchInput in;
+  parseBenchInputs(in);
+  printf("parse-bench: %u kare / satir\n", (unsigned)iterations);
+  printf("  %-24s %9s %12s %6s\n", "cozucu", "ns/kare", "kare/s", "bayt");
+
+  int32_t raw[STM32_DATA_FIELDS];
+  uint64_t t0 = realNanos();
+  for (uint32_t i = 0; i < iterations; i++) {
+    parseBenchSink += stm32ParseFields(in.dataLines[i % PARSE_BENCH_LINES], simDataSchema, raw);
+  }
+  parseBenchRow("$A ASCII ayristirma", iterations, realNanos() - t0, strlen(in.dataLines[0]));
+
+  t0 = realNanos();
+  for (uint32_t i = 0; i < iterations; i++) {
+    parseBenchSink += parseSTM32DataLine(in.dataLines[i % PARSE_BENCH_LINES]);
+  }
+  parseBenchRow("$A ASCII firmware", iterations, realNanos() - t0, strlen(in.dataLines[0]));
+
+  t0 = realNanos();
+  for (uint32_t i = 0; i < iterations; i++) {
+    parseBenchSink += stm32LinkDecodeDataFrame((const char*)in.frames[i % PARSE_BENCH_LINES], raw,
+                                               STM32_DATA_FIELDS);
+  }
+  parseBenchRow("$A ikili acma", iterations, realNanos() - t0, STM32_BIN_FRAME_LEN);
+
+  t0 = realNanos();
+  for (uint32_t i = 0; i < iterations; i++) {
+    parseBenchSink += parseSTM32DataFrame((const char*)in.frames[i % PARSE_BENCH_LINES]);
+  }
+  parseBenchRow("$A ikili firmware", iterations, realNanos() - t0, STM32_BIN_FRAME_LEN);
+
+  int ntc, ir;
+  t0 = realNanos();
+  for (uint32_t i = 0; i < iterations; i++) {
+    parseBenchSink += parseSensorStatusLine(in.statusLines[i % PARSE_BENCH_LINES], ntc, ir);
+  }
+  parseBenchRow("$X firmware", iterations, realNanos() - t0, strlen(in.statusLines[0]));
+
+  float value;
+  t0 = realNanos();
+  for (uint32_t i = 0; i < iterations; i++) {
+    parseBenchSink += parseLoadcellLine(in.loadcellLines[i % PARSE_BENCH_LINES], value);
+  }
+  parseBenchRow("$W firmware", iterations, realNanos() - t0, strlen(in.loadcellLines[0]));
+
+  // Hat: bayt -> satir birlestirici -> halka -> haberlesme turu -> veri handler'i
+  stm32LinkSetDataHandler(onParseBenchData);
+  stm32LinkBegin();
+  t0 = realNanos();
+  for (uint32_t i = 0; i < iterations; i++) {
+    int k = i % PARSE_BENCH_LINES;
+    stm32LinkFeed(in.stream[k], in.streamLen[k]);
+    stm32LinkHostPoll();
+  }
+  parseBenchRow("hat + $A ASCII firmware", iterations, realNanos() - t0, in.streamLen[0]);
+  return 0;
+}
+
+// --- fuzz: cozuculer icin dahili mutasyon surucusu (kapsama yonlendirmeli: libFuzzer, README) ---
+static int cmdFuzz(int argc, char** argv) {
+  uint32_t iterations = argc > 0 ? (uint32_t)strtoul(argv[0], nullptr, 10) : 1000000;
+  uint32_t seed = argc > 1 ? (uint32_t)strtoul(argv[1], nullptr, 10) : 1;
+  ParserFuzzStats stats;
+  uint64_t t0 = realNanos();
+  parserFuzzRun(iterations, seed, stats);
+  double seconds = (realNanos() - t0) / 1e9;
+  printf("fuzz: %u girdi, tohum %u, %.1f s, ihlal yok\n", (unsigned)iterations, (unsigned)seed, seconds);
+  for (int t = 0; t < PARSER_FUZZ_TARGETS; t++) {
+    printf("  %-9s %9u calisma %9u %s\n", parserFuzzTargetName(t), (unsigned)stats.runs[t],
+           (unsigned)stats.accepted[t], t == PARSER_FUZZ_LINK ? "cozulen satir" : "kabul");
+  }
+  return 0;
+}
+
+static const HostCommand hostCommands[] = {
+  { "scheduler", "[saniye]  zamanlayiciyi sanal saatle calistir", cmdScheduler },
+  { "frame",     "          ekran farki bayt sayilari",           cmdFrame },
+  { "sim",       "[kayip_ppm] [bozulma_ppm] [gecikme_ms] [jitter_ms]  STM32 modeli senaryosu", cmdSim },
+  { "parse-bench", "[kare]  STM32 cevap cozuculerinin ns/kare verimi", cmdParseBench },
+  { "fuzz",      "[girdi] [tohum]  cozuculer icin mutasyonlu fuzz (referans ayristiriciyla)", cmdFuzz },
+  { "bench",     "[test_adi|all] [-v] [-p]  menu testlerinin takt suresi (firmware + STM32 modeli)", cmdBench },
+#if defined(__unix__) || defined(__APPLE__)
+  { "sim-pty",   "[saniye] [kayip_ppm] ...  STM32 modelini pty'de gercek zamanda calistir", cmdSimPty },
+#endif
+};
+
+// libFuzzer derlemesinde main() libFuzzer'dan (parser_fuzz.h), pio test'te birim testinden gelir
+#if !defined(HOST_LIBFUZZER) && !defined(PIO_UNIT_TESTING)
+int main(int argc, char** argv) {
+  if (argc >= 2) {
+    for (const HostCommand &c : hostCommands) {
+      if (strcmp(argv[1], c.name) == 0) return c.run(argc - 2, argv + 2);
+    }
+  }
+  printf("kullanim: %s <komut> [argumanlar]\n", argc > 0 ? argv[0] : "program");
+  for (const HostCommand &c : hostCommands) printf("  %-10s %s\n", c.name, c.help);
+  return 2;
+}
+#endif
+
+#endif  // !ARDUINO
@@ -0,0 +1,43 @@
+#include "oled_display.h"
+#include "profiler.h"
+
+DiffSSD1306::DiffSSD1306(uint8_t w, uint8_t h, TwoWire* twi, int8_t rst, uint8_t address)
+  : Adafruit_SSD1306(w, h, twi, rst),
+    i2c(twi),
+    i2cAddress(address) {
+  frameDiffBegin(diff, w, h);
+}
+
+// Sayfa page'in [col0, col1] sutunlarini yaz (yatay adresleme: pencere icinde sarar)
+void DiffSSD1306::writeSpan(uint8_t page, uint8_t col0, uint8_t col1, const uint8_t* data) {
+  i2c->beginTransmission(i2cAddress);
+  i2c->write((uint8_t)0x00);  // komut akisi
+  i2c->write((uint8_t)SSD1306_PAGEADDR);
+  i2c->write(page);
+  i2c->write(page);
+  i2c->write((uint8_t)SSD1306_COLUMNADDR);
+  i2c->write(col0);
+  i2c->write(col1);
+  i2c->endTransmission();
+
+  int count = col1 - col0 + 1;
+  while (count > 0) {
+    int n = count < OLED_I2C_CHUNK - 1 ? count : OLED_I2C_CHUNK - 1;
+    i2c->beginTransmission(i2cAddress);
+    i2c->write((uint8_t)0x40);  // veri akisi
+    i2c->write(data, n);
+    i2c->endTransmission();
+    data += n;
+    count -= n;
+  }
+}
+
+void DiffSSD1306::display() {
+  PROFILE_ZONE(PROFILE_DISPLAY);
+  uint8_t* buffer = getBuffer();
+  if (!buffer) return;  // begin() basarisiz (tampon yok)
+
+  i2c->setClock(OLED_I2C_CLOCK);
+  frameDiffFlush(diff, buffer, *this);
+  i2c->setClock(OLED_I2C_CLOCK_IDLE);
+}
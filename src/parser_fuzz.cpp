@@ -0,0 +1,455 @@
+#ifndef ARDUINO
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <vector>
+
+#include "hal_host.h"
+#include "parser_fuzz.h"
+#include "stm32_decode.h"
+#include "stm32_link.h"
+#include "telemetry.h"
+
+#define PARSER_FUZZ_MAX_INPUT  512  // dahili surucude girdi boyu siniri
+#define PARSER_FUZZ_LINK_CHUNK 64   // hat hedefinde bir seferde beslenen bayt (UART FIFO gibi)
+#define REF_MAX_DIGITS         9    // int32'ye tasmadan tutulan hane (SERI_HABERLESME.md)
+
+// --- Referans ayristirici ---
+// stm32_fields.h'den bagimsiz, dogrudan dokumandaki gramerden yazildi:
+// "$" + virgulle ayrilmis alanlar, alan = [-]rakamlar[.rakamlar]; isaretsiz alanda eksi,
+// ondaliksiz alanda nokta yok; tutulan hane (tam kisim + ondalik hane sayisi) en fazla 9;
+// semadan fazla alan icerigine bakilmadan atlanir.
+struct RefField {
+  bool isSigned;
+  int  decimals;
+};
+
+static const RefField refDataFields[STM32_DATA_FIELDS] = {
+  { true, 0 }, { true, 0 }, { true, 0 }, { true, 0 },      // MCU load, PCB, plate, resin (x10)
+  { false, 0 }, { false, 0 }, { false, 0 },                // fan RPM (x10)
+  { false, 0 },                                            // gesture
+  { false, 0 }, { false, 0 }, { false, 0 }, { false, 0 },  // TMC stop bitleri
+  { false, 0 }, { false, 0 }, { false, 0 },
+  { false, 0 }                                             // motor mesgul
+};
+static const RefField refStatusFields[8] = {
+  { false, 0 }, { false, 0 }, { false, 0 }, { false, 0 },
+  { false, 0 }, { false, 0 }, { false, 0 }, { false, 0 }
+};
+static const RefField refLoadcellField[1] = { { true, 3 } };
+
+static bool isDigit(char c) {
+  return c >= '0' && c <= '9';
+}
+
+static bool refParseField(const char* tok, size_t len, const RefField &f, int32_t &raw) {
+  size_t i = 0;
+  bool negative = false;
+  if (i < len && tok[i] == '-') {
+    if (!f.isSigned) return false;
+    negative = true;
+    i++;
+  }
+  size_t intStart = i;
+  while (i < len && isDigit(tok[i])) i++;
+  size_t intDigits = i - intStart;
+  if (intDigits == 0) return false;
+
+  size_t fracStart = i;
+  size_t fracDigits = 0;
+  if (i < len && tok[i] == '.') {
+    if (f.decimals == 0) return false;
+    fracStart = ++i;
+    while (i < len && isDigit(tok[i])) i++;
+    fracDigits = i - fracStart;
+    if (fracDigits == 0) return false;
+  }
+  if (i != len) return false;
+  if (intDigits + f.decimals > REF_MAX_DIGITS) return false;
+
+  int64_t value = 0;
+  for (size_t k = 0; k < intDigits; k++) value = value * 10 + (tok[intStart + k] - '0');
+  for (int k = 0; k < f.decimals; k++) {
+    value = value * 10 + ((size_t)k < fracDigits ? tok[fracStart + k] - '0' : 0);
+  }
+  raw = (int32_t)(negative ? -value : value);
+  return true;
+}
+
+// Alan sayisi veya -1
+static int refParse(const char* line, const RefField* fields, int n, int32_t* raw) {
+  if (line[0] != '$') return -1;
+  const char* tok = line + 1;
+  int count = 0;
+  while (true) {
+    const char* end = strchr(tok, ',');
+    size_t len = end != nullptr ? (size_t)(end - tok) : strlen(tok);
+    if (count < n) {
+      if (!refParseField(tok, len, fields[count], raw[count])) return -1;
+      count++;
+    }
+    if (end == nullptr) break;
+    tok = end + 1;
+  }
+  return count;
+}
+
+// --- Ihlal raporu ---
+static const uint8_t* currentInput = nullptr;
+static size_t         currentLen = 0;
+
+static void fuzzCheck(bool ok, const char* what) {
+  if (ok) return;
+  fprintf(stderr, "parser_fuzz: IHLAL: %s\n  girdi (%u bayt):", what, (unsigned)currentLen);
+  for (size_t i = 0; i < currentLen; i++) fprintf(stderr, " %02x", currentInput[i]);
+  fprintf(stderr, "\n");
+  abort();
+}
+
+// --- $A: telemetri karesi ---
+static void frameFloats(const TelemetrySnapshot &t, float (&f)[7]) {
+  f[0] = t.mcuLoad;    f[1] = t.pcbTemp;    f[2] = t.plateTemp; f[3] = t.resinTemp;
+  f[4] = t.intake1Rpm; f[5] = t.intake2Rpm; f[6] = t.exhaustRpm;
+}
+
+static void frameInts(const TelemetrySnapshot &t, int (&v)[9]) {
+  v[0] = t.gesture;   v[1] = t.zStopR;    v[2] = t.yStopR;    v[3] = t.yStopL;
+  v[4] = t.cvr1StopR; v[5] = t.cvr1StopL; v[6] = t.cvr2StopR; v[7] = t.cvr2StopL;
+  v[8] = t.motorBusy;
+}
+
+static TelemetrySnapshot currentFrame() {
+  TelemetrySnapshot t;
+  if (!telemetryRead(t)) memset(&t, 0, sizeof(t));
+  return t;
+}
+
+// ok: cozucunun sonucu, count/raw: referans sonucu (count < 4 ise ret beklenir)
+static void checkDataResult(bool ok, const TelemetrySnapshot &before, int count, const int32_t* raw) {
+  fuzzCheck(ok == (count >= 4), "$A kabul/ret referansla ayni degil");
+  TelemetrySnapshot after = currentFrame();
+  if (!ok) {
+    fuzzCheck(after.seq == before.seq, "$A: reddedilen satir kare yayinladi");
+    return;
+  }
+  fuzzCheck(after.seq == before.seq + 1, "$A: kabul edilen satir tek kare yayinlamadi");
+  fuzzCheck(after.fieldCount == count, "$A: alan sayisi");
+
+  float fb[7], fa[7];
+  int   ib[9], ia[9];
+  frameFloats(before, fb);
+  frameFloats(after, fa);
+  frameInts(before, ib);
+  frameInts(after, ia);
+  for (int i = 0; i < 7; i++) {
+    float expected = i < count ? raw[i] / 10.0f : fb[i];
+    fuzzCheck(memcmp(&fa[i], &expected, sizeof(float)) == 0, "$A: olcekli alan degeri");
+  }
+  for (int i = 0; i < 9; i++) {
+    int expected = 7 + i < count ? (int)raw[7 + i] : ib[i];
+    fuzzCheck(ia[i] == expected, "$A: tam sayi alan degeri");
+  }
+  bool gestureEvent = count >= 8 && raw[7] >= 1 && raw[7] <= 4;
+  fuzzCheck(after.gestureEvents == before.gestureEvents + (gestureEvent ? 1 : 0), "$A: gesture olayi");
+  fuzzCheck(after.lastGesture == (gestureEvent ? (int)raw[7] : before.lastGesture), "$A: son gesture");
+}
+
+static void checkDataLine(const char* line) {
+  TelemetrySnapshot before = currentFrame();
+  int32_t raw[STM32_DATA_FIELDS];
+  int count = refParse(line, refDataFields, STM32_DATA_FIELDS, raw);
+  bool ok = parseSTM32DataLine(line);
+  checkDataResult(ok, before, count, raw);
+}
+
+// frame: senkron + uzunluk + payload (CRC haric); en az 2 + frame[1] bayt okunabilir
+static void checkDataFrame(const uint8_t* frame) {
+  TelemetrySnapshot before = currentFrame();
+  int32_t raw[STM32_DATA_FIELDS];
+  int count = -1;
+  int len = frame[1];
+  if (len >= STM32_BIN_DATA_MIN_LEN) {
+    const uint8_t* p = frame + 2;
+    for (int i = 0; i < 7; i++) {
+      uint16_t u = (uint16_t)(p[i * 2] | (p[i * 2 + 1] << 8));
+      raw[i] = i < 4 ? (int32_t)(int16_t)u : (int32_t)u;
+    }
+    raw[7] = p[14];
+    for (int i = 0; i < 7; i++) raw[8 + i] = (p[15] >> i) & 1;
+    count = STM32_DATA_FIELDS - 1;
+    if (len >= STM32_BIN_DATA_LEN) {
+      raw[15] = p[16];
+      count = STM32_DATA_FIELDS;
+    }
+  }
+  bool ok = parseSTM32DataFrame((const char*)frame);
+  checkDataResult(ok, before, count, raw);
+}
+
+// --- $X ---
+#define FUZZ_SENTINEL 7777
+
+static void checkStatusLine(const char* line) {
+  int* globals[6] = { &exhaust_fan_error, &intake1_fan_error, &intake2_fan_error,
+                      &gesture_sensor_status, &projector_sensor_status, &force_sensor_status };
+  for (int i = 0; i < 6; i++) *globals[i] = FUZZ_SENTINEL;
+  int ntc = FUZZ_SENTINEL;
+  int ir  = FUZZ_SENTINEL;
+  int32_t raw[8];
+  int count = line != nullptr ? refParse(line, refStatusFields, 8, raw) : -1;
+  bool ok = parseSensorStatusLine(line, ntc, ir);
+  fuzzCheck(ok == (count >= 2), "$X kabul/ret referansla ayni degil");
+  fuzzCheck(ntc == (ok ? (int)raw[0] : 1) && ir == (ok ? (int)raw[1] : 1), "$X: NTC/IR durumu");
+  for (int i = 0; i < 6; i++) {
+    int expected = ok && 2 + i < count ? (int)raw[2 + i] : 0;
+    fuzzCheck(*globals[i] == expected, "$X: durum globali");
+  }
+}
+
+// --- $Wn ---
+static void checkLoadcellLine(const char* line) {
+  const float sentinel = 12345.5f;
+  float value = sentinel;
+  int32_t raw[1];
+  int count = line != nullptr ? refParse(line, refLoadcellField, 1, raw) : -1;
+  bool ok = parseLoadcellLine(line, value);
+  fuzzCheck(ok == (count == 1), "$W kabul/ret referansla ayni degil");
+  float expected = ok ? raw[0] / 1000.0f : sentinel;
+  fuzzCheck(memcmp(&value, &expected, sizeof(float)) == 0, "$W: deger");
+}
+
+// --- Hat: bayt akisi -> satir birlestirici -> istek esleme -> cozuculer ---
+static uint32_t linkDecoded = 0;
+
+static void onFuzzData(const char* line, void*) {
+  if (stm32LinkIsDataFrame(line)) {
+    checkDataFrame((const uint8_t*)line);
+  } else {
+    fuzzCheck(strlen(line) < STM32_LINE_MAX, "hat: STM32_LINE_MAX'i asan satir");
+    checkDataLine(line);
+  }
+  linkDecoded++;
+}
+
+static void onFuzzStatus(const char* line, void*) {
+  if (line != nullptr) fuzzCheck(strlen(line) < STM32_LINE_MAX, "hat: STM32_LINE_MAX'i asan satir");
+  checkStatusLine(line);
+  if (line != nullptr) linkDecoded++;
+}
+
+static void onFuzzLoadcell(const char* line, void*) {
+  if (line != nullptr) fuzzCheck(strlen(line) < STM32_LINE_MAX, "hat: STM32_LINE_MAX'i asan satir");
+  checkLoadcellLine(line);
+  if (line != nullptr) linkDecoded++;
+}
+
+static void runLink(const uint8_t* data, size_t len) {
+  static bool begun = false;
+  if (!begun) {
+    stm32LinkSetDataHandler(onFuzzData);
+    stm32LinkBegin();
+    begun = true;
+  }
+  // Onceki girdinin yarim satirini / cercevesini kapat (en uzun cerceve STM32_LINE_MAX'ten kisa)
+  uint8_t flush[STM32_LINE_MAX + 1];
+  memset(flush, '\n', sizeof(flush));
+  stm32LinkFeed(flush, sizeof(flush));
+  stm32LinkHostPoll();
+  stm32LinkService();
+
+  // $X ve $W1 yolda olsun ki satirlar istek eslemesinden de gecsin
+  if (!stm32LinkIsPending(STM32_REQ_STATUS)) {
+    stm32LinkRequest(STM32_REQ_STATUS, "$X", 150, onFuzzStatus);
+  }
+  if (!stm32LinkIsPending(STM32_REQ_LOADCELL)) {
+    stm32LinkRequest(STM32_REQ_LOADCELL, "$W1", 150, onFuzzLoadcell);
+  }
+  for (size_t off = 0; off < len; off += PARSER_FUZZ_LINK_CHUNK) {
+    size_t n = len - off < PARSER_FUZZ_LINK_CHUNK ? len - off : PARSER_FUZZ_LINK_CHUNK;
+    stm32LinkFeed(data + off, n);
+    stm32LinkHostPoll();
+    stm32LinkService();
+  }
+  hostStm32Link().toPeer.bytes.clear();  // giden komutlar okunmuyor
+}
+
+const char* parserFuzzTargetName(int target) {
+  static const char* const names[PARSER_FUZZ_TARGETS] = { "$A ASCII", "$A ikili", "$X", "$W", "hat" };
+  return target >= 0 && target < PARSER_FUZZ_TARGETS ? names[target] : "?";
+}
+
+void parserFuzzOne(const uint8_t* data, size_t len, ParserFuzzStats* stats) {
+  if (len == 0) return;
+  currentInput = data;
+  currentLen = len;
+  int target = data[0] % PARSER_FUZZ_TARGETS;
+  const uint8_t* payload = data + 1;
+  size_t payloadLen = len - 1;
+  bool accepted = false;
+
+  if (target == PARSER_FUZZ_DATA_FRAME) {
+    // Hattin verecegi gibi: senkron + uzunluk + o kadar payload (+ '\0'); tam boy ayrilir ki
+    // sanitizer uzunlugun otesine okumayi yakalasin
+    uint8_t frameLen = payloadLen > 0 ? payload[0] : 0;
+    std::vector<uint8_t> frame(2 + frameLen + 1, 0);
+    frame[0] = STM32_BIN_SYNC;
+    for (size_t i = 0; i < payloadLen && i + 1 < frame.size(); i++) frame[1 + i] = payload[i];
+    uint32_t seq = telemetrySequence();
+    checkDataFrame(frame.data());
+    accepted = telemetrySequence() != seq;
+  } else if (target == PARSER_FUZZ_LINK) {
+    uint32_t decoded = linkDecoded;
+    runLink(payload, payloadLen);
+    if (stats != nullptr) stats->accepted[target] += linkDecoded - decoded;
+  } else {
+    // '\0' ile biten tam boy kopya (ilk '\0'da satir biter)
+    std::vector<char> line(payload, payload + payloadLen);
+    line.push_back('\0');
+    if (target == PARSER_FUZZ_DATA_LINE) {
+      uint32_t seq = telemetrySequence();
+      checkDataLine(line.data());
+      accepted = telemetrySequence() != seq;
+    } else if (target == PARSER_FUZZ_STATUS) {
+      int ntc, ir;
+      checkStatusLine(line.data());
+      accepted = parseSensorStatusLine(line.data(), ntc, ir);
+    } else {
+      float value;
+      checkLoadcellLine(line.data());
+      accepted = parseLoadcellLine(line.data(), value);
+    }
+  }
+  if (stats != nullptr) {
+    stats->runs[target]++;
+    if (accepted) stats->accepted[target]++;
+  }
+}
+
+// --- Dahili surucu ---
+static uint32_t fuzzRng;
+
+static uint32_t fuzzRand(uint32_t n) {
+  fuzzRng ^= fuzzRng << 13;
+  fuzzRng ^= fuzzRng >> 17;
+  fuzzRng ^= fuzzRng << 5;
+  return n > 0 ? fuzzRng % n : 0;
+}
+
+static void addSeed(std::vector<std::vector<uint8_t> > &seeds, int target, const uint8_t* data, size_t len) {
+  std::vector<uint8_t> s(1 + len);
+  s[0] = (uint8_t)target;
+  memcpy(s.data() + 1, data, len);
+  seeds.push_back(s);
+}
+
+static void addSeed(std::vector<std::vector<uint8_t> > &seeds, int target, const char* text) {
+  addSeed(seeds, target, (const uint8_t*)text, strlen(text));
+}
+
+static void buildSeeds(std::vector<std::vector<uint8_t> > &seeds) {
+  static const char* const dataLines[] = {
+    "$123,286,-35,244,40000,39950,0,2,0,0,1,0,0,0,0,3",
+    "$12,28,25,24",
+    "$1,2,3,4,5,6,7,8,9,10,11,12,13,14,15",
+    "$1,2,3,4,5,6,7,8,9,10,11,12,13,14,15,16,17,x",
+    "$-999999999,0,0,0,999999999,0,0,4,1,1,1,1,1,1,1,15",
+  };
+  static const char* const statusLines[] = { "$0,1,0,0,1,0,0,1", "$0,0", "$1,1,1,1,1,1,1,1,1" };
+  static const char* const loadcellLines[] = { "$-152.28", "$1234.567", "$0.0005", "$-0", "$12" };
+  for (const char* s : dataLines) addSeed(seeds, PARSER_FUZZ_DATA_LINE, s);
+  for (const char* s : statusLines) addSeed(seeds, PARSER_FUZZ_STATUS, s);
+  for (const char* s : loadcellLines) addSeed(seeds, PARSER_FUZZ_LOADCELL, s);
+
+  int32_t values[STM32_DATA_FIELDS] = { 123, 286, -35, 244, 40000, 39950, 0, 2, 1, 0, 1, 0, 1, 0, 1, 5 };
+  uint8_t frame[STM32_BIN_FRAME_LEN];
+  size_t frameLen = stm32LinkEncodeDataFrame(values, frame);
+  addSeed(seeds, PARSER_FUZZ_DATA_FRAME, frame + 1, frameLen - 1);
+
+  std::vector<uint8_t> stream;
+  // $AB1 onayi hattan gecmeden senkron byte cerceve baslatmaz
+  const char* lines[] = { "$AB1\r\n", dataLines[0], "\r\n", statusLines[0], "\r\n",
+                          loadcellLines[0], "\r\n" };
+  for (const char* s : lines) stream.insert(stream.end(), s, s + strlen(s));
+  stream.insert(stream.end(), frame, frame + frameLen);
+  addSeed(seeds, PARSER_FUZZ_LINK, stream.data(), stream.size());
+}
+
+static void mutate(std::vector<uint8_t> &in, const std::vector<std::vector<uint8_t> > &seeds) {
+  static const char interesting[] = "$,-.0123456789\r\n\xA5 ";
+  static const char* const tokens[] = { ",", "-", ".", ",,", "-0", "999999999", "2147483647",
+                                        "0000000000", "1.", "\r\n", "\xA5", "$", "$AB1\r\n" };
+  int ops = 1 + (int)fuzzRand(4);
+  for (int op = 0; op < ops; op++) {
+    size_t pos = 1 + fuzzRand((uint32_t)in.size());  // hedef bayti (0) genelde korunur
+    switch (fuzzRand(9)) {
+      case 0:
+        if (pos < in.size()) in[pos] ^= (uint8_t)(1 << fuzzRand(8));
+        break;
+      case 1:
+        if (pos < in.size()) in[pos] = (uint8_t)fuzzRand(256);
+        break;
+      case 2:
+        if (pos < in.size()) in[pos] = (uint8_t)interesting[fuzzRand(sizeof(interesting) - 1)];
+        break;
+      case 3: {
+        const char* t = tokens[fuzzRand(sizeof(tokens) / sizeof(tokens[0]))];
+        in.insert(in.begin() + (pos < in.size() ? pos : in.size()), t, t + strlen(t));
+        break;
+      }
+      case 4:
+        if (pos < in.size()) {
+          size_t n = 1 + fuzzRand((uint32_t)(in.size() - pos));
+          in.erase(in.begin() + pos, in.begin() + pos + n);
+        }
+        break;
+      case 5:
+        if (pos < in.size()) {
+          // Parcayi cogalt: tasan satirlar ve cok alanli satirlar
+          size_t n = 1 + fuzzRand((uint32_t)(in.size() - pos));
+          std::vector<uint8_t> chunk(in.begin() + pos, in.begin() + pos + n);
+          int copies = 1 + (int)fuzzRand(8);
+          for (int c = 0; c < copies; c++) in.insert(in.begin() + pos, chunk.begin(), chunk.end());
+        }
+        break;
+      case 6:
+        if (pos < in.size()) in.resize(pos);
+        break;
+      case 7: {
+        const std::vector<uint8_t> &other = seeds[fuzzRand((uint32_t)seeds.size())];
+        size_t from = 1 + fuzzRand((uint32_t)other.size() - 1);
+        if (pos > in.size()) pos = in.size();
+        in.resize(pos);
+        in.insert(in.end(), other.begin() + from, other.end());
+        break;
+      }
+      default:
+        in[0] = (uint8_t)fuzzRand(PARSER_FUZZ_TARGETS);
+        break;
+    }
+  }
+  if (in.empty()) in.push_back(0);
+  if (in.size() > PARSER_FUZZ_MAX_INPUT) in.resize(PARSER_FUZZ_MAX_INPUT);
+}
+
+void parserFuzzRun(uint32_t iterations, uint32_t seed, ParserFuzzStats &stats) {
+  memset(&stats, 0, sizeof(stats));
+  fuzzRng = seed != 0 ? seed : 1;
+  std::vector<std::vector<uint8_t> > seeds;
+  buildSeeds(seeds);
+  for (const std::vector<uint8_t> &s : seeds) parserFuzzOne(s.data(), s.size(), &stats);
+  for (uint32_t i = 0; i < iterations; i++) {
+    std::vector<uint8_t> in = seeds[fuzzRand((uint32_t)seeds.size())];
+    mutate(in, seeds);
+    parserFuzzOne(in.data(), in.size(), &stats);
+  }
+}
+
+#ifdef HOST_LIBFUZZER
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t* data, size_t size) {
+  parserFuzzOne(data, size);
+  return 0;
+}
+#endif
+
+#endif  // !ARDUINO
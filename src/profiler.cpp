@@ -0,0 +1,134 @@
+#include "profiler.h"
+
+#include <string.h>
+
+#include <Arduino.h>
+
+#ifndef ARDUINO
+#include <chrono>
+#endif
+
+static const char* const zoneNames[PROFILE_ZONES] = {
+  "loop",
+  "updateMenu",
+  "pollSTM32Link",
+  "readSTM32Data",
+  "testJobTick",
+  "drawCurrentScreen",
+  "display.display",
+  "$A parse (comms)",
+};
+
+const char* profilerZoneName(int zone) {
+  if (zone < 0 || zone >= PROFILE_ZONES) return "?";
+  return zoneNames[zone];
+}
+
+#ifdef PROFILER
+
+static ProfileZoneStats zones[PROFILE_ZONES];
+static unsigned long windowStartUs = 0;
+
+#ifdef ARDUINO
+static uint32_t cyclesPerUs() { return ESP.getCpuFreqMHz(); }
+static unsigned long windowNowUs() { return micros(); }
+#else
+// Host: sayac gercek zamanli ns (millis()/micros() sanal saattir, CPU suresini olcmez)
+static uint64_t hostNanos() {
+  return (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+      std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+uint32_t profilerCycles() { return (uint32_t)hostNanos(); }
+static uint32_t cyclesPerUs() { return 1000; }
+static unsigned long windowNowUs() { return (unsigned long)(hostNanos() / 1000); }
+#endif
+
+// us -> kova: 0-3 kendi kovasi, sonra her oktav (2^m .. 2^(m+1)-1) 4 esit parca
+static int bucketForMicros(uint32_t us) {
+  if (us < 4) return (int)us;
+  int msb = 31 - __builtin_clz(us);
+  int bucket = 4 * (msb - 1) + (int)((us >> (msb - 2)) & 3);
+  return bucket < PROFILER_BUCKETS ? bucket : PROFILER_BUCKETS - 1;
+}
+
+// Kovanin ust siniri (us)
+static uint32_t bucketUpperMicros(int bucket) {
+  if (bucket < 4) return (uint32_t)bucket;
+  int msb = bucket / 4 + 1;
+  uint32_t sub = (uint32_t)(bucket % 4);
+  return ((4 + sub + 1) << (msb - 2)) - 1;
+}
+
+void profilerRecord(ProfileZone zone, uint32_t cycles) {
+  ProfileZoneStats &z = zones[zone];
+  if (z.count == 0 || cycles < z.minCycles) z.minCycles = cycles;
+  if (cycles > z.maxCycles) z.maxCycles = cycles;
+  z.count++;
+  z.totalCycles += cycles;
+  z.buckets[bucketForMicros(cycles / cyclesPerUs())]++;
+}
+
+bool profilerZoneStats(int zone, ProfileZoneStats &out) {
+  if (zone < 0 || zone >= PROFILE_ZONES) return false;
+  out = zones[zone];
+  return true;
+}
+
+void profilerReset() {
+  memset(zones, 0, sizeof(zones));
+  windowStartUs = windowNowUs();
+}
+
+// count * 0.99'uncu olcumun dustugu kovanin ust siniri (max'i gecmez)
+static uint32_t p99Micros(const ProfileZoneStats &z, uint32_t maxUs) {
+  uint32_t rank = z.count - z.count / 100;  // tavan(0.99 * count) yaklasik
+  uint32_t seen = 0;
+  for (int b = 0; b < PROFILER_BUCKETS; b++) {
+    seen += z.buckets[b];
+    if (seen >= rank) {
+      uint32_t upper = bucketUpperMicros(b);
+      return upper < maxUs ? upper : maxUs;
+    }
+  }
+  return maxUs;
+}
+
+void profilerDump(Print &out) {
+  uint32_t perUs = cyclesPerUs();
+  unsigned long windowUs = windowNowUs() - windowStartUs;
+  if (windowUs == 0) windowUs = 1;
+
+  out.printf("profiler: pencere %lu ms, %lu cevrim/us\r\n",
+             windowUs / 1000, (unsigned long)perUs);
+  out.printf("%-18s %8s %7s %8s %8s %8s %8s %6s\r\n",
+             "bolge", "sayi", "hz", "min_us", "ort_us", "p99_us", "max_us", "pay%");
+  for (int i = 0; i < PROFILE_ZONES; i++) {
+    ProfileZoneStats z = zones[i];
+    if (z.count == 0) {
+      out.printf("%-18s %8s\r\n", zoneNames[i], "-");
+      continue;
+    }
+    double totalUs = (double)z.totalCycles / perUs;
+    uint32_t maxUs = z.maxCycles / perUs;
+    out.printf("%-18s %8lu %7.1f %8lu %8.1f %8lu %8lu %6.2f\r\n",
+               zoneNames[i],
+               (unsigned long)z.count,
+               z.count * 1e6 / windowUs,
+               (unsigned long)(z.minCycles / perUs),
+               totalUs / z.count,
+               (unsigned long)p99Micros(z, maxUs),
+               (unsigned long)maxUs,
+               totalUs * 100.0 / windowUs);
+  }
+}
+
+#else  // !PROFILER
+
+bool profilerZoneStats(int, ProfileZoneStats &) { return false; }
+void profilerReset() {}
+
+void profilerDump(Print &out) {
+  out.println("profiler: derlenmedi (-D PROFILER, pio run -e featheresp32_prof)");
+}
+
+#endif  // PROFILER
@@ -0,0 +1,30 @@
+#include <math.h>
+
+#include "running_stats.h"
+
+void runningStatsReset(RunningStats &s) {
+  s.count = 0;
+  s.mean = 0.0f;
+  s.m2 = 0.0f;
+  s.min = 0.0f;
+  s.max = 0.0f;
+}
+
+void runningStatsAdd(RunningStats &s, float value) {
+  s.count++;
+  float delta = value - s.mean;
+  s.mean += delta / s.count;
+  s.m2 += delta * (value - s.mean);
+  if (s.count == 1 || value < s.min) s.min = value;
+  if (s.count == 1 || value > s.max) s.max = value;
+}
+
+float runningStatsStdDev(const RunningStats &s) {
+  if (s.count < 2) return 0.0f;
+  return sqrtf(s.m2 / (s.count - 1));
+}
+
+float runningStatsStdError(const RunningStats &s) {
+  if (s.count < 2) return 0.0f;
+  return runningStatsStdDev(s) / sqrtf((float)s.count);
+}
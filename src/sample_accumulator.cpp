@@ -0,0 +1,123 @@
+#include <math.h>
+
+#include "sample_accumulator.h"
+
+static SampleAccumulator* accumulators[SAMPLE_ACCUMULATOR_MAX];
+static int                accumulatorCount = 0;
+
+bool sampleAccumulatorAttach(SampleAccumulator &acc) {
+  for (int i = 0; i < accumulatorCount; i++) {
+    if (accumulators[i] == &acc) return true;
+  }
+  if (accumulatorCount >= SAMPLE_ACCUMULATOR_MAX) return false;
+  accumulators[accumulatorCount++] = &acc;
+  return true;
+}
+
+void sampleAccumulatorStart(SampleAccumulator &acc, bool sequential, unsigned long now) {
+  runningStatsReset(acc.stats);
+  acc.sum = 0.0f;
+  acc.last = 0.0f;
+  acc.sequential = sequential;
+  acc.failReason = SAMPLE_FAIL_NONE;
+  acc.startMs = now;
+  acc.endMs = now;
+  acc.verdict = SAMPLE_RUNNING;
+}
+
+void sampleAccumulatorStop(SampleAccumulator &acc) {
+  acc.verdict = SAMPLE_IDLE;
+}
+
+static void finish(SampleAccumulator &acc, SampleFailReason reason, unsigned long now) {
+  acc.verdict = (reason == SAMPLE_FAIL_NONE) ? SAMPLE_PASS : SAMPLE_FAIL;
+  acc.failReason = reason;
+  acc.endMs = now;
+  if (acc.onDone) acc.onDone(acc);
+}
+
+static bool meanInRange(const SampleAccumulator &acc) {
+  return acc.stats.mean >= acc.limits.valueMin && acc.stats.mean <= acc.limits.valueMax;
+}
+
+// Ardisik mod karari (olcum sayisina ulasilmadan): PASS icin en az SAMPLE_SEQ_MIN_SAMPLES olcum,
+// gozlenen fark limitin SAMPLE_SEQ_RANGE_MARGIN katinin altinda, sigmanin ust tahmini ile sabit
+// sayida olcumde beklenen fark limit icinde ve ortalamanin guven araligi deger araliginda.
+static bool sequentialPass(const SampleAccumulator &acc) {
+  const RunningStats &s = acc.stats;
+  const SampleLimits &l = acc.limits;
+  if (s.count < SAMPLE_SEQ_MIN_SAMPLES) return false;
+  if (l.rangeLimit > 0.0f) {
+    if (runningStatsRange(s) > l.rangeLimit * SAMPLE_SEQ_RANGE_MARGIN) return false;
+    // Sigma tahmininin standart hatasi ~ s / sqrt(2(n-1)); ust tahmin = s + 2 * bu hata
+    float sigmaHigh = runningStatsStdDev(s) * (1.0f + 2.0f / sqrtf(2.0f * (s.count - 1)));
+    if (SAMPLE_SEQ_SPREAD_SIGMAS * sigmaHigh > l.rangeLimit) return false;
+  }
+  float meanMargin = SAMPLE_SEQ_MEAN_SIGMAS * runningStatsStdError(s);
+  return s.mean - meanMargin >= l.valueMin && s.mean + meanMargin <= l.valueMax;
+}
+
+static void addSample(SampleAccumulator &acc, float v, unsigned long now) {
+  const SampleLimits &l = acc.limits;
+  // Aralik disi deger veya ardil fark: hemen FAIL (ornek istatistige girmez)
+  if (v < l.valueMin || v > l.valueMax) {
+    finish(acc, SAMPLE_FAIL_VALUE, now);
+    return;
+  }
+  if (l.stepLimit > 0.0f && acc.stats.count > 0 && fabsf(v - acc.last) > l.stepLimit) {
+    finish(acc, SAMPLE_FAIL_STEP, now);
+    return;
+  }
+
+  runningStatsAdd(acc.stats, v);
+  acc.sum += v;
+  acc.last = v;
+
+  if (acc.stats.count >= l.count) {
+    if (l.rangeLimit > 0.0f && runningStatsRange(acc.stats) > l.rangeLimit) {
+      finish(acc, SAMPLE_FAIL_RANGE, now);
+    } else {
+      finish(acc, meanInRange(acc) ? SAMPLE_FAIL_NONE : SAMPLE_FAIL_MEAN, now);
+    }
+    return;
+  }
+  if (!acc.sequential) return;
+  // Fark yalnizca buyuyebilir: limiti asinca sonraki olcumler sonucu degistirmez
+  if (l.rangeLimit > 0.0f && runningStatsRange(acc.stats) > l.rangeLimit) {
+    finish(acc, SAMPLE_FAIL_RANGE, now);
+  } else if (sequentialPass(acc)) {
+    finish(acc, SAMPLE_FAIL_NONE, now);
+  }
+}
+
+void sampleAccumulatorTimeout(SampleAccumulator &acc, unsigned long now) {
+  if (acc.verdict != SAMPLE_RUNNING) return;
+  if (acc.stats.count == 0) {
+    finish(acc, SAMPLE_FAIL_TIMEOUT, now);
+  } else {
+    finish(acc, meanInRange(acc) ? SAMPLE_FAIL_NONE : SAMPLE_FAIL_MEAN, now);
+  }
+}
+
+void sampleAccumulatorsFeed(const TelemetrySnapshot &t) {
+  for (int i = 0; i < accumulatorCount; i++) {
+    SampleAccumulator &acc = *accumulators[i];
+    if (acc.verdict != SAMPLE_RUNNING) continue;
+    // Baslatmadan once alinmis (henuz uygulanmamis) kare sayilmaz
+    if ((long)(t.timestampMs - acc.startMs) < 0) continue;
+    float v;
+    if (!telemetryChannelValue(t, acc.channel, v)) continue;
+    addSample(acc, v, t.timestampMs);
+  }
+}
+
+const char* sampleFailReasonLabel(SampleFailReason reason) {
+  switch (reason) {
+    case SAMPLE_FAIL_VALUE:   return "DEGER";
+    case SAMPLE_FAIL_STEP:    return "ADIM";
+    case SAMPLE_FAIL_RANGE:   return "FARK";
+    case SAMPLE_FAIL_MEAN:    return "ORTALAMA";
+    case SAMPLE_FAIL_TIMEOUT: return "ZAMAN ASIMI";
+    default:                  return "";
+  }
+}
@@ -0,0 +1,115 @@
+#include "scheduler.h"
+
+struct SchedulerJob {
+  SchedulerJobFunc fn;
+  unsigned long    periodMs;
+  unsigned long    deadline;   // bir sonraki calisma zamani (millis)
+  unsigned long    lastRunMs;  // son calisma zamani (periyot degisiminde referans)
+};
+
+static SchedulerJob jobs[SCHEDULER_MAX_JOBS];
+static int          jobCount = 0;
+// Min-heap: heap[0] deadline'i en yakin is. heapPos[job] = isin heap icindeki yeri.
+static int          heap[SCHEDULER_MAX_JOBS];
+static int          heapPos[SCHEDULER_MAX_JOBS];
+
+// millis() tasmasina dayanikli karsilastirma
+static bool earlier(int a, int b) {
+  return (long)(jobs[a].deadline - jobs[b].deadline) < 0;
+}
+
+static void heapSwap(int i, int j) {
+  int t = heap[i];
+  heap[i] = heap[j];
+  heap[j] = t;
+  heapPos[heap[i]] = i;
+  heapPos[heap[j]] = j;
+}
+
+// Deadline'i degisen isi heap'te yerine tasi (yukari veya asagi)
+static void heapFix(int i) {
+  while (i > 0 && earlier(heap[i], heap[(i - 1) / 2])) {
+    heapSwap(i, (i - 1) / 2);
+    i = (i - 1) / 2;
+  }
+  while (true) {
+    int l = 2 * i + 1;
+    int r = l + 1;
+    int m = i;
+    if (l < jobCount && earlier(heap[l], heap[m])) m = l;
+    if (r < jobCount && earlier(heap[r], heap[m])) m = r;
+    if (m == i) break;
+    heapSwap(i, m);
+    i = m;
+  }
+}
+
+static void setDeadline(int job, unsigned long deadline) {
+  jobs[job].deadline = deadline;
+  heapFix(heapPos[job]);
+}
+
+void schedulerBegin() {
+  halClock().begin();
+}
+
+int schedulerAdd(SchedulerJobFunc fn, unsigned long periodMs, unsigned long firstDelayMs) {
+  if (jobCount >= SCHEDULER_MAX_JOBS) return -1;
+  int job = jobCount++;
+  unsigned long now = halClock().millis();
+  jobs[job].fn        = fn;
+  jobs[job].periodMs  = periodMs;
+  jobs[job].deadline  = now + firstDelayMs;
+  jobs[job].lastRunMs = now;
+  heap[job] = job;
+  heapPos[job] = job;
+  heapFix(job);
+  return job;
+}
+
+void schedulerSetPeriod(int job, unsigned long periodMs) {
+  if (job < 0 || jobs[job].periodMs == periodMs) return;
+  jobs[job].periodMs = periodMs;
+  setDeadline(job, jobs[job].lastRunMs + periodMs);
+}
+
+void schedulerRunAfter(int job, unsigned long delayMs) {
+  if (job < 0) return;
+  setDeadline(job, halClock().millis() + delayMs);
+}
+
+void schedulerRunDue() {
+  unsigned long now = halClock().millis();
+  // Her is bu cagrida en fazla bir kez calisir (periyot 0 olsa bile dongu kilitlenmez)
+  for (int n = 0; n < jobCount && jobCount > 0; n++) {
+    int job = heap[0];
+    SchedulerJob &j = jobs[job];
+    if ((long)(now - j.deadline) < 0) break;
+    // Sonraki deadline is calismadan once ayarlanir: is kendini schedulerRunAfter ile
+    // yeniden zamanlayabilir. Bir periyottan fazla geride kalindiysa kacan turlar atlanir.
+    unsigned long next = j.deadline + j.periodMs;
+    if ((long)(now - next) >= 0) next = now + j.periodMs;
+    j.lastRunMs = now;
+    setDeadline(job, next);
+    j.fn(now);
+    now = halClock().millis();
+  }
+}
+
+void schedulerSleep() {
+  unsigned long waitMs = SCHEDULER_MAX_SLEEP_MS;
+  if (jobCount > 0) {
+    long untilNext = (long)(jobs[heap[0]].deadline - halClock().millis());
+    if (untilNext <= 0) return;
+    if ((unsigned long)untilNext < waitMs) waitMs = (unsigned long)untilNext;
+  }
+  halClock().sleep(waitMs);
+}
+
+void schedulerWake() {
+  halClock().wake();
+}
+
+void IRAM_ATTR schedulerWakeFromISR() {
+  halWakeFromISR();
+}
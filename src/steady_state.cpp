@@ -0,0 +1,78 @@
+#include <math.h>
+
+#include "steady_state.h"
+
+// i. en eski olcumun tampondaki yeri (0 = en eski)
+static int slot(const SteadyWindow &w, int i) {
+  return (w.head + w.size - w.count + i) % w.size;
+}
+
+void steadyWindowReset(SteadyWindow &w, int size) {
+  if (size < 2) size = 2;
+  if (size > STEADY_WINDOW_MAX) size = STEADY_WINDOW_MAX;
+  w.size = (uint8_t)size;
+  w.count = 0;
+  w.head = 0;
+}
+
+void steadyWindowAdd(SteadyWindow &w, unsigned long ms, float value) {
+  w.value[w.head] = value;
+  w.ms[w.head] = ms;
+  w.head = (uint8_t)((w.head + 1) % w.size);
+  if (w.count < w.size) w.count++;
+}
+
+float steadyWindowMean(const SteadyWindow &w) {
+  if (w.count == 0) return 0.0f;
+  float sum = 0.0f;
+  for (int i = 0; i < w.count; i++) sum += w.value[slot(w, i)];
+  return sum / w.count;
+}
+
+float steadyWindowMin(const SteadyWindow &w) {
+  if (w.count == 0) return 0.0f;
+  float m = w.value[slot(w, 0)];
+  for (int i = 1; i < w.count; i++) {
+    float v = w.value[slot(w, i)];
+    if (v < m) m = v;
+  }
+  return m;
+}
+
+float steadyWindowStdDev(const SteadyWindow &w) {
+  if (w.count < 2) return 0.0f;
+  float mean = steadyWindowMean(w);
+  float sq = 0.0f;
+  for (int i = 0; i < w.count; i++) {
+    float d = w.value[slot(w, i)] - mean;
+    sq += d * d;
+  }
+  return sqrtf(sq / (w.count - 1));
+}
+
+float steadyWindowSlope(const SteadyWindow &w) {
+  if (w.count < 2) return 0.0f;
+  // Zaman en eski olcume gore saniye cinsinden (millis tasmasi farkta sorun olmaz)
+  unsigned long t0 = w.ms[slot(w, 0)];
+  float tMean = 0.0f, vMean = 0.0f;
+  for (int i = 0; i < w.count; i++) {
+    int s = slot(w, i);
+    tMean += (w.ms[s] - t0) / 1000.0f;
+    vMean += w.value[s];
+  }
+  tMean /= w.count;
+  vMean /= w.count;
+  float num = 0.0f, den = 0.0f;
+  for (int i = 0; i < w.count; i++) {
+    int s = slot(w, i);
+    float dt = (w.ms[s] - t0) / 1000.0f - tMean;
+    num += dt * (w.value[s] - vMean);
+    den += dt * dt;
+  }
+  return den > 0.0f ? num / den : 0.0f;
+}
+
+bool steadyWindowSettled(const SteadyWindow &w, float maxSlope, float maxStdDev) {
+  if (!steadyWindowFull(w)) return false;
+  return fabsf(steadyWindowSlope(w)) <= maxSlope && steadyWindowStdDev(w) <= maxStdDev;
+}
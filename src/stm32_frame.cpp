@@ -0,0 +1,52 @@
+#include "stm32_link.h"
+
+// Ikili $A cercevesi ve CRC: donanimdan bagimsiz (hedefte stm32_link, host'ta STM32 modeli
+// ve native testler kullanir)
+
+uint16_t stm32LinkCrc16(const uint8_t* data, size_t len) {
+  uint16_t crc = 0xFFFF;
+  for (size_t i = 0; i < len; i++) {
+    crc ^= (uint16_t)data[i] << 8;
+    for (int b = 0; b < 8; b++) {
+      crc = (crc & 0x8000) ? (uint16_t)((crc << 1) ^ 0x1021) : (uint16_t)(crc << 1);
+    }
+  }
+  return crc;
+}
+
+static int16_t readLe16(const uint8_t* p) {
+  return (int16_t)((uint16_t)p[0] | ((uint16_t)p[1] << 8));
+}
+
+static void writeLe16(uint8_t* p, int32_t v) {
+  p[0] = (uint8_t)(v & 0xFF);
+  p[1] = (uint8_t)((v >> 8) & 0xFF);
+}
+
+int stm32LinkDecodeDataFrame(const char* frame, int32_t* values, int maxValues) {
+  const uint8_t* f = (const uint8_t*)frame;
+  if (f[1] < STM32_BIN_DATA_MIN_LEN || maxValues < STM32_DATA_FIELDS) return 0;
+  const uint8_t* p = f + 2;
+  for (int i = 0; i < 4; i++) values[i] = readLe16(p + i * 2);             // isaretli x10
+  for (int i = 4; i < 7; i++) values[i] = (uint16_t)readLe16(p + i * 2);   // RPM x10
+  values[7] = p[14];                                                       // gesture
+  for (int i = 0; i < 7; i++) values[8 + i] = (p[15] >> i) & 1;            // TMC bitleri
+  if (f[1] < STM32_BIN_DATA_LEN) return STM32_DATA_FIELDS - 1;              // eski cerceve
+  values[15] = p[16];                                                      // motor mesgul
+  return STM32_DATA_FIELDS;
+}
+
+size_t stm32LinkEncodeDataFrame(const int32_t* values, uint8_t* frame) {
+  frame[0] = STM32_BIN_SYNC;
+  frame[1] = STM32_BIN_DATA_LEN;
+  uint8_t* p = frame + 2;
+  for (int i = 0; i < 7; i++) writeLe16(p + i * 2, values[i]);
+  p[14] = (uint8_t)values[7];
+  p[15] = 0;
+  for (int i = 0; i < 7; i++) p[15] |= (uint8_t)((values[8 + i] & 1) << i);
+  p[16] = (uint8_t)values[15];
+  uint16_t crc = stm32LinkCrc16(frame + 1, 1 + STM32_BIN_DATA_LEN);
+  frame[2 + STM32_BIN_DATA_LEN]     = (uint8_t)(crc & 0xFF);
+  frame[2 + STM32_BIN_DATA_LEN + 1] = (uint8_t)(crc >> 8);
+  return STM32_BIN_FRAME_LEN;
+}
@@ -0,0 +1,679 @@
+#include <Arduino.h>
+#include <atomic>
+#include "freertos/FreeRTOS.h"
+#include "freertos/queue.h"
+#include "freertos/task.h"
+
+#include "hal.h"
+#include "stm32_link.h"
+#ifdef STM32_SIM
+#include "stm32_sim.h"
+#endif
+
+// Satir birlestirici durumu (yalnizca UART olay gorevi yazar)
+static char     rxLine[STM32_LINE_MAX];
+static int      rxLen = 0;
+static bool     rxOverflow = false;
+// Ikili cerceve toplama: rxBinPos > 0 iken gelen byte'lar rxBin'e yazilir
+static uint8_t  rxBin[STM32_LINE_MAX];
+static int      rxBinPos = 0;
+// Senkron byte'i yalnizca STM32 $AB1'i onayladiktan sonra cerceve baslatir. Onay satiri da
+// bu birlestiriciden gectigi icin bayrak ayni sirada, ardindan gelen ilk cercevede hazirdir.
+// Oncesinde satir basindaki gurultu 0xA5'i sonraki ASCII cevabi yutmaz.
+static bool     rxBinEnabled = false;
+
+// Tek uretici (UART olay gorevi) / tek tuketici (haberlesme gorevi) halka tampon.
+// head sadece uretici, tail sadece tuketici tarafindan ilerletilir; kilit gerekmez.
+// Her slot ya '\0' ile biten ASCII satiri ya da ikili cerceveyi (senkron + uzunluk + payload) tutar.
+static char                  lineSlots[STM32_LINE_SLOTS][STM32_LINE_MAX];
+static uint8_t               lineLens[STM32_LINE_SLOTS];
+static std::atomic<uint32_t> lineHead(0);
+static std::atomic<uint32_t> lineTail(0);
+static std::atomic<uint32_t> droppedLines(0);
+static std::atomic<uint32_t> crcErrors(0);
+
+// Islem havuzu (yalnizca haberlesme gorevi kullanir).
+// Ayni havuz hem gonderilmeyi bekleyen komutlari hem de cevabi beklenen istekleri tutar;
+// komutlar kesinlikle eklenme sirasinda gonderilir.
+enum Stm32SlotState {
+  SLOT_FREE = 0,
+  SLOT_QUEUED,   // gonderim sirasi bekliyor (yoldaki istek penceresi dolu)
+  SLOT_PENDING   // gonderildi, cevap bekleniyor
+};
+
+#define STM32_REQ_SEND_ONLY STM32_REQ_COUNT  // cevapsiz komut ($F, $LA, $S..., $WT ...)
+
+struct Stm32Transaction {
+  Stm32SlotState    state;
+  uint8_t           type;       // Stm32Request veya STM32_REQ_SEND_ONLY
+  uint32_t          order;      // eklenme sirasi (kucuk = daha eski)
+  unsigned long     sentMs;
+  unsigned long     timeoutMs;
+  Stm32ReplyHandler onReply;
+  void*             ctx;
+  char              cmd[STM32_CMD_MAX];
+};
+
+static Stm32Transaction      transactions[STM32_QUEUE_SLOTS];
+static uint32_t              txOrder = 0;
+static std::atomic<int>      inFlight(0);
+static std::atomic<uint32_t> unmatchedLines(0);
+// Benchmark / debug sayaclari
+static std::atomic<uint32_t> roundTrips(0);    // cevabi gelen istek
+static std::atomic<uint32_t> timeouts(0);      // zaman asimi veya kayip cevap
+static std::atomic<uint32_t> replyWaitMs(0);   // cevabi gelen isteklerde gonderimden cevaba toplam
+static uint32_t              blockedMs = 0;    // loop()'un bloklayan beklemelerde gecirdigi (yalnizca loop yazar)
+
+// loop() -> haberlesme gorevi komut kaydi
+enum Stm32CommandKind {
+  CMD_SEND = 0,  // cevapsiz komut
+  CMD_REQUEST,   // cevap bekleyen istek
+  CMD_BAUD       // onceki komutlar yazildiktan sonra Serial1 hizini degistir
+};
+
+struct Stm32Command {
+  uint8_t           kind;
+  uint8_t           type;
+  unsigned long     timeoutMs;
+  unsigned long     baud;
+  Stm32ReplyHandler onReply;
+  void*             ctx;
+  char              cmd[STM32_CMD_MAX];
+};
+
+// Haberlesme gorevi -> loop() cevap kaydi (cevap veya zaman asimi, istek basina tam bir tane)
+struct Stm32Reply {
+  uint8_t           type;
+  bool              ok;
+  Stm32ReplyHandler onReply;
+  void*             ctx;
+  char              line[STM32_LINE_MAX];
+};
+
+static QueueHandle_t commandQueue = nullptr;
+static QueueHandle_t replyQueue = nullptr;
+static TaskHandle_t  commsTaskHandle = nullptr;
+static TaskHandle_t  serviceTaskHandle = nullptr;  // stm32LinkBegin()'i cagiran gorev (loop)
+
+// loop() tarafi: cevabi henuz alinmamis istek sayisi (tur basina)
+static int  pendingByType[STM32_REQ_COUNT];
+static bool binaryFrames = false;
+
+// $A veri handler'i (haberlesme gorevinde cagrilir)
+static Stm32ReplyHandler dataHandler = nullptr;
+static void*             dataCtx = nullptr;
+
+// Telemetri akisi: periyot/abonelik loop() tarafinda, son kare zamani haberlesme gorevinde yazilir
+static unsigned long         streamPeriodMs = 0;     // istenen periyot (0 = kapali)
+static unsigned long         streamSubscribeMs = 0;  // son $AS gonderim zamani
+static std::atomic<uint32_t> streamLastFrameMs(0);   // son akis satirinin geldigi zaman
+static std::atomic<bool>     streamFrameSeen(false);
+
+static void pushLine(const char* line, int len) {
+  uint32_t head = lineHead.load(std::memory_order_relaxed);
+  uint32_t tail = lineTail.load(std::memory_order_acquire);
+  if (head - tail >= STM32_LINE_SLOTS) {
+    // Tuketici yetisemiyor: en yeni satiri at (eski cevaplar sirayla islensin)
+    droppedLines.fetch_add(1, std::memory_order_relaxed);
+    return;
+  }
+  char* slot = lineSlots[head & (STM32_LINE_SLOTS - 1)];
+  memcpy(slot, line, len);
+  slot[len] = '\0';
+  lineLens[head & (STM32_LINE_SLOTS - 1)] = (uint8_t)len;
+  lineHead.store(head + 1, std::memory_order_release);
+}
+
+// Ikili cerceveye ait bir byte'i isle (rxBinPos > 0 iken)
+// Gecerli uzunluk byte'i degilse false doner; cagiran byte'i ASCII olarak yeniden isler
+static bool feedBinary(uint8_t b) {
+  if (rxBinPos == 1) {
+    // Uzunluk byte'i: yalnizca $A cercevesi var. Baska deger senkronun gurultu oldugunu
+    // gosterir ('$' = 36 gibi); byte ASCII satirin basi olarak kalir.
+    if (b < STM32_BIN_DATA_MIN_LEN || b > STM32_BIN_DATA_LEN) {
+      crcErrors.fetch_add(1, std::memory_order_relaxed);
+      rxBinPos = 0;
+      return false;
+    }
+    rxBin[rxBinPos++] = b;
+    return true;
+  }
+  rxBin[rxBinPos++] = b;
+  int frameLen = 2 + rxBin[1];
+  if (rxBinPos < frameLen + 2) return true;
+
+  uint16_t crc = (uint16_t)rxBin[frameLen] | ((uint16_t)rxBin[frameLen + 1] << 8);
+  if (stm32LinkCrc16(rxBin + 1, frameLen - 1) == crc) {
+    pushLine((const char*)rxBin, frameLen);  // CRC haric sakla
+  } else {
+    crcErrors.fetch_add(1, std::memory_order_relaxed);
+  }
+  rxBinPos = 0;
+  return true;
+}
+
+// Tamamlanan ASCII satiri kuyruga koy; $AB onayi ikili alimi acar / kapar
+static void endLine() {
+  if (rxLen == 4 && memcmp(rxLine, "$AB", 3) == 0 && (rxLine[3] == '0' || rxLine[3] == '1')) {
+    rxBinEnabled = (rxLine[3] == '1');
+  }
+  pushLine(rxLine, rxLen);
+}
+
+void stm32LinkFeed(const uint8_t* data, size_t len) {
+  for (size_t i = 0; i < len; i++) {
+    if (rxBinPos > 0 && feedBinary(data[i])) continue;
+    if (data[i] == STM32_BIN_SYNC && rxBinEnabled && rxLen == 0 && !rxOverflow) {
+      // Satir basinda senkron byte: ikili cerceve basliyor
+      rxBin[0] = data[i];
+      rxBinPos = 1;
+      continue;
+    }
+    char c = (char)data[i];
+    if (c == '\r' || c == '\n') {
+      // Bos satirlari (CRLF'nin ikinci yarisi) ve tasan satirlari atla
+      if (rxOverflow) {
+        droppedLines.fetch_add(1, std::memory_order_relaxed);
+      } else if (rxLen > 0) {
+        endLine();
+      }
+      rxLen = 0;
+      rxOverflow = false;
+      continue;
+    }
+    if (c < 32 || c >= 127) continue; // yazdirilamayan karakterleri yok say
+    if (rxLen >= STM32_LINE_MAX - 1) {
+      rxOverflow = true;
+      continue;
+    }
+    rxLine[rxLen++] = c;
+  }
+}
+
+// HardwareSerial olay gorevinden cagrilir: FIFO'daki her seyi tek seferde birlestiriciye aktar
+// ve haberlesme gorevini uyandir
+static void onSTM32Receive() {
+  HalByteStream &stream = halStm32Stream();
+  uint8_t chunk[64];
+  int avail;
+  while ((avail = stream.available()) > 0) {
+    size_t n = stream.read(chunk, avail < (int)sizeof(chunk) ? (size_t)avail : sizeof(chunk));
+    if (n == 0) break;
+    stm32LinkFeed(chunk, n);
+  }
+  if (commsTaskHandle != nullptr) xTaskNotifyGive(commsTaskHandle);
+}
+
+static bool popLine(char* out, size_t outLen, size_t &outLenRead) {
+  uint32_t tail = lineTail.load(std::memory_order_relaxed);
+  uint32_t head = lineHead.load(std::memory_order_acquire);
+  if (tail == head) return false;
+  const char* slot = lineSlots[tail & (STM32_LINE_SLOTS - 1)];
+  size_t len = lineLens[tail & (STM32_LINE_SLOTS - 1)];
+  if (len > outLen - 1) len = outLen - 1;
+  memcpy(out, slot, len);  // ikili cerceve '\0' icerebilir: uzunlukla kopyala
+  out[len] = '\0';
+  outLenRead = len;
+  lineTail.store(tail + 1, std::memory_order_release);
+  return true;
+}
+
+// Satirin sekline gore hangi istek turlerinin cevabi olabilecegini bit maskesi olarak dondur.
+// exactMask: guncel STM32 yazilimindaki tam sekil ($A = 15/16, $X = 8 alan); eski yazilim icin
+// daha kisa $A cevaplari da kabul edilir, ama bekleyen bir $X varsa 4..8 alanli satir ona gider.
+static uint8_t replyShapeMask(const char* line, uint8_t &exactMask) {
+  exactMask = 0;
+  if (stm32LinkIsDataFrame(line)) {
+    exactMask = 1 << STM32_REQ_DATA;  // ikili cerceve yalnizca $A/$AS verisi tasir
+    return exactMask;
+  }
+  if (line[0] != '$' || line[1] == '\0') return 0;
+  int  fields = 1;
+  bool hasDot = false;
+  for (const char* p = line + 1; *p; p++) {
+    char c = *p;
+    if (c == ',') {
+      fields++;
+    } else if (c == '.') {
+      hasDot = true;
+    } else if (c != '-' && (c < '0' || c > '9')) {
+      // Sayisal olmayan satir: yalnizca ayni metinli ayar komutunun onayi olabilir
+      exactMask = 1 << STM32_REQ_ACK;
+      return exactMask;
+    }
+  }
+  uint8_t mask = 0;
+  if (fields >= 4) mask |= 1 << STM32_REQ_DATA;
+  if (fields >= 2 && fields <= 8 && !hasDot) mask |= 1 << STM32_REQ_STATUS;
+  if (fields == 1) mask |= 1 << STM32_REQ_LOADCELL;
+  exactMask = mask;
+  if (fields < 9) exactMask &= ~(1 << STM32_REQ_DATA);
+  return mask;
+}
+
+// Maskeye uyan yoldaki istekler arasindan en once gonderileni bul
+static Stm32Transaction* findPending(uint8_t mask, const char* line) {
+  Stm32Transaction* match = nullptr;
+  for (int i = 0; i < STM32_QUEUE_SLOTS; i++) {
+    Stm32Transaction &tx = transactions[i];
+    if (tx.state != SLOT_PENDING || !(mask & (1 << tx.type))) continue;
+    if (tx.type == STM32_REQ_ACK && strcmp(tx.cmd, line) != 0) continue; // onay = komutun aynisi
+    if (match == nullptr || (int32_t)(tx.order - match->order) < 0) match = &tx;
+  }
+  return match;
+}
+
+// Istegi bitir: slotu bosalt, $A verisini veri handler'ina ver, sonucu loop()'a gonder
+static void completeTransaction(Stm32Transaction &tx, const char* line, size_t len) {
+  Stm32Reply reply;
+  reply.type    = tx.type;
+  reply.ok      = (line != nullptr);
+  reply.onReply = tx.onReply;
+  reply.ctx     = tx.ctx;
+  reply.line[0] = '\0';
+  if (line != nullptr) {
+    if (len > sizeof(reply.line) - 1) len = sizeof(reply.line) - 1;
+    memcpy(reply.line, line, len);  // ikili cerceve '\0' icerebilir
+    reply.line[len] = '\0';
+  }
+  if (line != nullptr) {
+    roundTrips.fetch_add(1, std::memory_order_relaxed);
+    replyWaitMs.fetch_add(halClock().millis() - tx.sentMs, std::memory_order_relaxed);
+  } else {
+    timeouts.fetch_add(1, std::memory_order_relaxed);
+  }
+  tx.state = SLOT_FREE;
+  inFlight--;
+  if (line != nullptr && reply.type == STM32_REQ_DATA && dataHandler != nullptr) {
+    dataHandler(line, dataCtx);
+  }
+  // loop() cevaplari almadan havuz tekrar tekrar dolarsa burada bekler (loop() bloke olmaz)
+  xQueueSend(replyQueue, &reply, portMAX_DELAY);
+  xTaskNotifyGive(serviceTaskHandle);
+}
+
+// Kuyruktaki en eski komuttan baslayarak, pencere izin verdigi surece gonder
+static void pumpTx() {
+  while (true) {
+    Stm32Transaction* next = nullptr;
+    for (int i = 0; i < STM32_QUEUE_SLOTS; i++) {
+      Stm32Transaction &tx = transactions[i];
+      if (tx.state != SLOT_QUEUED) continue;
+      if (next == nullptr || (int32_t)(tx.order - next->order) < 0) next = &tx;
+    }
+    if (next == nullptr) return;
+    bool needsReply = (next->type != STM32_REQ_SEND_ONLY);
+    if (needsReply && inFlight >= STM32_MAX_IN_FLIGHT) return; // sira korunur: arkadakiler de bekler
+
+#ifdef STM32_SIM
+    stm32SimReceive(next->cmd);
+#else
+    // flush yok: komut TX tamponuna yazilir, gonderim arka planda tamamlanir
+    halStm32Stream().write((const uint8_t*)next->cmd, strlen(next->cmd));
+    halStm32Stream().write((const uint8_t*)"\r\n", 2);
+#endif
+    if (needsReply) {
+      next->state  = SLOT_PENDING;
+      next->sentMs = halClock().millis();
+      inFlight++;
+    } else {
+      next->state = SLOT_FREE;
+    }
+  }
+}
+
+static void applyBaud(unsigned long baud) {
+#ifndef STM32_SIM
+  Serial1.flush();              // eski hizdaki son komut tamamen gitsin
+  Serial1.updateBaudRate(baud);
+#endif
+  vTaskDelay(pdMS_TO_TICKS(2)); // STM32'nin kendi UART'ini yeniden ayarlamasi icin
+}
+
+// Komut kuyrugundan havuza bos slot oldugu surece al (sira korunur)
+static void acceptCommands() {
+  Stm32Command c;
+  while (xQueuePeek(commandQueue, &c, 0) == pdTRUE) {
+    if (c.kind == CMD_BAUD) {
+      // Hiz degisimi onceki tum komutlar yazildiktan sonra
+      for (int i = 0; i < STM32_QUEUE_SLOTS; i++) {
+        if (transactions[i].state == SLOT_QUEUED) return;
+      }
+      applyBaud(c.baud);
+    } else {
+      Stm32Transaction* slot = nullptr;
+      for (int i = 0; i < STM32_QUEUE_SLOTS; i++) {
+        if (transactions[i].state == SLOT_FREE) {
+          slot = &transactions[i];
+          break;
+        }
+      }
+      if (slot == nullptr) return; // havuz dolu: komut kuyrukta bekler, loop() geri basinc gorur
+      slot->type      = (c.kind == CMD_SEND) ? (uint8_t)STM32_REQ_SEND_ONLY : c.type;
+      slot->order     = txOrder++;
+      slot->timeoutMs = c.timeoutMs;
+      slot->onReply   = c.onReply;
+      slot->ctx       = c.ctx;
+      memcpy(slot->cmd, c.cmd, sizeof(slot->cmd));
+      slot->state     = SLOT_QUEUED;
+    }
+    xQueueReceive(commandQueue, &c, 0);
+  }
+}
+
+// Biriken satirlari isteklere esle, zaman asimlarini isle
+static void serviceLines() {
+  char line[STM32_LINE_MAX];
+  size_t len;
+  while (popLine(line, sizeof(line), len)) {
+    uint8_t exactMask;
+    uint8_t mask = replyShapeMask(line, exactMask);
+    Stm32Transaction* match = findPending(exactMask, line);
+    if (match == nullptr) match = findPending(mask, line);
+    if (match == nullptr) {
+      // Bekleyen $A yokken gelen tam $A satiri: akis verisi
+      if ((exactMask & (1 << STM32_REQ_DATA)) && dataHandler != nullptr) {
+        streamLastFrameMs.store(halClock().millis(), std::memory_order_relaxed);
+        streamFrameSeen.store(true, std::memory_order_release);
+        dataHandler(line, dataCtx);
+        xTaskNotifyGive(serviceTaskHandle);
+      } else {
+        unmatchedLines++;
+      }
+      continue;
+    }
+    // STM32 komutlari sirayla cevaplar: bu cevaptan once gonderilip hala cevapsiz kalan
+    // istekler kaybolmustur, zaman asimini beklemeden basarisiz say.
+    // $A satiri bu cikarimi yapamaz: istenmeden gelen bir $AS akis satiri olabilir (akis
+    // kapanip polling'e donulurken yoldaki son kare); daha eski istekler cevabini bekler.
+    if (match->type != STM32_REQ_DATA) {
+      uint32_t matchOrder = match->order;
+      for (int i = 0; i < STM32_QUEUE_SLOTS; i++) {
+        Stm32Transaction &tx = transactions[i];
+        if (tx.state == SLOT_PENDING && (int32_t)(tx.order - matchOrder) < 0) {
+          completeTransaction(tx, nullptr, 0);
+        }
+      }
+    }
+    completeTransaction(*match, line, len);
+  }
+
+  unsigned long now = halClock().millis();
+  for (int i = 0; i < STM32_QUEUE_SLOTS; i++) {
+    Stm32Transaction &tx = transactions[i];
+    if (tx.state == SLOT_PENDING && now - tx.sentMs >= tx.timeoutMs) {
+      completeTransaction(tx, nullptr, 0);
+    }
+  }
+}
+
+// Haberlesme gorevinin bir turu: yeni komutlari al, satirlari esle, pencereyi doldur
+static void commsStep() {
+#ifdef STM32_SIM
+  stm32SimPoll();
+#endif
+  acceptCommands();
+  serviceLines();
+  // Cevaplarla acilan pencereye siradaki istekleri gonder; bosalan slotlara yeni komut al
+  while (true) {
+    pumpTx();
+    UBaseType_t waiting = uxQueueMessagesWaiting(commandQueue);
+    if (waiting == 0) break;
+    acceptCommands();
+    if (uxQueueMessagesWaiting(commandQueue) == waiting) break;
+  }
+}
+
+#ifdef ARDUINO
+// Haberlesme gorevi: Serial1 ve islem havuzunun tek sahibi
+static void commsTask(void* arg) {
+  for (;;) {
+    // Yeni satir (UART), yeni komut (loop) veya zaman asimi kontrolu icin uyan
+    ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(STM32_COMMS_IDLE_MS));
+    commsStep();
+  }
+}
+
+static void wakeComms() {
+  xTaskNotifyGive(commsTaskHandle);
+}
+#else
+// Host: ayri gorev yok. Tur, komut eklenince (gorevin hemen uyanmasi gibi) ve sanal saatin
+// her ms'sinde stm32LinkHostPoll() ile calisir. Baud degisimindeki bekleme turu ic ice
+// cagirabilecegi icin tekrar girise karsi korunur.
+static bool commsRunning = false;
+
+static void wakeComms() {
+  if (commsRunning) return;
+  commsRunning = true;
+  commsStep();
+  commsRunning = false;
+}
+
+void stm32LinkHostPoll() {
+  if (commsRunning || commandQueue == nullptr) return;  // stm32LinkBegin() oncesi
+  onSTM32Receive();
+  wakeComms();
+}
+#endif
+
+void stm32LinkSetDataHandler(Stm32ReplyHandler onFrame, void* ctx) {
+  dataHandler = onFrame;
+  dataCtx = ctx;
+}
+
+void stm32LinkBegin() {
+  rxLen = 0;
+  rxOverflow = false;
+  rxBinPos = 0;
+  rxBinEnabled = false;
+  lineTail.store(lineHead.load());
+  serviceTaskHandle = xTaskGetCurrentTaskHandle();
+  commandQueue = xQueueCreate(STM32_QUEUE_SLOTS, sizeof(Stm32Command));
+  replyQueue   = xQueueCreate(STM32_QUEUE_SLOTS, sizeof(Stm32Reply));
+#ifdef ARDUINO
+  xTaskCreatePinnedToCore(commsTask, "stm32_comms", STM32_COMMS_STACK, nullptr,
+                          STM32_COMMS_PRIORITY, &commsTaskHandle, STM32_COMMS_CORE);
+#ifndef STM32_SIM
+  Serial1.onReceive(onSTM32Receive);
+#endif
+#endif
+}
+
+// Komutu haberlesme gorevine ilet. Kuyruk doluysa (STM32 cevap vermiyor, havuz dolu)
+// yer acilana kadar bekler; bu sirada gelen cevaplar islenmeye devam eder.
+static bool submit(const Stm32Command &c) {
+  if (xQueueSend(commandQueue, &c, 0) != pdTRUE) {
+    unsigned long start = halClock().millis();
+    while (xQueueSend(commandQueue, &c, 0) != pdTRUE) {
+      stm32LinkService();
+      delay(1);
+    }
+    blockedMs += halClock().millis() - start;
+  }
+  wakeComms();
+  return true;
+}
+
+static bool enqueue(uint8_t kind, uint8_t type, const char* cmd, unsigned long timeoutMs,
+                    Stm32ReplyHandler onReply, void* ctx) {
+  Stm32Command c;
+  c.kind      = kind;
+  c.type      = type;
+  c.timeoutMs = timeoutMs;
+  c.baud      = 0;
+  c.onReply   = onReply;
+  c.ctx       = ctx;
+  strncpy(c.cmd, cmd, sizeof(c.cmd) - 1);
+  c.cmd[sizeof(c.cmd) - 1] = '\0';
+  if (kind == CMD_REQUEST) pendingByType[type]++;
+  return submit(c);
+}
+
+bool stm32LinkSend(const char* cmd) {
+  return enqueue(CMD_SEND, STM32_REQ_SEND_ONLY, cmd, 0, nullptr, nullptr);
+}
+
+bool stm32LinkRequest(Stm32Request type, const char* cmd, unsigned long timeoutMs,
+                      Stm32ReplyHandler onReply, void* ctx) {
+  return enqueue(CMD_REQUEST, type, cmd, timeoutMs, onReply, ctx);
+}
+
+bool stm32LinkIsPending(Stm32Request type) {
+  return pendingByType[type] > 0;
+}
+
+int stm32LinkInFlight() {
+  return inFlight;
+}
+
+void stm32LinkService() {
+  Stm32Reply reply;
+  while (xQueueReceive(replyQueue, &reply, 0) == pdTRUE) {
+    if (reply.type < STM32_REQ_COUNT) pendingByType[reply.type]--;
+    if (reply.onReply != nullptr) reply.onReply(reply.ok ? reply.line : nullptr, reply.ctx);
+  }
+}
+
+struct TransactResult {
+  bool   done;
+  bool   ok;
+  char*  reply;
+  size_t replyLen;
+};
+
+static void onTransactReply(const char* line, void* ctx) {
+  TransactResult* r = (TransactResult*)ctx;
+  if (line != nullptr) {
+    strncpy(r->reply, line, r->replyLen - 1);
+    r->reply[r->replyLen - 1] = '\0';
+    r->ok = true;
+  }
+  r->done = true;
+}
+
+static bool transactDone(void* ctx) {
+  return ((TransactResult*)ctx)->done;
+}
+
+void stm32LinkWaitUntil(bool (*done)(void* ctx), void* ctx) {
+  unsigned long start = halClock().millis();
+  // Beklerken diger islemlerin cevaplari kendi handler'larina gitmeye devam eder
+  while (true) {
+    stm32LinkService();
+    if (done(ctx)) break;
+    delay(1);
+  }
+  blockedMs += halClock().millis() - start;
+}
+
+bool stm32LinkTransact(Stm32Request type, const char* cmd, char* reply, size_t replyLen,
+                       unsigned long timeoutMs) {
+  TransactResult result = { false, false, reply, replyLen };
+  stm32LinkRequest(type, cmd, timeoutMs, onTransactReply, &result);
+  stm32LinkWaitUntil(transactDone, &result);
+  return result.ok;
+}
+
+bool stm32LinkStreaming() {
+  if (streamPeriodMs == 0 || !streamFrameSeen.load(std::memory_order_acquire)) return false;
+  return halClock().millis() - streamLastFrameMs.load(std::memory_order_relaxed) <=
+         streamPeriodMs * 3 + STM32_STREAM_GRACE_MS;
+}
+
+void stm32LinkSubscribe(unsigned long periodMs) {
+  unsigned long now = halClock().millis();
+  if (periodMs == streamPeriodMs) {
+    // Ayni periyot: akis geliyorsa veya yakin zamanda denendiyse tekrar gonderme
+    if (periodMs == 0 || stm32LinkStreaming()) return;
+    if (now - streamSubscribeMs < STM32_STREAM_RETRY_MS) return;
+  }
+  if (periodMs == 0) streamFrameSeen = false;
+  streamPeriodMs = periodMs;
+  streamSubscribeMs = now;
+
+  char cmd[STM32_CMD_MAX];
+  snprintf(cmd, sizeof(cmd), "$AS%lu", periodMs);
+  stm32LinkSend(cmd);
+}
+
+// Hatti birkac tur $A/$X ile dogrula (her cevap timeoutMs icinde gelmeli)
+static bool verifyLink(unsigned long timeoutMs) {
+  char reply[STM32_LINE_MAX];
+  for (int i = 0; i < STM32_BAUD_VERIFY_ROUNDS; i++) {
+    if (!stm32LinkTransact(STM32_REQ_DATA, "$A", reply, sizeof(reply), timeoutMs)) return false;
+    if (!stm32LinkTransact(STM32_REQ_STATUS, "$X", reply, sizeof(reply), timeoutMs)) return false;
+  }
+  return true;
+}
+
+// Hiz degisimini haberlesme gorevine sirali komut olarak ilet (Serial1'e yalnizca o dokunur)
+static void switchBaud(unsigned long baud) {
+  Stm32Command c;
+  memset(&c, 0, sizeof(c));
+  c.kind = CMD_BAUD;
+  c.baud = baud;
+  submit(c);
+}
+
+unsigned long stm32LinkNegotiateBaud(unsigned long currentBaud, const unsigned long* rates,
+                                     int rateCount, unsigned long timeoutMs) {
+  char cmd[STM32_CMD_MAX];
+  char reply[STM32_CMD_MAX];
+  for (int i = 0; i < rateCount; i++) {
+    if (rates[i] == currentBaud) continue;
+    snprintf(cmd, sizeof(cmd), "$U%lu", rates[i]);
+    if (!stm32LinkTransact(STM32_REQ_ACK, cmd, reply, sizeof(reply), timeoutMs)) {
+      continue; // bu hiz desteklenmiyor (veya $U hic bilinmiyor)
+    }
+    switchBaud(rates[i]);
+    if (verifyLink(timeoutMs)) return rates[i];
+
+    // Yeni hizda hat saglam degil: STM32'yi geri cagir, kendimiz don, STM32'nin
+    // kendiliginden donmesi icin de bekle
+    snprintf(cmd, sizeof(cmd), "$U%lu", currentBaud);
+    stm32LinkSend(cmd);
+    switchBaud(currentBaud);
+    delay(STM32_BAUD_REVERT_MS);
+    stm32LinkService(); // gecis sirasindaki kalan cevaplari temizle
+  }
+  return currentBaud;
+}
+
+bool stm32LinkNegotiateBinary(unsigned long timeoutMs) {
+  char reply[STM32_CMD_MAX];
+  binaryFrames = stm32LinkTransact(STM32_REQ_ACK, "$AB1", reply, sizeof(reply), timeoutMs);
+  return binaryFrames;
+}
+
+bool stm32LinkBinaryFrames() {
+  return binaryFrames;
+}
+
+uint32_t stm32LinkCrcErrors() {
+  return crcErrors.load(std::memory_order_relaxed);
+}
+
+uint32_t stm32LinkDroppedLines() {
+  return droppedLines.load(std::memory_order_relaxed);
+}
+
+uint32_t stm32LinkUnmatchedLines() {
+  return unmatchedLines;
+}
+
+uint32_t stm32LinkRoundTrips() {
+  return roundTrips.load(std::memory_order_relaxed);
+}
+
+uint32_t stm32LinkTimeouts() {
+  return timeouts.load(std::memory_order_relaxed);
+}
+
+uint32_t stm32LinkReplyWaitMs() {
+  return replyWaitMs.load(std::memory_order_relaxed);
+}
+
+uint32_t stm32LinkBlockedMs() {
+  return blockedMs;
+}
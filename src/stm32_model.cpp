@@ -0,0 +1,429 @@
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "stm32_model.h"
+
+static const char axisNames[STM32_MODEL_AXES] = { 'Z', 'Y', '1', '2' };
+
+// xorshift32: tohumlu, platformdan bagimsiz
+static uint32_t nextRandom(Stm32Model &m) {
+  uint32_t x = m.rng;
+  x ^= x << 13;
+  x ^= x >> 17;
+  x ^= x << 5;
+  m.rng = x;
+  return x;
+}
+
+static uint32_t randomBelow(Stm32Model &m, uint32_t n) {
+  return n == 0 ? 0 : nextRandom(m) % n;
+}
+
+static bool chancePpm(Stm32Model &m, uint32_t ppm) {
+  return ppm > 0 && randomBelow(m, 1000000) < ppm;
+}
+
+// Yavas degisen ucgen dalga: 0..amplitude..0, periyot periodMs
+static int triangle(unsigned long now, unsigned long periodMs, int amplitude) {
+  unsigned long t = now % periodMs;
+  unsigned long half = periodMs / 2;
+  if (t < half) return (int)(t * amplitude / half);
+  return (int)((periodMs - t) * amplitude / half);
+}
+
+// Rakamlardan olusan sayiyi oku (en az bir rakam); p sayinin sonunu gosterir
+static bool parseNumber(const char* &p, long &value) {
+  if (*p < '0' || *p > '9') return false;
+  value = 0;
+  while (*p >= '0' && *p <= '9') {
+    if (value > 100000000L) return false;
+    value = value * 10 + (*p++ - '0');
+  }
+  return true;
+}
+
+void stm32ModelSetTravel(Stm32Model &m, int axis, long minPos, long maxPos, long pos) {
+  if (axis < 0 || axis >= STM32_MODEL_AXES) return;
+  Stm32ModelAxis &a = m.axes[axis];
+  a.minPos = minPos;
+  a.maxPos = maxPos;
+  a.pos = pos < minPos ? minPos : pos > maxPos ? maxPos : pos;
+  a.busy = false;
+}
+
+void stm32ModelBegin(Stm32Model &m, uint32_t seed) {
+  memset(&m, 0, sizeof(m));
+  m.link.latencyMs = STM32_MODEL_LATENCY_MS;
+  m.rng = seed != 0 ? seed : 1;
+  m.baud = STM32_MODEL_BAUD;
+  m.ntcC = 25.0f;
+  m.irC = 24.0f;
+  m.gesture = -1;
+  // Ayni model fanlar bile tam ayni RPM'e oturmaz
+  m.fanMaxRpm[0] = STM32_MODEL_FAN_MAX_RPM;
+  m.fanMaxRpm[1] = STM32_MODEL_FAN_MAX_RPM - 60.0f;
+  m.fanMaxRpm[2] = STM32_MODEL_FAN_MAX_RPM + 80.0f;
+  stm32ModelSetTravel(m, 0, 0, 400000L, 200000L);  // Z
+  stm32ModelSetTravel(m, 1, 0, 200000L, 100000L);  // Y
+  stm32ModelSetTravel(m, 2, 0, 200000L, 100000L);  // CVR1
+  stm32ModelSetTravel(m, 3, 0, 200000L, 100000L);  // CVR2
+  // Tare edilmemis loadcell'ler: bos platform ve amplifikator ofseti
+  static const float offsets[STM32_MODEL_CELLS] = { 183.4f, -96.2f, 41.7f, 250.9f };
+  for (int i = 0; i < STM32_MODEL_CELLS; i++) m.cellOffset[i] = offsets[i];
+  m.rgbS = 100;
+  m.rgbV = 100;
+}
+
+// --- Fiziksel durum ---
+static void stepAxis(Stm32Model &m, Stm32ModelAxis &a, unsigned long now) {
+  unsigned long elapsed = now - a.startMs;
+  long distance = a.steps < 0 ? -a.steps : a.steps;
+  long travelled = (long)((int64_t)elapsed * a.speed / 1000);
+  if (travelled > distance) travelled = distance;
+  long pos = a.startPos + (a.steps < 0 ? -travelled : travelled);
+  // TMC stop switch'i: hareket yonundeki hat sonunda motor durur
+  if (a.steps > 0 && pos >= a.maxPos) {
+    a.pos = a.maxPos;
+    a.busy = false;
+    m.stats.limitHits++;
+    return;
+  }
+  if (a.steps < 0 && pos <= a.minPos) {
+    a.pos = a.minPos;
+    a.busy = false;
+    m.stats.limitHits++;
+    return;
+  }
+  a.pos = pos;
+  if (elapsed >= a.durationMs) a.busy = false;
+}
+
+static void stepPhysics(Stm32Model &m, unsigned long now) {
+  unsigned long dt = now - m.lastStepMs;
+  if (dt == 0) return;
+  m.lastStepMs = now;
+
+  float k = 1.0f - expf(-(float)dt / STM32_MODEL_FAN_TAU_MS);
+  for (int i = 0; i < STM32_MODEL_FANS; i++) {
+    float target = m.fanDuty[i] * m.fanMaxRpm[i] / 1999.0f;
+    m.fanRpm[i] += (target - m.fanRpm[i]) * k;
+  }
+  for (int i = 0; i < STM32_MODEL_AXES; i++) {
+    if (m.axes[i].busy) stepAxis(m, m.axes[i], now);
+  }
+}
+
+float stm32ModelLoadcell(Stm32Model &m, int cell, unsigned long nowMs) {
+  if (cell < 0 || cell >= STM32_MODEL_CELLS) return 0.0f;
+  float raw = m.cellOffset[cell] + m.cellLoad[cell];
+  if (m.tared) {
+    // Tare ortalamasi zamanla oturur: sifir noktasi tareZero'ya ustel yaklasir
+    float settled = 1.0f - expf(-(float)(nowMs - m.tareMs) / STM32_MODEL_LOADCELL_TAU_MS);
+    raw -= m.tareZero[cell] * settled;
+  }
+  float noise = ((int)randomBelow(m, 2001) - 1000) / 1000.0f * STM32_MODEL_LOADCELL_NOISE_G;
+  return raw + noise;
+}
+
+uint8_t stm32ModelStatus(const Stm32Model &m, unsigned long nowMs) {
+  static const uint8_t fanFaultBits[STM32_MODEL_FANS] = {
+    STM32_MODEL_FAULT_INTAKE1, STM32_MODEL_FAULT_INTAKE2, STM32_MODEL_FAULT_EXHAUST
+  };
+  uint8_t status = m.statusFaults;
+  for (int i = 0; i < STM32_MODEL_FANS; i++) {
+    if (m.fanDuty[i] > 0 && nowMs - m.fanDutyMs[i] >= STM32_MODEL_FAN_ERR_MS &&
+        m.fanRpm[i] < STM32_MODEL_FAN_STALL_RPM) {
+      status |= fanFaultBits[i];
+    }
+  }
+  return status;
+}
+
+void stm32ModelSample(Stm32Model &m, unsigned long now, int32_t (&v)[STM32_DATA_FIELDS]) {
+  stepPhysics(m, now);
+  v[0] = 120 + triangle(now, 3000, 80);   // MCU load %12.0 .. %20.0
+  v[1] = 310 + triangle(now, 20000, 10);  // PCB 31.0 .. 32.0 C
+  v[2] = (m.statusFaults & STM32_MODEL_FAULT_NTC) ? 0 : lroundf(m.ntcC * 10) + triangle(now, 20000, 4);
+  v[3] = (m.statusFaults & STM32_MODEL_FAULT_IR)  ? 0 : lroundf(m.irC * 10) + triangle(now, 15000, 6);
+  for (int i = 0; i < STM32_MODEL_FANS; i++) {
+    // Tako okumasinda kucuk dalgalanma (duran fan 0 okunur)
+    float ripple = m.fanRpm[i] > 50.0f ? ((int)randomBelow(m, 21) - 10) : 0.0f;
+    long rpm10 = lroundf((m.fanRpm[i] + ripple) * 10);
+    v[4 + i] = rpm10 < 0 ? 0 : rpm10;
+  }
+  // Gesture: sabit veya 4 saniyede bir UP/DOWN/LEFT/RIGHT, arada 1 sn NONE
+  v[7] = m.gesture >= 0 ? m.gesture : ((now / 1000) % 4 == 3) ? 0 : (int)((now / 4000) % 4) + 1;
+  const Stm32ModelAxis* a = m.axes;
+  v[8]  = a[0].pos >= a[0].maxPos;  // Z_R
+  v[9]  = a[1].pos >= a[1].maxPos;  // Y_R
+  v[10] = a[1].pos <= a[1].minPos;  // Y_L
+  v[11] = a[2].pos >= a[2].maxPos;  // CVR1_R
+  v[12] = a[2].pos <= a[2].minPos;  // CVR1_L
+  v[13] = a[3].pos >= a[3].maxPos;  // CVR2_R
+  v[14] = a[3].pos <= a[3].minPos;  // CVR2_L
+  v[15] = 0;
+  for (int i = 0; i < STM32_MODEL_AXES; i++) {
+    if (a[i].busy) v[15] |= 1 << i;
+  }
+}
+
+// --- Cevap kuyrugu: hat sirali, her satir kendi hat suresi kadar yer kaplar ---
+static void queueBytes(Stm32Model &m, const uint8_t* data, size_t len, unsigned long now,
+                       unsigned long delayMs) {
+  if (m.replyCount >= STM32_MODEL_REPLY_SLOTS) {
+    m.stats.droppedReplies++;  // gercek STM32 gibi cevap kaybolur
+    return;
+  }
+  Stm32ModelReply &r = m.replies[(m.replyHead + m.replyCount) % STM32_MODEL_REPLY_SLOTS];
+  if (len > sizeof(r.data)) len = sizeof(r.data);
+  uint64_t start = (uint64_t)(now + delayMs) * 1000;
+  if (start < m.txFreeUs) start = m.txFreeUs;
+  r.dueUs = start + (uint64_t)len * 10000000ULL / m.baud;  // 8N1: byte basina 10 bit
+  r.len = (uint8_t)len;
+  memcpy(r.data, data, len);
+  m.txFreeUs = r.dueUs;
+  m.replyCount++;
+}
+
+static unsigned long replyDelay(Stm32Model &m) {
+  return m.link.latencyMs + randomBelow(m, m.link.jitterMs + 1);
+}
+
+static void queueLine(Stm32Model &m, const char* line, unsigned long now, unsigned long delayMs) {
+  uint8_t buf[STM32_LINE_MAX + 2];
+  size_t len = strlen(line);
+  if (len > STM32_LINE_MAX) len = STM32_LINE_MAX;
+  memcpy(buf, line, len);
+  buf[len++] = '\r';
+  buf[len++] = '\n';
+  queueBytes(m, buf, len, now, delayMs);
+}
+
+static void queueDataFrame(Stm32Model &m, unsigned long now, unsigned long delayMs) {
+  int32_t v[STM32_DATA_FIELDS];
+  stm32ModelSample(m, now, v);
+  if (m.binaryFrames) {
+    uint8_t frame[STM32_BIN_FRAME_LEN];
+    queueBytes(m, frame, stm32LinkEncodeDataFrame(v, frame), now, delayMs);
+    return;
+  }
+  char line[STM32_LINE_MAX];
+  int n = snprintf(line, sizeof(line), "$%ld", (long)v[0]);
+  for (int i = 1; i < STM32_DATA_FIELDS; i++) n += snprintf(line + n, sizeof(line) - n, ",%ld", (long)v[i]);
+  queueLine(m, line, now, delayMs);
+}
+
+static void transmit(Stm32Model &m, const Stm32ModelReply &r, HalByteStream &out) {
+  uint8_t buf[sizeof(r.data)];
+  size_t n = 0;
+  for (size_t i = 0; i < r.len; i++) {
+    m.stats.bytesOut++;
+    if (chancePpm(m, m.link.lossPpm)) {
+      m.stats.bytesLost++;
+      continue;
+    }
+    uint8_t b = r.data[i];
+    if (chancePpm(m, m.link.corruptPpm)) {
+      b ^= (uint8_t)(1 << randomBelow(m, 8));
+      m.stats.bytesCorrupted++;
+    }
+    buf[n++] = b;
+  }
+  if (n > 0) out.write(buf, n);
+}
+
+// --- Komutlar ---
+// $SZ / $SY / $S1 / $S2: E/D enable, P stop, "<yon>,<adim>,<hiz>" hareket
+static bool motorCommand(Stm32Model &m, const char* cmd, unsigned long now) {
+  int axis = -1;
+  for (int i = 0; i < STM32_MODEL_AXES; i++) {
+    if (cmd[2] == axisNames[i]) axis = i;
+  }
+  if (axis < 0) return false;
+  Stm32ModelAxis &a = m.axes[axis];
+  const char* p = cmd + 3;
+  if ((*p == 'E' || *p == 'D' || *p == 'P') && p[1] == '\0') {
+    if (*p == 'E') a.enabled = true;
+    if (*p == 'D') a.enabled = false;
+    a.busy = false;  // stop ve disable hareketi keser
+    return true;
+  }
+  long dir, steps, speed;
+  if (!parseNumber(p, dir) || dir > 1 || *p++ != ',') return false;
+  if (!parseNumber(p, steps) || *p++ != ',') return false;
+  if (!parseNumber(p, speed) || *p != '\0') return false;
+  if (!a.enabled || steps == 0 || speed == 0) return true;  // surucu kapali: komut yok sayilir
+
+  a.busy = true;
+  a.startPos = a.pos;
+  a.steps = dir ? steps : -steps;
+  a.speed = speed;
+  a.startMs = now;
+  a.durationMs = (unsigned long)(steps * 1000L / speed) + STM32_MODEL_MOTOR_RAMP_MS;
+  stepAxis(m, a, now);  // zaten stop switch'indeyse hemen durur
+  return true;
+}
+
+static bool handleCommand(Stm32Model &m, const char* cmd, unsigned long now) {
+  char line[STM32_LINE_MAX];
+  const char* p = cmd + 2;
+  long value;
+  if (cmd[0] != '$' || cmd[1] == '\0') return false;
+
+  switch (cmd[1]) {
+  case 'A':
+    if (cmd[2] == '\0') {
+      queueDataFrame(m, now, replyDelay(m));
+      m.stats.replies++;
+      return true;
+    }
+    if (cmd[2] == 'B' && (cmd[3] == '0' || cmd[3] == '1') && cmd[4] == '\0') {
+      m.binaryFrames = (cmd[3] == '1');
+      queueLine(m, cmd, now, replyDelay(m));  // onay: komutun aynisi
+      m.stats.replies++;
+      return true;
+    }
+    if (cmd[2] == 'S') {
+      p = cmd + 3;
+      if (!parseNumber(p, value) || *p != '\0') return false;
+      m.streamPeriodMs = (unsigned long)value;
+      m.lastStreamMs = now;
+      return true;
+    }
+    return false;
+  case 'U':
+    p = cmd + 2;
+    if (!parseNumber(p, value) || *p != '\0' || value < 1200) return false;
+    queueLine(m, cmd, now, replyDelay(m));  // onay eski hizda gider, sonra yeni hiz
+    m.stats.replies++;
+    m.baud = (unsigned long)value;
+    return true;
+  case 'X':
+    if (cmd[2] != '\0') return false;
+    {
+      uint8_t status = stm32ModelStatus(m, now);
+      int n = snprintf(line, sizeof(line), "$%d", status & 1);
+      for (int i = 1; i < STM32_MODEL_STATUS_FIELDS; i++) n += snprintf(line + n, sizeof(line) - n, ",%d", (status >> i) & 1);
+    }
+    queueLine(m, line, now, replyDelay(m));
+    m.stats.replies++;
+    return true;
+  case 'W':
+    if (cmd[2] == 'T' && cmd[3] == '\0') {
+      stepPhysics(m, now);
+      for (int i = 0; i < STM32_MODEL_CELLS; i++) m.tareZero[i] = m.cellOffset[i] + m.cellLoad[i];
+      m.tareMs = now;
+      m.tared = true;
+      return true;
+    }
+    if (cmd[2] >= '1' && cmd[2] <= '4' && cmd[3] == '\0') {
+      snprintf(line, sizeof(line), "$%.2f", stm32ModelLoadcell(m, cmd[2] - '1', now));
+      queueLine(m, line, now, replyDelay(m));
+      m.stats.replies++;
+      return true;
+    }
+    return false;
+  case 'F':
+    if (cmd[2] < '1' || cmd[2] > '3') return false;
+    p = cmd + 3;
+    if (!parseNumber(p, value) || *p != '\0') return false;
+    stepPhysics(m, now);
+    m.fanDuty[cmd[2] - '1'] = value > 1999 ? 1999 : (int)value;
+    m.fanDutyMs[cmd[2] - '1'] = now;
+    return true;
+  case 'L':
+    {
+      long h, s, v;
+      p = cmd + 3;
+      if (cmd[2] != 'A' || !parseNumber(p, h) || *p++ != ',' || !parseNumber(p, s) || *p++ != ',' ||
+          !parseNumber(p, v) || *p != '\0') return false;
+      m.rgbH = (int)h;
+      m.rgbS = (int)s;
+      m.rgbV = (int)v;
+    }
+    return true;
+  case 'B':
+    if ((cmd[2] != '0' && cmd[2] != '1') || cmd[3] != '\0') return false;
+    m.brake = (cmd[2] == '1');
+    return true;
+  case 'P':
+    if (cmd[2] == 'C') {
+      p = cmd + 3;
+      if (!parseNumber(p, value) || *p != '\0') return false;
+      m.projectorCurrent = (int)value;
+      return true;
+    }
+    if ((cmd[2] != '0' && cmd[2] != '1' && cmd[2] != 'F') || cmd[3] != '\0') return false;
+    m.projectorOn = (cmd[2] == '1');
+    return true;
+  case 'I':
+    if (cmd[2] != '\0') return false;
+    m.configCount++;
+    return true;
+  case 'S':
+    stepPhysics(m, now);
+    return motorCommand(m, cmd, now);
+  default:
+    return false;
+  }
+}
+
+void stm32ModelCommand(Stm32Model &m, const char* cmd, unsigned long nowMs) {
+  m.stats.commands++;
+  if (!handleCommand(m, cmd, nowMs)) m.stats.unknownCommands++;
+}
+
+void stm32ModelReceive(Stm32Model &m, const uint8_t* data, size_t len, unsigned long nowMs) {
+  for (size_t i = 0; i < len; i++) {
+    m.stats.bytesIn++;
+    if (chancePpm(m, m.link.lossPpm)) {
+      m.stats.bytesLost++;
+      continue;
+    }
+    uint8_t b = data[i];
+    if (chancePpm(m, m.link.corruptPpm)) {
+      b ^= (uint8_t)(1 << randomBelow(m, 8));
+      m.stats.bytesCorrupted++;
+    }
+    if (b == '\n') {
+      if (!m.rxOverflow && m.rxLen > 0) {
+        m.rxLine[m.rxLen] = '\0';
+        stm32ModelCommand(m, m.rxLine, nowMs);
+      }
+      m.rxLen = 0;
+      m.rxOverflow = false;
+    } else if (b != '\r') {
+      if (m.rxLen < STM32_LINE_MAX - 1) {
+        m.rxLine[m.rxLen++] = (char)b;
+      } else {
+        m.rxOverflow = true;  // sonraki '\n'e kadar at
+      }
+    }
+  }
+}
+
+void stm32ModelPoll(Stm32Model &m, unsigned long nowMs, HalByteStream &out) {
+  stepPhysics(m, nowMs);
+  if (m.streamPeriodMs > 0 && nowMs - m.lastStreamMs >= m.streamPeriodMs) {
+    m.lastStreamMs = nowMs;
+    queueDataFrame(m, nowMs, 0);
+    m.stats.streamLines++;
+  }
+  uint64_t nowUs = (uint64_t)nowMs * 1000;
+  while (m.replyCount > 0 && m.replies[m.replyHead].dueUs <= nowUs) {
+    transmit(m, m.replies[m.replyHead], out);
+    m.replyHead = (m.replyHead + 1) % STM32_MODEL_REPLY_SLOTS;
+    m.replyCount--;
+  }
+}
+
+void stm32ModelService(Stm32Model &m, HalByteStream &link, unsigned long nowMs) {
+  uint8_t buf[64];
+  while (link.available() > 0) {
+    size_t n = link.read(buf, sizeof(buf));
+    if (n == 0) break;
+    stm32ModelReceive(m, buf, n, nowMs);
+  }
+  stm32ModelPoll(m, nowMs, link);
+}
@@ -0,0 +1,40 @@
+#ifdef STM32_SIM
+
+#include <Arduino.h>
+
+#include "stm32_link.h"
+#include "stm32_model.h"
+#include "stm32_sim.h"
+
+// Modelin "UART cikisi": byte'lar dogrudan satir birlestiriciye gider
+class LinkFeedStream : public HalByteStream {
+public:
+  int available() override { return 0; }
+  size_t read(uint8_t*, size_t) override { return 0; }
+  size_t write(const uint8_t* data, size_t len) override {
+    stm32LinkFeed(data, len);
+    return len;
+  }
+};
+
+static Stm32Model     model;
+static LinkFeedStream feedStream;
+static bool           modelStarted = false;
+
+static Stm32Model& simModel() {
+  if (!modelStarted) {
+    stm32ModelBegin(model);
+    modelStarted = true;
+  }
+  return model;
+}
+
+void stm32SimReceive(const char* cmd) {
+  stm32ModelCommand(simModel(), cmd, millis());
+}
+
+void stm32SimPoll() {
+  stm32ModelPoll(simModel(), millis(), feedStream);
+}
+
+#endif // STM32_SIM
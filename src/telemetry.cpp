@@ -0,0 +1,60 @@
+#include <atomic>
+
+#include "telemetry.h"
+
+// Iki tampon: yazici her zaman yayinda olmayana yazar, sonra publishCount'u ilerletir.
+// Aktif tampon = publishCount & 1. Okuyucu aktif tamponu kopyalarken yazici ancak bir
+// sonraki yayinda (diger tampona) yazar; ondan sonraki yayin okuyucunun tamponuna yazacagi
+// icin writeCount ile yakalanir ve okuyucu tekrar dener.
+static TelemetrySnapshot     buffers[2];
+static std::atomic<uint32_t> publishCount(0);  // tamamlanan yayin sayisi
+static std::atomic<uint32_t> writeCount(0);    // baslanan yayin sayisi
+
+void telemetryPublish(const TelemetrySnapshot &frame) {
+  uint32_t n = publishCount.load(std::memory_order_relaxed) + 1;
+  writeCount.store(n, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+
+  TelemetrySnapshot &dst = buffers[n & 1];
+  dst = frame;
+  dst.seq = n;
+  publishCount.store(n, std::memory_order_release);
+}
+
+bool telemetryRead(TelemetrySnapshot &out) {
+  while (true) {
+    uint32_t n = publishCount.load(std::memory_order_acquire);
+    if (n == 0) return false;
+    out = buffers[n & 1];
+    std::atomic_thread_fence(std::memory_order_acquire);
+    // Kopya sirasinda en fazla bir sonraki yayin (diger tampon) baslamis olabilir
+    if (writeCount.load(std::memory_order_relaxed) - n <= 1) return true;
+  }
+}
+
+bool telemetryReadIfNew(TelemetrySnapshot &out, uint32_t &lastSeq) {
+  if (publishCount.load(std::memory_order_acquire) == lastSeq) return false;
+  if (!telemetryRead(out)) return false;
+  lastSeq = out.seq;
+  return true;
+}
+
+uint32_t telemetrySequence() {
+  return publishCount.load(std::memory_order_acquire);
+}
+
+bool telemetryChannelValue(const TelemetrySnapshot &t, TelemetryChannel channel, float &value) {
+  // Kanal n, $A'nin (n + 1). alani
+  if ((int)channel < 0 || channel >= TELEMETRY_CHANNEL_COUNT || t.fieldCount <= (int)channel) return false;
+  switch (channel) {
+    case TELEMETRY_MCU_LOAD:    value = t.mcuLoad;    break;
+    case TELEMETRY_PCB_TEMP:    value = t.pcbTemp;    break;
+    case TELEMETRY_PLATE_TEMP:  value = t.plateTemp;  break;
+    case TELEMETRY_RESIN_TEMP:  value = t.resinTemp;  break;
+    case TELEMETRY_INTAKE1_RPM: value = t.intake1Rpm; break;
+    case TELEMETRY_INTAKE2_RPM: value = t.intake2Rpm; break;
+    case TELEMETRY_EXHAUST_RPM: value = t.exhaustRpm; break;
+    default: return false;
+  }
+  return true;
+}
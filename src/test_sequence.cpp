@@ -0,0 +1,138 @@
+#include "test_sequence.h"
+#include "stm32_link.h"
+
+// Bir tick'te islenebilecek en fazla anlik adim (hatali tabloda sonsuz donguye karsi)
+#define TEST_RUNNER_MAX_INSTANT_STEPS 64
+
+static void nextStep(TestRunner &r, unsigned long now) {
+  r.index++;
+  r.stepStartMs = now;
+}
+
+static void failStep(TestRunner &r, const char* label) {
+  r.state = TEST_RUN_FAIL;
+  r.failLabel = label;
+}
+
+void testRunnerStart(TestRunner &r, const TestStep* steps, int stepCount) {
+  r.steps = steps;
+  r.stepCount = stepCount;
+  r.index = 0;
+  r.state = TEST_RUN_BUSY;
+  r.phase = 0;
+  r.failLabel = nullptr;
+  r.repeatStep = -1;
+  r.repeatLeft = 0;
+  r.sampleStep = -1;
+  r.sampleCount = 0;
+  r.lastSampleMs = 0;
+  r.sampleMin = 0.0f;
+  r.sampleMax = 0.0f;
+  r.sampleSum = 0.0f;
+  // Ilk adimin baslangic zamani ilk tick'te alinir
+  r.stepStartMs = (unsigned long)-1;
+}
+
+bool testRunnerTick(TestRunner &r, unsigned long now) {
+  if (r.state != TEST_RUN_BUSY) return false;
+  if (r.stepStartMs == (unsigned long)-1) r.stepStartMs = now;
+
+  for (int n = 0; n < TEST_RUNNER_MAX_INSTANT_STEPS; n++) {
+    if (r.index >= r.stepCount) {
+      r.state = TEST_RUN_PASS;
+      return true;
+    }
+
+    const TestStep &s = r.steps[r.index];
+    switch (s.kind) {
+      case TEST_STEP_SEND:
+        stm32LinkSend(s.label);
+        nextStep(r, now);
+        break;
+
+      case TEST_STEP_ACTION:
+        if (!s.action(s.arg)) {
+          failStep(r, s.label);
+          return true;
+        }
+        // Eylem testi bitirmis olabilir (ornek: abort)
+        if (r.state != TEST_RUN_BUSY) return false;
+        nextStep(r, now);
+        break;
+
+      case TEST_STEP_PHASE:
+        r.phase = s.arg;
+        nextStep(r, now);
+        break;
+
+      case TEST_STEP_WAIT:
+        if (now - r.stepStartMs < s.ms) return false;
+        // Sonraki adim beklemenin bittigi andan sayilir (tick gecikmesi birikmez)
+        r.index++;
+        r.stepStartMs += s.ms;
+        break;
+
+      case TEST_STEP_WAIT_UNTIL:
+        if (s.probe(s.arg) != 0.0f) {
+          nextStep(r, now);
+          break;
+        }
+        if (now - r.stepStartMs >= s.ms) {
+          failStep(r, s.label);
+          return true;
+        }
+        return false;
+
+      case TEST_STEP_SAMPLE: {
+        if (r.sampleStep != r.index) {
+          // Yeni ornekleme: onceki sonuclar (ASSERT sonrasi okunabilir) burada silinir
+          r.sampleStep = r.index;
+          r.sampleCount = 0;
+          r.sampleSum = 0.0f;
+        }
+        if (r.sampleCount > 0 && now - r.lastSampleMs < s.ms) return false;
+        float v = s.probe(s.arg);
+        if (r.sampleCount == 0 || v < r.sampleMin) r.sampleMin = v;
+        if (r.sampleCount == 0 || v > r.sampleMax) r.sampleMax = v;
+        r.sampleSum += v;
+        r.sampleCount++;
+        r.lastSampleMs = now;
+        if (r.sampleCount < s.count) return false;
+        r.sampleStep = -1;
+        nextStep(r, now);
+        break;
+      }
+
+      case TEST_STEP_ASSERT: {
+        bool ok = r.sampleCount > 0 && r.sampleMin >= s.lo && r.sampleMax <= s.hi;
+        if (!ok) {
+          failStep(r, s.label);
+          return true;
+        }
+        nextStep(r, now);
+        break;
+      }
+
+      case TEST_STEP_REPEAT:
+        if (r.repeatStep != r.index) {
+          r.repeatStep = r.index;
+          r.repeatLeft = s.count;
+        }
+        if (r.repeatLeft > 0) {
+          r.repeatLeft--;
+          r.index -= s.arg;
+          if (r.index < 0) r.index = 0;
+          r.stepStartMs = now;
+        } else {
+          r.repeatStep = -1;
+          nextStep(r, now);
+        }
+        break;
+    }
+  }
+  return false;
+}
+
+void testRunnerAbort(TestRunner &r) {
+  if (r.state == TEST_RUN_BUSY) r.state = TEST_RUN_ABORTED;
+}
@@ -0,0 +1,77 @@
+#include "test_suite.h"
+
+void testSuiteStart(TestSuite &s, const TestSuiteEntry* entries, int entryCount, unsigned long now) {
+  if (entryCount > TEST_SUITE_MAX_ENTRIES) entryCount = TEST_SUITE_MAX_ENTRIES;
+  s.entries = entries;
+  s.entryCount = entryCount;
+  for (int i = 0; i < entryCount; i++) {
+    s.results[i] = TEST_SUITE_PENDING;
+    s.durationMs[i] = 0;
+  }
+  s.lockedResources = 0;
+  s.running = true;
+  s.startMs = now;
+  s.endMs = now;
+}
+
+bool testSuiteTick(TestSuite &s, unsigned long now) {
+  if (!s.running) return false;
+
+  // 1) Biten testlerin sonucunu al ve kaynaklarini birak
+  for (int i = 0; i < s.entryCount; i++) {
+    const TestSuiteEntry &e = s.entries[i];
+    if (s.results[i] != TEST_SUITE_RUNNING || e.busy()) continue;
+    s.results[i] = e.passed() ? TEST_SUITE_PASS : TEST_SUITE_FAIL;
+    s.durationMs[i] = now - s.durationMs[i];
+    s.lockedResources &= ~e.resources;
+  }
+
+  // 2) Bekleyenleri tablo sirasiyla baslat; bekleyen testin kaynaklari sonrakilere de kapali
+  uint32_t blocked = s.lockedResources;
+  bool pending = false;
+  for (int i = 0; i < s.entryCount; i++) {
+    const TestSuiteEntry &e = s.entries[i];
+    if (s.results[i] == TEST_SUITE_RUNNING) pending = true;
+    if (s.results[i] != TEST_SUITE_PENDING) continue;
+    pending = true;
+    if (e.resources & blocked) {
+      blocked |= e.resources;
+      continue;
+    }
+    blocked |= e.resources;
+    s.lockedResources |= e.resources;
+    s.results[i] = TEST_SUITE_RUNNING;
+    s.durationMs[i] = now;
+    // Hemen biten test (ornek: sensor bagli degil) bir sonraki tick'te toplanir
+    e.start();
+  }
+
+  if (pending) return false;
+  s.running = false;
+  s.endMs = now;
+  return true;
+}
+
+void testSuiteAbort(TestSuite &s, unsigned long now) {
+  if (!s.running) return;
+  for (int i = 0; i < s.entryCount; i++) {
+    if (s.results[i] == TEST_SUITE_RUNNING) {
+      s.entries[i].abort();
+      s.durationMs[i] = now - s.durationMs[i];
+      s.results[i] = TEST_SUITE_ABORTED;
+    } else if (s.results[i] == TEST_SUITE_PENDING) {
+      s.results[i] = TEST_SUITE_ABORTED;
+    }
+  }
+  s.lockedResources = 0;
+  s.running = false;
+  s.endMs = now;
+}
+
+int testSuiteCount(const TestSuite &s, TestSuiteResult result) {
+  int count = 0;
+  for (int i = 0; i < s.entryCount; i++) {
+    if (s.results[i] == result) count++;
+  }
+  return count;
+}
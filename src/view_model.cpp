@@ -0,0 +1,12 @@
+#include "view_model.h"
+
+#define VIEW_HASH_PRIME 16777619u
+
+uint32_t viewHashBytes(uint32_t hash, const void* data, size_t len) {
+  const uint8_t* p = (const uint8_t*)data;
+  for (size_t i = 0; i < len; i++) {
+    hash ^= p[i];
+    hash *= VIEW_HASH_PRIME;
+  }
+  return hash;
+}
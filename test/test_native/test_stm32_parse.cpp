@@ -0,0 +1,192 @@
+// STM32 cevap ayristirici birim testleri (pio test -e native)
+// stm32_fields.h: isaret, ondalik, bos / fazladan karakter / uzun alan reddi, kisa satirda
+// hedeflerin korunmasi; stm32_decode.h: $X ve $Wn cozuculeri (main.cpp, test_build_src).
+
+#include <unity.h>
+
+#include "stm32_decode.h"
+#include "stm32_fields.h"
+
+void setUp() {}
+void tearDown() {}
+
+// --- stm32ParseFields / stm32ParseInto ---
+
+static int   intA, intB;
+static float floatA, floatB;
+
+static const Stm32Field signedSchema[2] = {
+  stm32IntField(&intA, true),
+  stm32IntField(&intB, true),
+};
+
+static const Stm32Field unsignedSchema[2] = {
+  stm32IntField(&intA),
+  stm32IntField(&intB),
+};
+
+static const Stm32Field scaledSchema[2] = {
+  stm32ScaledField(&floatA, 10.0f),
+  stm32DecimalField(&floatB, 2),
+};
+
+static void test_fields_parse_signed_integers() {
+  int32_t raw[2];
+  TEST_ASSERT_EQUAL_INT(2, stm32ParseFields("$-35,244", signedSchema, raw));
+  TEST_ASSERT_EQUAL_INT(-35, raw[0]);
+  TEST_ASSERT_EQUAL_INT(244, raw[1]);
+  TEST_ASSERT_EQUAL_INT(2, stm32ParseFields("$-0,0", signedSchema, raw));
+  TEST_ASSERT_EQUAL_INT(0, raw[0]);
+}
+
+static void test_fields_reject_minus_in_unsigned_field() {
+  int32_t raw[2];
+  TEST_ASSERT_EQUAL_INT(-1, stm32ParseFields("$1,-2", unsignedSchema, raw));
+  TEST_ASSERT_EQUAL_INT(-1, stm32ParseFields("$--1,2", signedSchema, raw));
+  TEST_ASSERT_EQUAL_INT(-1, stm32ParseFields("$-,2", signedSchema, raw));
+}
+
+static void test_fields_scale_and_decimals() {
+  int32_t raw[2];
+  TEST_ASSERT_EQUAL_INT(2, stm32ParseInto("$286,-152.28", scaledSchema, raw, 2));
+  TEST_ASSERT_FLOAT_WITHIN(0.001f, 28.6f, floatA);
+  TEST_ASSERT_EQUAL_INT(-15228, raw[1]);
+  TEST_ASSERT_FLOAT_WITHIN(0.001f, -152.28f, floatB);
+
+  // Eksik ondalik haneler sifirla tamamlanir, fazlasi kesilir
+  TEST_ASSERT_EQUAL_INT(2, stm32ParseFields("$1,12", scaledSchema, raw));
+  TEST_ASSERT_EQUAL_INT(1200, raw[1]);
+  TEST_ASSERT_EQUAL_INT(2, stm32ParseFields("$1,0.129", scaledSchema, raw));
+  TEST_ASSERT_EQUAL_INT(12, raw[1]);
+
+  // Ondaliksiz alanda nokta, noktadan sonra rakamsiz alan
+  TEST_ASSERT_EQUAL_INT(-1, stm32ParseFields("$1.5,1", scaledSchema, raw));
+  TEST_ASSERT_EQUAL_INT(-1, stm32ParseFields("$1,1.", scaledSchema, raw));
+}
+
+static void test_fields_reject_empty_and_stray() {
+  int32_t raw[2];
+  TEST_ASSERT_EQUAL_INT(-1, stm32ParseFields("$", signedSchema, raw));
+  TEST_ASSERT_EQUAL_INT(-1, stm32ParseFields("$1,,2", signedSchema, raw));
+  TEST_ASSERT_EQUAL_INT(-1, stm32ParseFields("$1,", signedSchema, raw));
+  TEST_ASSERT_EQUAL_INT(-1, stm32ParseFields("$,1", signedSchema, raw));
+  TEST_ASSERT_EQUAL_INT(-1, stm32ParseFields("$1,2x", signedSchema, raw));
+  TEST_ASSERT_EQUAL_INT(-1, stm32ParseFields("$1 ,2", signedSchema, raw));
+  TEST_ASSERT_EQUAL_INT(-1, stm32ParseFields("1,2", signedSchema, raw));
+  TEST_ASSERT_EQUAL_INT(-1, stm32ParseFields(nullptr, signedSchema, raw));
+}
+
+static void test_fields_reject_over_long_numbers() {
+  int32_t raw[2];
+  TEST_ASSERT_EQUAL_INT(2, stm32ParseFields("$999999999,-999999999", signedSchema, raw));
+  TEST_ASSERT_EQUAL_INT(999999999, raw[0]);
+  TEST_ASSERT_EQUAL_INT(-999999999, raw[1]);
+  TEST_ASSERT_EQUAL_INT(-1, stm32ParseFields("$1000000000,0", signedSchema, raw));
+  TEST_ASSERT_EQUAL_INT(-1, stm32ParseFields("$0000000000,0", signedSchema, raw));
+  // Ondalik tamamlama da hane sinirina sayilir: 8 hane + 2 ondalik
+  TEST_ASSERT_EQUAL_INT(-1, stm32ParseFields("$1,12345678", scaledSchema, raw));
+}
+
+static void test_fields_ignore_extra_fields() {
+  int32_t raw[2];
+  TEST_ASSERT_EQUAL_INT(2, stm32ParseFields("$1,2,3,yeni", signedSchema, raw));
+  TEST_ASSERT_EQUAL_INT(1, raw[0]);
+  TEST_ASSERT_EQUAL_INT(2, raw[1]);
+}
+
+static void test_fields_short_line_keeps_old_values() {
+  int32_t raw[2];
+  intA = 7;
+  intB = 8;
+  // minFields'ten kisa: hicbir hedef yazilmaz
+  TEST_ASSERT_EQUAL_INT(-1, stm32ParseInto("$1", signedSchema, raw, 2));
+  TEST_ASSERT_EQUAL_INT(7, intA);
+  TEST_ASSERT_EQUAL_INT(8, intB);
+  // Yeterli ama eksik: yalnizca gelen alanlar yazilir
+  TEST_ASSERT_EQUAL_INT(1, stm32ParseInto("$1", signedSchema, raw, 1));
+  TEST_ASSERT_EQUAL_INT(1, intA);
+  TEST_ASSERT_EQUAL_INT(8, intB);
+  // Gecersiz satir: gecerli ilk alan da yazilmaz
+  TEST_ASSERT_EQUAL_INT(-1, stm32ParseInto("$5,x", signedSchema, raw, 1));
+  TEST_ASSERT_EQUAL_INT(1, intA);
+  TEST_ASSERT_EQUAL_INT(8, intB);
+}
+
+// --- $X: parseSensorStatusLine ---
+
+static void test_status_line_full() {
+  int ntc = -1, ir = -1;
+  TEST_ASSERT_TRUE(parseSensorStatusLine("$0,1,1,0,1,0,1,1", ntc, ir));
+  TEST_ASSERT_EQUAL_INT(0, ntc);
+  TEST_ASSERT_EQUAL_INT(1, ir);
+  TEST_ASSERT_EQUAL_INT(1, exhaust_fan_error);
+  TEST_ASSERT_EQUAL_INT(0, intake1_fan_error);
+  TEST_ASSERT_EQUAL_INT(1, intake2_fan_error);
+  TEST_ASSERT_EQUAL_INT(0, gesture_sensor_status);
+  TEST_ASSERT_EQUAL_INT(1, projector_sensor_status);
+  TEST_ASSERT_EQUAL_INT(1, force_sensor_status);
+}
+
+static void test_status_line_short_resets_missing_fields() {
+  int ntc = -1, ir = -1;
+  TEST_ASSERT_TRUE(parseSensorStatusLine("$0,1,1,0,1,0,1,1", ntc, ir));
+  // Yalnizca NTC / IR: eksik durumlar OK'a (0) cekilir
+  TEST_ASSERT_TRUE(parseSensorStatusLine("$0,0", ntc, ir));
+  TEST_ASSERT_EQUAL_INT(0, ntc);
+  TEST_ASSERT_EQUAL_INT(0, ir);
+  TEST_ASSERT_EQUAL_INT(0, exhaust_fan_error);
+  TEST_ASSERT_EQUAL_INT(0, intake2_fan_error);
+  TEST_ASSERT_EQUAL_INT(0, force_sensor_status);
+}
+
+static void test_status_line_invalid_or_timeout() {
+  int ntc = 0, ir = 0;
+  TEST_ASSERT_FALSE(parseSensorStatusLine(nullptr, ntc, ir));
+  TEST_ASSERT_EQUAL_INT(1, ntc);  // 1 = baglanti yok
+  TEST_ASSERT_EQUAL_INT(1, ir);
+  ntc = ir = 0;
+  TEST_ASSERT_FALSE(parseSensorStatusLine("$0", ntc, ir));
+  TEST_ASSERT_EQUAL_INT(1, ntc);
+  TEST_ASSERT_FALSE(parseSensorStatusLine("$0,-1", ntc, ir));
+  TEST_ASSERT_FALSE(parseSensorStatusLine("$0,1.0", ntc, ir));
+  TEST_ASSERT_FALSE(parseSensorStatusLine("$0,1,x,0", ntc, ir));
+  TEST_ASSERT_EQUAL_INT(0, exhaust_fan_error);
+}
+
+// --- $Wn: parseLoadcellLine ---
+
+static void test_loadcell_line() {
+  float value = 0.0f;
+  TEST_ASSERT_TRUE(parseLoadcellLine("$-152.28", value));
+  TEST_ASSERT_FLOAT_WITHIN(0.0005f, -152.28f, value);
+  TEST_ASSERT_TRUE(parseLoadcellLine("$12", value));
+  TEST_ASSERT_FLOAT_WITHIN(0.0005f, 12.0f, value);
+  TEST_ASSERT_TRUE(parseLoadcellLine("$0.0005", value));
+  TEST_ASSERT_FLOAT_WITHIN(0.0005f, 0.0f, value);  // 3 haneden sonrasi kesilir
+}
+
+static void test_loadcell_line_invalid_keeps_value() {
+  float value = 42.0f;
+  TEST_ASSERT_FALSE(parseLoadcellLine(nullptr, value));
+  TEST_ASSERT_FALSE(parseLoadcellLine("$", value));
+  TEST_ASSERT_FALSE(parseLoadcellLine("$12.3g", value));
+  TEST_ASSERT_FALSE(parseLoadcellLine("$1234567.0", value));  // 7 + 3 ondalik hane
+  TEST_ASSERT_EQUAL_FLOAT(42.0f, value);
+}
+
+int main(int argc, char** argv) {
+  UNITY_BEGIN();
+  RUN_TEST(test_fields_parse_signed_integers);
+  RUN_TEST(test_fields_reject_minus_in_unsigned_field);
+  RUN_TEST(test_fields_scale_and_decimals);
+  RUN_TEST(test_fields_reject_empty_and_stray);
+  RUN_TEST(test_fields_reject_over_long_numbers);
+  RUN_TEST(test_fields_ignore_extra_fields);
+  RUN_TEST(test_fields_short_line_keeps_old_values);
+  RUN_TEST(test_status_line_full);
+  RUN_TEST(test_status_line_short_resets_missing_fields);
+  RUN_TEST(test_status_line_invalid_or_timeout);
+  RUN_TEST(test_loadcell_line);
+  RUN_TEST(test_loadcell_line_invalid_keeps_value);
+  return UNITY_END();
+}
@@ -0,0 +1,178 @@
+// Kanal ornekleyici birim testleri (pio test -e native)
+// sample_accumulator.h: ardisik modda erken PASS (ve PASS verilmeyen durum), DEGER / ADIM / FARK
+// FAIL'leri, sabit modda olcum sayisinda karar, sampleAccumulatorTimeout(). Olcumler gercek yol
+// gibi sampleAccumulatorsFeed() ile plate (NTC) kanalindan gelir.
+
+#include <unity.h>
+
+#include "sample_accumulator.h"
+
+// NTC'ye benzer limitler: 0-100 C, ardil fark 2, min-max farki 2, 20 olcum
+static const SampleLimits testLimits = { 0.0f, 100.0f, 2.0f, 2.0f, 20 };
+
+static int doneCalls;
+static void onTestDone(SampleAccumulator &acc) { doneCalls++; }
+
+static SampleAccumulator acc =
+  SAMPLE_ACCUMULATOR("TEST", TELEMETRY_PLATE_TEMP, testLimits, onTestDone);
+
+static unsigned long frameMs;
+
+void setUp() {
+  sampleAccumulatorAttach(acc);  // ayni kayit ikinci kez eklenmez
+  acc.limits = testLimits;
+  doneCalls = 0;
+  frameMs = 1000;
+}
+
+void tearDown() {
+  sampleAccumulatorStop(acc);
+}
+
+// Bir $A karesi (100 ms aralikla) besle
+static void feed(float plateTemp) {
+  TelemetrySnapshot t = {};
+  t.fieldCount = 16;
+  t.timestampMs = frameMs;
+  t.plateTemp = plateTemp;
+  sampleAccumulatorsFeed(t);
+  frameMs += 100;
+}
+
+static void start(bool sequential) {
+  sampleAccumulatorStart(acc, sequential, frameMs);
+}
+
+static void test_sequential_stable_series_passes_early() {
+  static const float series[] = { 25.0f, 25.1f, 25.0f, 25.1f, 25.0f, 25.1f };
+  start(true);
+  int fed = 0;
+  while (sampleAccumulatorRunning(acc) && fed < 6) feed(series[fed++]);
+  TEST_ASSERT_EQUAL_INT(SAMPLE_PASS, acc.verdict);
+  TEST_ASSERT_EQUAL_INT(SAMPLE_FAIL_NONE, acc.failReason);
+  // En erken SAMPLE_SEQ_MIN_SAMPLES'ta, count'tan (20) cok once
+  TEST_ASSERT_EQUAL_INT(SAMPLE_SEQ_MIN_SAMPLES, fed);
+  TEST_ASSERT_EQUAL_INT(SAMPLE_SEQ_MIN_SAMPLES, acc.stats.count);
+  TEST_ASSERT_EQUAL_INT(1, doneCalls);
+}
+
+static void test_fixed_mode_waits_for_count() {
+  start(false);
+  for (int n = 0; n < testLimits.count - 1; n++) feed((n & 1) ? 25.1f : 25.0f);
+  TEST_ASSERT_TRUE(sampleAccumulatorRunning(acc));
+  feed(25.0f);
+  TEST_ASSERT_EQUAL_INT(SAMPLE_PASS, acc.verdict);
+  TEST_ASSERT_EQUAL_INT(testLimits.count, acc.stats.count);
+}
+
+static void test_sequential_no_early_pass_above_range_margin() {
+  // Tek sicrama (1.2): fark limit (2) icinde ama limit * SAMPLE_SEQ_RANGE_MARGIN (1) ustunde.
+  // Sigma kucuk oldugundan (~12. olcumden sonra) erken PASS'i yalnizca bu marj engeller.
+  start(true);
+  for (int n = 0; n < testLimits.count - 1; n++) feed(n == 1 ? 26.2f : 25.0f);
+  TEST_ASSERT_TRUE(sampleAccumulatorRunning(acc));
+  TEST_ASSERT_EQUAL_INT(0, doneCalls);
+  // Karar sabit moddaki gibi count'ta verilir (fark limit icinde: PASS)
+  feed(25.0f);
+  TEST_ASSERT_EQUAL_INT(SAMPLE_PASS, acc.verdict);
+  TEST_ASSERT_EQUAL_INT(testLimits.count, acc.stats.count);
+}
+
+static void test_sequential_no_early_pass_when_noisy() {
+  // Fark marjin icinde (0.9 <= 1) ama sigma ust tahminiyle 20 olcumde beklenen fark limiti asar
+  static const float series[] = { 25.0f, 25.9f, 25.0f, 25.9f, 25.0f };
+  start(true);
+  for (int n = 0; n < 5; n++) feed(series[n]);
+  TEST_ASSERT_TRUE(sampleAccumulatorRunning(acc));
+}
+
+static void test_value_out_of_range_fails() {
+  start(false);
+  feed(25.0f);
+  feed(100.5f);
+  TEST_ASSERT_EQUAL_INT(SAMPLE_FAIL, acc.verdict);
+  TEST_ASSERT_EQUAL_INT(SAMPLE_FAIL_VALUE, acc.failReason);
+  TEST_ASSERT_EQUAL_INT(1, acc.stats.count);  // aralik disi ornek istatistige girmez
+  TEST_ASSERT_EQUAL_INT(1, doneCalls);
+  TEST_ASSERT_EQUAL_STRING("DEGER", sampleFailReasonLabel(acc.failReason));
+}
+
+static void test_step_over_limit_fails() {
+  start(false);
+  feed(25.0f);
+  feed(26.9f);  // fark 1.9: gecer
+  feed(24.8f);  // fark 2.1: ADIM
+  TEST_ASSERT_EQUAL_INT(SAMPLE_FAIL, acc.verdict);
+  TEST_ASSERT_EQUAL_INT(SAMPLE_FAIL_STEP, acc.failReason);
+  TEST_ASSERT_EQUAL_INT(2, acc.stats.count);
+}
+
+static void test_sequential_range_fails_immediately() {
+  start(true);
+  feed(25.0f);
+  feed(26.5f);
+  TEST_ASSERT_TRUE(sampleAccumulatorRunning(acc));
+  feed(27.2f);  // min-max 2.2 > 2: sonraki olcumler farki kucultemez
+  TEST_ASSERT_EQUAL_INT(SAMPLE_FAIL, acc.verdict);
+  TEST_ASSERT_EQUAL_INT(SAMPLE_FAIL_RANGE, acc.failReason);
+  TEST_ASSERT_EQUAL_INT(3, acc.stats.count);
+}
+
+static void test_fixed_range_fails_at_count() {
+  acc.limits.count = 4;
+  start(false);
+  feed(25.0f);
+  feed(26.5f);
+  feed(27.2f);
+  TEST_ASSERT_TRUE(sampleAccumulatorRunning(acc));  // sabit mod count'u bekler
+  feed(27.0f);
+  TEST_ASSERT_EQUAL_INT(SAMPLE_FAIL, acc.verdict);
+  TEST_ASSERT_EQUAL_INT(SAMPLE_FAIL_RANGE, acc.failReason);
+}
+
+static void test_timeout_without_samples_fails() {
+  start(true);
+  sampleAccumulatorTimeout(acc, frameMs + 3000);
+  TEST_ASSERT_EQUAL_INT(SAMPLE_FAIL, acc.verdict);
+  TEST_ASSERT_EQUAL_INT(SAMPLE_FAIL_TIMEOUT, acc.failReason);
+  TEST_ASSERT_EQUAL_INT(frameMs + 3000, acc.endMs);
+  TEST_ASSERT_EQUAL_INT(1, doneCalls);
+  // Bitmis ornekleyicide ikinci timeout bir sey yapmaz
+  sampleAccumulatorTimeout(acc, frameMs + 4000);
+  TEST_ASSERT_EQUAL_INT(1, doneCalls);
+}
+
+static void test_timeout_with_samples_decides_on_mean() {
+  start(false);
+  feed(25.0f);
+  feed(25.4f);
+  feed(25.2f);
+  sampleAccumulatorTimeout(acc, frameMs);
+  TEST_ASSERT_EQUAL_INT(SAMPLE_PASS, acc.verdict);
+  TEST_ASSERT_EQUAL_INT(3, acc.stats.count);
+  TEST_ASSERT_FLOAT_WITHIN(0.001f, 25.2f, acc.stats.mean);
+  TEST_ASSERT_EQUAL_INT(1, doneCalls);
+}
+
+static void test_frames_before_start_are_ignored() {
+  start(false);
+  frameMs -= 500;  // baslatmadan once alinmis kare
+  feed(25.0f);
+  TEST_ASSERT_EQUAL_INT(0, acc.stats.count);
+}
+
+int main(int argc, char** argv) {
+  UNITY_BEGIN();
+  RUN_TEST(test_sequential_stable_series_passes_early);
+  RUN_TEST(test_fixed_mode_waits_for_count);
+  RUN_TEST(test_sequential_no_early_pass_above_range_margin);
+  RUN_TEST(test_sequential_no_early_pass_when_noisy);
+  RUN_TEST(test_value_out_of_range_fails);
+  RUN_TEST(test_step_over_limit_fails);
+  RUN_TEST(test_sequential_range_fails_immediately);
+  RUN_TEST(test_fixed_range_fails_at_count);
+  RUN_TEST(test_timeout_without_samples_fails);
+  RUN_TEST(test_timeout_with_samples_decides_on_mean);
+  RUN_TEST(test_frames_before_start_are_ignored);
+  return UNITY_END();
+}
@@ -0,0 +1,99 @@
+// Kayan pencere oturma tespiti birim testleri (pio test -e native)
+// steady_state.h: bilinen rampada egim, size'i asan eklemede halka tamponun sarmasi (en eski
+// olcum duser), oturmus / hala yukselen giris. Fan testinin olcum fazi bu kararla biter.
+
+#include <unity.h>
+
+#include "steady_state.h"
+
+void setUp() {}
+void tearDown() {}
+
+static void test_slope_on_known_ramp() {
+  SteadyWindow w;
+  steadyWindowReset(w, 6);
+  TEST_ASSERT_EQUAL_FLOAT(0.0f, steadyWindowSlope(w));  // bos pencere
+  // 100 ms aralikla +25 RPM: 250 RPM/s
+  for (int i = 0; i < 6; i++) steadyWindowAdd(w, 5000 + i * 100, 2000.0f + i * 25.0f);
+  TEST_ASSERT_FLOAT_WITHIN(0.01f, 250.0f, steadyWindowSlope(w));
+  TEST_ASSERT_FLOAT_WITHIN(0.01f, 2062.5f, steadyWindowMean(w));
+  TEST_ASSERT_EQUAL_FLOAT(2000.0f, steadyWindowMin(w));
+
+  // Dusen rampa, duzensiz aralik (egim zamana gore, ornek sirasina gore degil)
+  steadyWindowReset(w, 4);
+  steadyWindowAdd(w, 0, 10.0f);
+  steadyWindowAdd(w, 500, 9.0f);
+  steadyWindowAdd(w, 2000, 6.0f);
+  steadyWindowAdd(w, 2500, 5.0f);
+  TEST_ASSERT_FLOAT_WITHIN(0.001f, -2.0f, steadyWindowSlope(w));
+}
+
+static void test_slope_ignores_millis_wrap() {
+  SteadyWindow w;
+  steadyWindowReset(w, 4);
+  unsigned long t = (unsigned long)-150;  // millis() tasmasindan hemen once
+  for (int i = 0; i < 4; i++) steadyWindowAdd(w, t + i * 100, 100.0f + i * 10.0f);
+  TEST_ASSERT_FLOAT_WITHIN(0.01f, 100.0f, steadyWindowSlope(w));
+}
+
+static void test_window_wraps_past_size() {
+  SteadyWindow w;
+  steadyWindowReset(w, 4);
+  for (int i = 0; i < 3; i++) steadyWindowAdd(w, i * 100, 1000.0f);
+  TEST_ASSERT_FALSE(steadyWindowFull(w));
+  // 10 olcum: yalnizca son 4'u (7, 8, 9, 10 x 100) kalir
+  for (int i = 3; i < 10; i++) steadyWindowAdd(w, i * 100, (float)(i + 1) * 100.0f);
+  TEST_ASSERT_TRUE(steadyWindowFull(w));
+  TEST_ASSERT_EQUAL_INT(4, w.count);
+  TEST_ASSERT_EQUAL_FLOAT(700.0f, steadyWindowMin(w));
+  TEST_ASSERT_FLOAT_WITHIN(0.01f, 850.0f, steadyWindowMean(w));
+  // 100 ms'de +100: 1000 / s (dusen eski 1000'ler egime girmez)
+  TEST_ASSERT_FLOAT_WITHIN(0.01f, 1000.0f, steadyWindowSlope(w));
+}
+
+static void test_reset_clamps_size() {
+  SteadyWindow w;
+  steadyWindowReset(w, 1);
+  TEST_ASSERT_EQUAL_INT(2, w.size);
+  steadyWindowReset(w, STEADY_WINDOW_MAX + 5);
+  TEST_ASSERT_EQUAL_INT(STEADY_WINDOW_MAX, w.size);
+}
+
+static void test_settled_vs_still_rising() {
+  SteadyWindow w;
+  steadyWindowReset(w, 6);
+  // Fan %100'de oturmus: 4000 etrafinda kucuk gurultu
+  static const float settled[] = { 4010.0f, 3990.0f, 4005.0f, 3995.0f, 4008.0f, 3992.0f };
+  for (int i = 0; i < 5; i++) steadyWindowAdd(w, i * 100, settled[i]);
+  TEST_ASSERT_FALSE(steadyWindowSettled(w, 50.0f, 60.0f));  // pencere dolmadi
+  steadyWindowAdd(w, 500, settled[5]);
+  TEST_ASSERT_TRUE(steadyWindowSettled(w, 50.0f, 60.0f));
+
+  // Hala yukseliyor: 100 ms'de +20 RPM (200 RPM/s), sapma kucuk ama egim esigin ustunde
+  steadyWindowReset(w, 6);
+  for (int i = 0; i < 6; i++) steadyWindowAdd(w, i * 100, 3500.0f + i * 20.0f);
+  TEST_ASSERT_FLOAT_WITHIN(0.01f, 200.0f, steadyWindowSlope(w));
+  TEST_ASSERT_TRUE(steadyWindowStdDev(w) < 60.0f);
+  TEST_ASSERT_FALSE(steadyWindowSettled(w, 50.0f, 60.0f));
+
+  // Yukselen olcumler pencereden cikip RPM sabitlenince oturur
+  for (int i = 6; i < 12; i++) steadyWindowAdd(w, i * 100, 3600.0f);
+  TEST_ASSERT_TRUE(steadyWindowSettled(w, 50.0f, 60.0f));
+
+  // Egim yok ama gurultulu: sapma esigin ustunde
+  steadyWindowReset(w, 6);
+  static const float noisy[] = { 3900.0f, 4100.0f, 4100.0f, 4100.0f, 4100.0f, 3900.0f };
+  for (int i = 0; i < 6; i++) steadyWindowAdd(w, i * 100, noisy[i]);
+  TEST_ASSERT_FLOAT_WITHIN(0.01f, 0.0f, steadyWindowSlope(w));
+  TEST_ASSERT_FALSE(steadyWindowSettled(w, 50.0f, 60.0f));
+}
+
+int main(int argc, char** argv) {
+  UNITY_BEGIN();
+  RUN_TEST(test_slope_on_known_ramp);
+  RUN_TEST(test_slope_ignores_millis_wrap);
+  RUN_TEST(test_window_wraps_past_size);
+  RUN_TEST(test_reset_clamps_size);
+  RUN_TEST(test_settled_vs_still_rising);
+  return UNITY_END();
+}
@@ -0,0 +1,116 @@
+// Adim tablosu yorumlayicisi birim testleri (pio test -e native)
+// test_sequence.h: SAMPLE (N ornek, aralik, min/max/ortalama) ve ASSERT (esik, FAIL etiketi);
+// fan testlerinin kanal limitleri bu iki adimla yazilir (main.cpp fanTestTables).
+
+#include <float.h>
+#include <unity.h>
+
+#include "test_sequence.h"
+
+void setUp() {}
+void tearDown() {}
+
+static float probeValues[8];
+static int   probeCalls;
+
+static float sequenceProbe(int offset) {
+  return probeValues[probeCalls++] + offset;
+}
+
+static void resetProbe(const float* values, int count) {
+  for (int n = 0; n < count; n++) probeValues[n] = values[n];
+  probeCalls = 0;
+}
+
+static void test_sample_takes_count_samples_at_interval() {
+  static const float values[] = { 10.0f, 14.0f, 12.0f };
+  static constexpr TestStep steps[] = {
+    testSample(sequenceProbe, 0, 3, 100),
+  };
+  resetProbe(values, 3);
+  TestRunner r;
+  testRunnerStart(r, steps);
+
+  TEST_ASSERT_FALSE(testRunnerTick(r, 1000));  // ilk ornek hemen
+  TEST_ASSERT_EQUAL_INT(1, probeCalls);
+  TEST_ASSERT_FALSE(testRunnerTick(r, 1050));  // aralik dolmadi
+  TEST_ASSERT_EQUAL_INT(1, probeCalls);
+  TEST_ASSERT_FALSE(testRunnerTick(r, 1100));
+  TEST_ASSERT_TRUE(testRunnerTick(r, 1200));   // ucuncu ornek: tablo bitti
+  TEST_ASSERT_EQUAL_INT(3, probeCalls);
+  TEST_ASSERT_EQUAL_INT(TEST_RUN_PASS, r.state);
+  TEST_ASSERT_EQUAL_FLOAT(10.0f, r.sampleMin);
+  TEST_ASSERT_EQUAL_FLOAT(14.0f, r.sampleMax);
+  TEST_ASSERT_EQUAL_FLOAT(12.0f, testRunnerSampleMean(r));
+}
+
+static void test_assert_checks_last_sampling() {
+  static const float values[] = { 2600.0f, 2400.0f };
+  static constexpr TestStep steps[] = {
+    testSample(sequenceProbe, 0, 1, 0), testAssert(2500.0f, FLT_MAX, "F1"),
+    testSample(sequenceProbe, 0, 1, 0), testAssert(2500.0f, FLT_MAX, "F2"),
+  };
+  resetProbe(values, 2);
+  TestRunner r;
+  testRunnerStart(r, steps);
+
+  // Anlik adimlar tek tick'te islenir; ilk kontrol gecer, ikincisi FAIL
+  TEST_ASSERT_TRUE(testRunnerTick(r, 0));
+  TEST_ASSERT_EQUAL_INT(TEST_RUN_FAIL, r.state);
+  TEST_ASSERT_EQUAL_STRING("F2", r.failLabel);
+  TEST_ASSERT_EQUAL_INT(2, probeCalls);
+  TEST_ASSERT_EQUAL_FLOAT(2400.0f, testRunnerSampleMean(r));
+}
+
+static void test_assert_range_is_inclusive() {
+  static const float values[] = { 0.0f, 0.0f, 1.0f };
+  static constexpr TestStep steps[] = {
+    testSample(sequenceProbe, 0, 1, 0), testAssert(0.0f, 0.0f, "ERR"),
+    testSample(sequenceProbe, 0, 2, 0), testAssert(0.0f, 0.0f, "ERR2"),
+  };
+  resetProbe(values, 3);
+  TestRunner r;
+  testRunnerStart(r, steps);
+
+  // Ilk kontrol gecer; ikinci ornekleme tick basina bir ornek alir (aralik 0 olsa da)
+  TEST_ASSERT_FALSE(testRunnerTick(r, 0));
+  TEST_ASSERT_EQUAL_INT(2, probeCalls);
+  // Ikinci ornek: max (1) ust sinirin (0) ustunde
+  TEST_ASSERT_TRUE(testRunnerTick(r, 10));
+  TEST_ASSERT_EQUAL_INT(3, probeCalls);
+  TEST_ASSERT_EQUAL_INT(TEST_RUN_FAIL, r.state);
+  TEST_ASSERT_EQUAL_STRING("ERR2", r.failLabel);
+}
+
+static void test_assert_without_samples_fails() {
+  static constexpr TestStep steps[] = {
+    testAssert(-FLT_MAX, FLT_MAX, "BOS"),
+  };
+  TestRunner r;
+  testRunnerStart(r, steps);
+  TEST_ASSERT_TRUE(testRunnerTick(r, 0));
+  TEST_ASSERT_EQUAL_INT(TEST_RUN_FAIL, r.state);
+  TEST_ASSERT_EQUAL_STRING("BOS", r.failLabel);
+}
+
+static void test_sample_probe_arg_is_passed() {
+  static const float values[] = { 1.0f };
+  static constexpr TestStep steps[] = {
+    testSample(sequenceProbe, 5, 1, 0), testAssert(6.0f, 6.0f, "ARG"),
+  };
+  resetProbe(values, 1);
+  TestRunner r;
+  testRunnerStart(r, steps);
+  TEST_ASSERT_TRUE(testRunnerTick(r, 0));
+  TEST_ASSERT_EQUAL_INT(TEST_RUN_PASS, r.state);
+}
+
+int main(int argc, char** argv) {
+  UNITY_BEGIN();
+  RUN_TEST(test_sample_takes_count_samples_at_interval);
+  RUN_TEST(test_assert_checks_last_sampling);
+  RUN_TEST(test_assert_range_is_inclusive);
+  RUN_TEST(test_assert_without_samples_fails);
+  RUN_TEST(test_sample_probe_arg_is_passed);
+  return UNITY_END();
+}